@@ -0,0 +1,126 @@
+#ifndef PLATAFORMA_NATIVA_ARDUINO_H
+#define PLATAFORMA_NATIVA_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+#include <string>
+#include "freertos/FreeRTOS.h"
+
+// Lo que src/ usa de Arduino-ESP32, para compilarlo en la PC. El tiempo es
+// el del reloj simulado (ver freertos/FreeRTOS.h y simulacion.h).
+#define ARDUINO_ARCH_ESP32 1
+
+#define IRAM_ATTR
+#define DRAM_ATTR
+#define PROGMEM
+
+#define HIGH 1
+#define LOW 0
+#define INPUT 0x01
+#define OUTPUT 0x03
+#define FALLING 0x02
+
+#define PI 3.1415926535897932384626433832795
+
+using std::max;
+using std::min;
+
+typedef uint8_t byte;
+
+unsigned long micros();
+unsigned long millis();
+void delay(uint32_t ms);
+long map(long x, long desdeMin, long desdeMax, long hastaMin, long hastaMax);
+void pinMode(uint8_t pin, uint8_t modo);
+uint32_t esp_random();
+
+// String de Arduino sobre std::string, con lo que usa src/
+class String {
+public:
+    String() {}
+    String(const char *texto) : s(texto ? texto : "") {}
+    String(const std::string &texto) : s(texto) {}
+    String(char c) : s(1, c) {}
+    String(int valor) : s(std::to_string(valor)) {}
+    String(unsigned int valor) : s(std::to_string(valor)) {}
+    String(long valor) : s(std::to_string(valor)) {}
+    String(unsigned long valor) : s(std::to_string(valor)) {}
+    String(float valor, unsigned int decimales = 2) : s(conDecimales(valor, decimales)) {}
+    String(double valor, unsigned int decimales = 2) : s(conDecimales(valor, decimales)) {}
+
+    unsigned int length() const { return s.size(); }
+    const char *c_str() const { return s.c_str(); }
+    bool isEmpty() const { return s.empty(); }
+    char operator[](unsigned int i) const { return i < s.size() ? s[i] : 0; }
+    long toInt() const { return atol(s.c_str()); }
+    float toFloat() const { return (float)atof(s.c_str()); }
+    bool reserve(unsigned int n) { s.reserve(n); return true; }
+
+    String &operator+=(const String &otro) { s += otro.s; return *this; }
+    String &operator+=(const char *otro) { s += otro; return *this; }
+    String &operator+=(char c) { s += c; return *this; }
+    bool operator==(const String &otro) const { return s == otro.s; }
+    bool operator==(const char *otro) const { return s == otro; }
+    bool operator!=(const String &otro) const { return s != otro.s; }
+    bool operator!=(const char *otro) const { return s != otro; }
+
+    friend String operator+(const String &a, const String &b) { return String(a.s + b.s); }
+
+private:
+    static std::string conDecimales(double valor, unsigned int decimales) {
+        char texto[32];
+        snprintf(texto, sizeof(texto), "%.*f", (int)decimales, valor);
+        return texto;
+    }
+
+    std::string s;
+};
+
+// Salida de texto (Serial va a stdout)
+class Print {
+public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t *datos, size_t longitud) {
+        size_t n = 0;
+        while (longitud--) n += write(*datos++);
+        return n;
+    }
+    size_t write(const char *texto) { return write((const uint8_t *)texto, strlen(texto)); }
+    size_t print(const char *texto) { return write(texto); }
+    size_t print(const String &texto) { return write(texto.c_str()); }
+    size_t print(long valor) { return print(String(valor)); }
+    size_t print(double valor, int decimales = 2) { return print(String(valor, decimales)); }
+    size_t println() { return write("\n"); }
+    template <typename T> size_t println(const T &valor) { return print(valor) + println(); }
+    size_t printf(const char *formato, ...) __attribute__((format(printf, 2, 3)));
+};
+
+class HardwareSerial : public Print {
+public:
+    void begin(unsigned long baudios) { (void)baudios; }
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t *datos, size_t longitud) override;
+    using Print::write;
+};
+
+extern HardwareSerial Serial;
+
+// Memoria: el heap del proceso visto como el de un ESP32 de 320 KB
+class EspClass {
+public:
+    uint32_t getHeapSize();
+    uint32_t getFreeHeap();
+    uint32_t getMinFreeHeap();
+    uint32_t getMaxAllocHeap();
+    void restart();
+};
+
+extern EspClass ESP;
+
+#endif // PLATAFORMA_NATIVA_ARDUINO_H
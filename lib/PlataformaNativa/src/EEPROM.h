@@ -0,0 +1,37 @@
+#ifndef PLATAFORMA_NATIVA_EEPROM_H
+#define PLATAFORMA_NATIVA_EEPROM_H
+
+#include "Arduino.h"
+#include <vector>
+
+// EEPROM en memoria: arranca en cero, como la de Arduino-ESP32 sin datos
+// guardados, y commit() no persiste nada
+class EEPROMClass {
+public:
+    bool begin(size_t tamano) { datos.assign(tamano, 0); return true; }
+    uint8_t read(int direccion) { return dentro(direccion, 1) ? datos[direccion] : 0; }
+    void write(int direccion, uint8_t valor) { if (dentro(direccion, 1)) datos[direccion] = valor; }
+    bool commit() { return true; }
+    size_t length() const { return datos.size(); }
+
+    template <typename T> T &get(int direccion, T &valor) {
+        if (dentro(direccion, sizeof(T))) memcpy(&valor, &datos[direccion], sizeof(T));
+        return valor;
+    }
+
+    template <typename T> const T &put(int direccion, const T &valor) {
+        if (dentro(direccion, sizeof(T))) memcpy(&datos[direccion], &valor, sizeof(T));
+        return valor;
+    }
+
+private:
+    bool dentro(int direccion, size_t longitud) const {
+        return direccion >= 0 && (size_t)direccion + longitud <= datos.size();
+    }
+
+    std::vector<uint8_t> datos;
+};
+
+extern EEPROMClass EEPROM;
+
+#endif // PLATAFORMA_NATIVA_EEPROM_H
@@ -0,0 +1,84 @@
+#ifndef PLATAFORMA_NATIVA_WEBSERVER_H
+#define PLATAFORMA_NATIVA_WEBSERVER_H
+
+#include "Arduino.h"
+#include "WiFi.h"
+#include <deque>
+#include <functional>
+#include <map>
+#include <utility>
+#include <vector>
+
+// WebServer de Arduino sin sockets. Los pedidos se encolan con pedir() y
+// handleClient() los atiende (en la tarea que lo llame, como en el robot);
+// la respuesta completa, con las partes de sendContent() unidas, llega a la
+// función que se pasó al encolar. atender() hace lo mismo en el momento,
+// para medir un handler sin pasar por el planificador. El reloj virtual no
+// avanza dentro de un handler: su costo real se mide con el reloj del host.
+
+#define CONTENT_LENGTH_UNKNOWN ((size_t)-1)
+
+enum HTTPMethod { HTTP_ANY, HTTP_GET, HTTP_POST };
+
+struct RespuestaHttp {
+    int codigo = 0;
+    std::string tipo;
+    std::vector<std::pair<std::string, std::string>> cabeceras;
+    std::string cuerpo;
+    size_t partes = 0;  // Llamadas a sendContent() con datos
+    uint32_t hostUs = 0; // Lo que tardó el handler en el host
+};
+
+class WebServer {
+public:
+    typedef std::function<void(void)> THandlerFunction;
+    typedef std::function<void(const RespuestaHttp &)> AlResponder;
+
+    explicit WebServer(int puerto) { (void)puerto; }
+
+    void begin() {}
+    void on(const String &uri, HTTPMethod metodo, THandlerFunction handler);
+    void on(const String &uri, THandlerFunction handler) { on(uri, HTTP_ANY, handler); }
+    void collectHeaders(const char *nombres[], size_t cantidad) { (void)nombres; (void)cantidad; }
+    void handleClient();
+
+    // "uri" con consulta opcional: "/get-data?since=10"
+    void pedir(const String &uri, HTTPMethod metodo = HTTP_GET, AlResponder alResponder = nullptr);
+    RespuestaHttp atender(const String &uri, HTTPMethod metodo = HTTP_GET);
+    void agregarCabeceraPedido(const String &nombre, const String &valor);
+
+    // Lo que usan los handlers
+    bool hasArg(const String &nombre) const;
+    String arg(const String &nombre) const;
+    String header(const String &nombre) const;
+    void sendHeader(const String &nombre, const String &valor, bool primero = false);
+    void setContentLength(size_t longitud) { (void)longitud; }
+    void send(int codigo, const char *tipo = NULL, const char *contenido = "");
+    void send(int codigo, const char *tipo, const String &contenido) { send(codigo, tipo, contenido.c_str()); }
+    void send_P(int codigo, const char *tipo, const char *contenido, size_t longitud);
+    void sendContent(const char *datos, size_t longitud);
+    void sendContent(const String &texto) { sendContent(texto.c_str(), texto.length()); }
+    void sendContent(const char *texto) { sendContent(texto, strlen(texto)); }
+
+private:
+    struct Ruta {
+        std::string uri;
+        HTTPMethod metodo;
+        THandlerFunction handler;
+    };
+    struct Pedido {
+        std::string uri;
+        HTTPMethod metodo;
+        AlResponder alResponder;
+    };
+
+    RespuestaHttp procesar(const std::string &uri, HTTPMethod metodo);
+
+    std::vector<Ruta> rutas;
+    std::deque<Pedido> pendientes;
+    std::map<std::string, std::string> argumentos;
+    std::map<std::string, std::string> cabecerasPedido;
+    RespuestaHttp respuesta;
+};
+
+#endif // PLATAFORMA_NATIVA_WEBSERVER_H
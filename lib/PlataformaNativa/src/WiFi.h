@@ -0,0 +1,109 @@
+#ifndef PLATAFORMA_NATIVA_WIFI_H
+#define PLATAFORMA_NATIVA_WIFI_H
+
+#include "Arduino.h"
+#include <deque>
+#include <memory>
+#include <stdint.h>
+#include <string>
+
+// Red simulada: el modo AP siempre arranca y una red guardada siempre
+// conecta. Los pedidos HTTP se inyectan en WebServer; las conexiones TCP
+// crudas (el canal de eventos), con WiFiServer::conectar().
+
+#define WL_CONNECTED 3
+#define WL_DISCONNECTED 6
+#define WIFI_STA 1
+#define WIFI_AP 2
+
+class IPAddress {
+public:
+    String toString() const { return String("127.0.0.1"); }
+};
+
+// Los dos extremos de una conexión: el programa (WiFiClient) y quien la
+// simula, que escribe en "entrada" y lee lo que el programa dejó en "salida"
+struct ConexionSimulada {
+    std::string entrada;
+    std::string salida;
+    bool abierta = true;
+    size_t capacidad = SIZE_MAX; // Bytes que acepta cada write() (socket lleno)
+};
+
+class WiFiClient : public Print {
+public:
+    WiFiClient() {}
+    explicit WiFiClient(std::shared_ptr<ConexionSimulada> conexion) : conexion(conexion) {}
+
+    size_t write(uint8_t c) override { return write(&c, 1); }
+    size_t write(const uint8_t *datos, size_t longitud) override {
+        if (!connected()) return 0;
+        size_t n = longitud < conexion->capacidad ? longitud : conexion->capacidad;
+        conexion->salida.append((const char *)datos, n);
+        return n;
+    }
+    using Print::write;
+    bool connected() { return conexion && conexion->abierta; }
+    int available() { return conexion ? (int)conexion->entrada.size() : 0; }
+    int read() {
+        if (available() == 0) return -1;
+        uint8_t c = conexion->entrada[0];
+        conexion->entrada.erase(0, 1);
+        return c;
+    }
+    String readStringUntil(char fin) {
+        String linea;
+        for (int c = read(); c >= 0 && c != fin; c = read()) linea += (char)c;
+        return linea;
+    }
+    void setNoDelay(bool activo) { (void)activo; }
+    void stop() {
+        if (conexion) conexion->abierta = false;
+        conexion.reset();
+    }
+    explicit operator bool() const { return conexion != nullptr; }
+
+private:
+    std::shared_ptr<ConexionSimulada> conexion;
+};
+
+class WiFiServer {
+public:
+    explicit WiFiServer(uint16_t puerto) { (void)puerto; }
+    void begin() {}
+    void setNoDelay(bool activo) { (void)activo; }
+    bool hasClient() { return !pendientes.empty(); }
+    WiFiClient accept() {
+        if (pendientes.empty()) return WiFiClient();
+        WiFiClient cliente(pendientes.front());
+        pendientes.pop_front();
+        return cliente;
+    }
+
+    // Un cliente nuevo que el programa verá en el próximo accept()
+    std::shared_ptr<ConexionSimulada> conectar() {
+        pendientes.push_back(std::make_shared<ConexionSimulada>());
+        return pendientes.back();
+    }
+
+private:
+    std::deque<std::shared_ptr<ConexionSimulada>> pendientes;
+};
+
+class WiFiClass {
+public:
+    void mode(int modo) { (void)modo; }
+    void softAP(const char *ssid, const char *clave) { (void)ssid; (void)clave; }
+    void begin(const char *ssid, const char *clave) { (void)clave; conectado = ssid != NULL && ssid[0] != 0; }
+    void disconnect() { conectado = false; }
+    int status() { return conectado ? WL_CONNECTED : WL_DISCONNECTED; }
+    IPAddress localIP() { return IPAddress(); }
+    int8_t RSSI() { return conectado ? -55 : 0; }
+
+private:
+    bool conectado = false;
+};
+
+extern WiFiClass WiFi;
+
+#endif // PLATAFORMA_NATIVA_WIFI_H
@@ -0,0 +1,253 @@
+#include "Arduino.h"
+#include "EEPROM.h"
+#include "WebServer.h"
+#include "WiFi.h"
+#include "simulacion.h"
+#include <chrono>
+#include <malloc.h>
+#include <stdarg.h>
+#include <utility>
+
+HardwareSerial Serial;
+EspClass ESP;
+WiFiClass WiFi;
+EEPROMClass EEPROM;
+
+// --- Núcleo de Arduino ---
+
+// unsigned long del ESP32 es de 32 bits: se recorta para que micros() y
+// millis() den la vuelta en el mismo momento que en el robot
+unsigned long micros() {
+    return (uint32_t)simTiempoUs();
+}
+
+unsigned long millis() {
+    return (uint32_t)(simTiempoUs() / 1000);
+}
+
+void delay(uint32_t ms) {
+    vTaskDelay(pdMS_TO_TICKS(ms));
+}
+
+long map(long x, long desdeMin, long desdeMax, long hastaMin, long hastaMax) {
+    return (x - desdeMin) * (hastaMax - hastaMin) / (desdeMax - desdeMin) + hastaMin;
+}
+
+void pinMode(uint8_t pin, uint8_t modo) {
+    (void)pin;
+    (void)modo;
+}
+
+// xorshift32 con semilla fija: cada corrida ve la misma secuencia
+uint32_t esp_random() {
+    static uint32_t estado = 0x9E3779B9u;
+    estado ^= estado << 13;
+    estado ^= estado >> 17;
+    estado ^= estado << 5;
+    return estado;
+}
+
+size_t Print::printf(const char *formato, ...) {
+    char corto[128];
+    va_list args;
+    va_start(args, formato);
+    int n = vsnprintf(corto, sizeof(corto), formato, args);
+    va_end(args);
+    if (n < 0) return 0;
+    if ((size_t)n < sizeof(corto)) return write((const uint8_t *)corto, n);
+    std::string largo(n + 1, '\0');
+    va_start(args, formato);
+    vsnprintf(&largo[0], largo.size(), formato, args);
+    va_end(args);
+    return write((const uint8_t *)largo.data(), n);
+}
+
+size_t HardwareSerial::write(uint8_t c) {
+    return fwrite(&c, 1, 1, stdout);
+}
+
+size_t HardwareSerial::write(const uint8_t *datos, size_t longitud) {
+    return fwrite(datos, 1, longitud, stdout);
+}
+
+// --- ESP ---
+
+#define HEAP_SIMULADO (320u * 1024u)
+
+namespace {
+
+uint32_t minimoLibre = HEAP_SIMULADO;
+
+// Lo que el proceso tiene pedido a malloc, descontado de un heap de ESP32.
+// glibc guarda bloques liberados en una caché por hilo (cada tarea es un
+// hilo) que cuenta como usada y se va llenando: en una corrida de horas el
+// heap libre baja unos KB sin que el programa pierda nada. Para medir la
+// deriva, correr con GLIBC_TUNABLES=glibc.malloc.tcache_count=0.
+uint32_t heapLibre() {
+    struct mallinfo2 info = mallinfo2();
+    uint32_t usado = info.uordblks > HEAP_SIMULADO ? HEAP_SIMULADO : (uint32_t)info.uordblks;
+    uint32_t libre = HEAP_SIMULADO - usado;
+    if (libre < minimoLibre) minimoLibre = libre;
+    return libre;
+}
+
+} // namespace
+
+uint32_t EspClass::getHeapSize() {
+    return HEAP_SIMULADO;
+}
+
+uint32_t EspClass::getFreeHeap() {
+    return heapLibre();
+}
+
+uint32_t EspClass::getMinFreeHeap() {
+    heapLibre();
+    return minimoLibre;
+}
+
+// Sin fragmentación que medir: el bloque más grande es todo lo libre
+uint32_t EspClass::getMaxAllocHeap() {
+    return heapLibre();
+}
+
+void EspClass::restart() {
+    printf("[nativo] ESP.restart() a los %.3f s simulados\n", simTiempoUs() / 1e6);
+    fflush(stdout);
+    _Exit(0);
+}
+
+// --- WebServer ---
+
+void WebServer::on(const String &uri, HTTPMethod metodo, THandlerFunction handler) {
+    rutas.push_back({uri.c_str(), metodo, handler});
+}
+
+void WebServer::pedir(const String &uri, HTTPMethod metodo, AlResponder alResponder) {
+    pendientes.push_back({uri.c_str(), metodo, alResponder});
+}
+
+void WebServer::handleClient() {
+    // Uno por llamada, como el servidor del core con un cliente a la vez
+    if (pendientes.empty()) return;
+    Pedido pedido = pendientes.front();
+    pendientes.pop_front();
+    RespuestaHttp r = procesar(pedido.uri, pedido.metodo);
+    if (pedido.alResponder) pedido.alResponder(r);
+}
+
+RespuestaHttp WebServer::atender(const String &uri, HTTPMethod metodo) {
+    return procesar(uri.c_str(), metodo);
+}
+
+void WebServer::agregarCabeceraPedido(const String &nombre, const String &valor) {
+    cabecerasPedido[nombre.c_str()] = valor.c_str();
+}
+
+bool WebServer::hasArg(const String &nombre) const {
+    return argumentos.count(nombre.c_str()) != 0;
+}
+
+String WebServer::arg(const String &nombre) const {
+    auto it = argumentos.find(nombre.c_str());
+    return it != argumentos.end() ? String(it->second) : String();
+}
+
+String WebServer::header(const String &nombre) const {
+    auto it = cabecerasPedido.find(nombre.c_str());
+    return it != cabecerasPedido.end() ? String(it->second) : String();
+}
+
+void WebServer::sendHeader(const String &nombre, const String &valor, bool primero) {
+    auto cabecera = std::make_pair(std::string(nombre.c_str()), std::string(valor.c_str()));
+    if (primero) {
+        respuesta.cabeceras.insert(respuesta.cabeceras.begin(), cabecera);
+    } else {
+        respuesta.cabeceras.push_back(cabecera);
+    }
+}
+
+void WebServer::send(int codigo, const char *tipo, const char *contenido) {
+    respuesta.codigo = codigo;
+    if (tipo != NULL) respuesta.tipo = tipo;
+    if (contenido != NULL) respuesta.cuerpo += contenido;
+}
+
+void WebServer::send_P(int codigo, const char *tipo, const char *contenido, size_t longitud) {
+    respuesta.codigo = codigo;
+    respuesta.tipo = tipo;
+    respuesta.cuerpo.append(contenido, longitud);
+}
+
+void WebServer::sendContent(const char *datos, size_t longitud) {
+    if (longitud == 0) return;
+    respuesta.cuerpo.append(datos, longitud);
+    respuesta.partes++;
+}
+
+namespace {
+
+int valorHex(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+std::string decodificar(const std::string &texto) {
+    std::string salida;
+    for (size_t i = 0; i < texto.size(); i++) {
+        if (texto[i] == '+') {
+            salida += ' ';
+        } else if (texto[i] == '%' && i + 2 < texto.size() && valorHex(texto[i + 1]) >= 0 &&
+                   valorHex(texto[i + 2]) >= 0) {
+            salida += (char)(valorHex(texto[i + 1]) * 16 + valorHex(texto[i + 2]));
+            i += 2;
+        } else {
+            salida += texto[i];
+        }
+    }
+    return salida;
+}
+
+} // namespace
+
+RespuestaHttp WebServer::procesar(const std::string &uri, HTTPMethod metodo) {
+    size_t pregunta = uri.find('?');
+    std::string ruta = uri.substr(0, pregunta);
+    argumentos.clear();
+    if (pregunta != std::string::npos) {
+        std::string consulta = uri.substr(pregunta + 1);
+        size_t inicio = 0;
+        while (inicio <= consulta.size()) {
+            size_t fin = consulta.find('&', inicio);
+            if (fin == std::string::npos) fin = consulta.size();
+            std::string par = consulta.substr(inicio, fin - inicio);
+            if (!par.empty()) {
+                size_t igual = par.find('=');
+                std::string nombre = decodificar(par.substr(0, igual));
+                argumentos[nombre] = igual == std::string::npos ? "" : decodificar(par.substr(igual + 1));
+            }
+            inicio = fin + 1;
+        }
+    }
+
+    respuesta = RespuestaHttp();
+    auto inicio = std::chrono::steady_clock::now();
+    bool atendido = false;
+    for (const Ruta &r : rutas) {
+        if (r.uri == ruta && (r.metodo == HTTP_ANY || r.metodo == metodo)) {
+            r.handler();
+            atendido = true;
+            break;
+        }
+    }
+    if (!atendido) send(404, "text/plain", "Not found");
+    respuesta.hostUs = (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - inicio).count();
+    cabecerasPedido.clear();
+    // Sin guardar el cuerpo hasta el próximo pedido: en el ESP32 los chunks
+    // van directo al socket, y el heap libre que informa el programa no
+    // tiene que depender del tamaño de la última respuesta
+    return std::exchange(respuesta, RespuestaHttp());
+}
@@ -0,0 +1,85 @@
+#ifndef PLATAFORMA_NATIVA_FREERTOS_H
+#define PLATAFORMA_NATIVA_FREERTOS_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// FreeRTOS simulado: las tareas son hilos, pero corre una sola a la vez y
+// solo cambia cuando la que corre se bloquea (cola, notificación, event
+// group o vTaskDelay). Mientras todas esperan, el reloj salta al próximo
+// vencimiento o temporizador; así el tiempo simulado no depende de la PC y
+// dos corridas con las mismas entradas dan lo mismo. Tick de 1 ms, como en
+// Arduino-ESP32. Las secciones críticas no hacen falta: nadie corre en paralelo.
+
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+typedef uint32_t TickType_t;
+typedef uint32_t EventBits_t;
+typedef void (*TaskFunction_t)(void *);
+
+struct TareaSimulada;
+struct ColaSimulada;
+struct GrupoEventosSimulado;
+typedef TareaSimulada *TaskHandle_t;
+typedef ColaSimulada *QueueHandle_t;
+typedef GrupoEventosSimulado *EventGroupHandle_t;
+
+typedef struct { int reservado; } portMUX_TYPE;
+#define portMUX_INITIALIZER_UNLOCKED {0}
+#define portENTER_CRITICAL(candado) ((void)(candado))
+#define portEXIT_CRITICAL(candado) ((void)(candado))
+#define portENTER_CRITICAL_ISR(candado) ((void)(candado))
+#define portEXIT_CRITICAL_ISR(candado) ((void)(candado))
+#define portYIELD_FROM_ISR(...) ((void)0)
+
+#define configTICK_RATE_HZ 1000
+#define portTICK_PERIOD_MS 1
+#define portMAX_DELAY 0xFFFFFFFFu
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms))
+#define pdTRUE 1
+#define pdFALSE 0
+#define pdPASS 1
+#define pdFAIL 0
+#define tskNO_AFFINITY 0x7FFFFFFF
+
+typedef enum { eNoAction, eSetBits, eIncrement, eSetValueWithOverwrite, eSetValueWithoutOverwrite } eNotifyAction;
+
+// Tareas
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t funcion, const char *nombre, uint32_t pila, void *parametro,
+                                   UBaseType_t prioridad, TaskHandle_t *creada, BaseType_t nucleo);
+BaseType_t xTaskCreate(TaskFunction_t funcion, const char *nombre, uint32_t pila, void *parametro,
+                       UBaseType_t prioridad, TaskHandle_t *creada);
+void vTaskDelete(TaskHandle_t tarea);
+void vTaskDelay(TickType_t ticks);
+void vTaskDelayUntil(TickType_t *anterior, TickType_t incremento);
+TickType_t xTaskGetTickCount();
+TaskHandle_t xTaskGetCurrentTaskHandle();
+const char *pcTaskGetName(TaskHandle_t tarea);
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t tarea);
+BaseType_t xPortGetCoreID();
+
+// Notificaciones
+BaseType_t xTaskNotify(TaskHandle_t tarea, uint32_t valor, eNotifyAction accion);
+BaseType_t xTaskNotifyFromISR(TaskHandle_t tarea, uint32_t valor, eNotifyAction accion, BaseType_t *despertar);
+BaseType_t xTaskNotifyGive(TaskHandle_t tarea);
+void vTaskNotifyGiveFromISR(TaskHandle_t tarea, BaseType_t *despertar);
+uint32_t ulTaskNotifyTake(BaseType_t limpiar, TickType_t espera);
+BaseType_t xTaskNotifyWait(uint32_t limpiarAlEntrar, uint32_t limpiarAlSalir, uint32_t *valor, TickType_t espera);
+
+// Colas
+QueueHandle_t xQueueCreate(UBaseType_t longitud, UBaseType_t tamano);
+BaseType_t xQueueSend(QueueHandle_t cola, const void *elemento, TickType_t espera);
+BaseType_t xQueueSendFromISR(QueueHandle_t cola, const void *elemento, BaseType_t *despertar);
+BaseType_t xQueueReceive(QueueHandle_t cola, void *elemento, TickType_t espera);
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t cola);
+
+// Event groups
+EventGroupHandle_t xEventGroupCreate();
+EventBits_t xEventGroupSetBits(EventGroupHandle_t grupo, EventBits_t bits);
+BaseType_t xEventGroupSetBitsFromISR(EventGroupHandle_t grupo, EventBits_t bits, BaseType_t *despertar);
+EventBits_t xEventGroupClearBits(EventGroupHandle_t grupo, EventBits_t bits);
+EventBits_t xEventGroupGetBits(EventGroupHandle_t grupo);
+EventBits_t xEventGroupWaitBits(EventGroupHandle_t grupo, EventBits_t bits, BaseType_t limpiarAlSalir,
+                                BaseType_t esperarTodos, TickType_t espera);
+
+#endif // PLATAFORMA_NATIVA_FREERTOS_H
@@ -0,0 +1,7 @@
+#ifndef PLATAFORMA_NATIVA_EVENT_GROUPS_H
+#define PLATAFORMA_NATIVA_EVENT_GROUPS_H
+
+// Los event groups ya están en FreeRTOS.h
+#include "FreeRTOS.h"
+
+#endif // PLATAFORMA_NATIVA_EVENT_GROUPS_H
@@ -0,0 +1,408 @@
+#include "freertos/FreeRTOS.h"
+#include "simulacion.h"
+#include <cstring>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Planificador de FreeRTOS simulado (ver freertos/FreeRTOS.h). Cada tarea es
+// un hilo que espera su turno; el hilo principal elige la próxima tarea lista
+// (mayor prioridad y, entre iguales, la que hace más que no corre), le da el
+// turno y espera a que se bloquee. Si no hay ninguna lista adelanta el reloj
+// al vencimiento más próximo y corre los ISR de los temporizadores.
+//
+// Solo corre un hilo a la vez, así que el estado se toca sin candado; el
+// mutex sirve únicamente para pasar el turno con las variables de condición.
+
+void setup();
+void loop();
+
+struct TareaSimulada {
+    std::string nombre;
+    TaskFunction_t funcion;
+    void *parametro;
+    UBaseType_t prioridad;
+    uint32_t pila;
+    BaseType_t nucleo;
+    std::thread hilo;
+    std::condition_variable despertar;
+    bool turno = false;
+    bool terminada = false;
+    // Espera en curso: la tarea vuelve a estar lista cuando "condicion" da
+    // true o cuando el reloj llega a "venceUs"
+    bool bloqueada = false;
+    std::function<bool()> condicion;
+    uint64_t venceUs = UINT64_MAX;
+    bool vencio = false;
+    uint64_t ultimoTurno = 0;
+    uint32_t notificacion = 0;
+    bool notificacionPendiente = false;
+};
+
+struct ColaSimulada {
+    size_t longitud;
+    size_t tamano;
+    std::deque<std::vector<uint8_t>> elementos;
+};
+
+struct GrupoEventosSimulado {
+    EventBits_t bits = 0;
+};
+
+namespace {
+
+struct Temporizador {
+    uint64_t periodoUs;
+    uint64_t proximoUs;
+    bool activo;
+    void (*isr)();
+};
+
+std::mutex candado;
+std::condition_variable planificadorLibre;
+std::vector<TareaSimulada *> tareas;
+std::vector<Temporizador> temporizadores;
+TareaSimulada *actual = nullptr;
+uint64_t relojUs = 0;
+uint64_t turnos = 0;
+
+// Vencimiento alineado al tick, como las esperas de FreeRTOS
+uint64_t venceEnTicks(TickType_t ticks) {
+    if (ticks == portMAX_DELAY) return UINT64_MAX;
+    return (relojUs / 1000 + ticks) * 1000;
+}
+
+// Devuelve el turno al planificador y espera el próximo
+void cederTurno(TareaSimulada *t, std::unique_lock<std::mutex> &l) {
+    t->turno = false;
+    actual = nullptr;
+    planificadorLibre.notify_one();
+    t->despertar.wait(l, [t] { return t->turno; });
+}
+
+// Bloquea la tarea actual hasta que "condicion" se cumpla o venza el plazo.
+// Al despertar se vuelve a comprobar: otra tarea pudo ganarle el elemento.
+bool esperarHasta(const std::function<bool()> &condicion, uint64_t venceUs) {
+    for (;;) {
+        if (condicion()) return true;
+        TareaSimulada *t = actual;
+        if (t == nullptr || venceUs <= relojUs) return false; // En un ISR no se espera
+        std::unique_lock<std::mutex> l(candado);
+        t->condicion = condicion;
+        t->venceUs = venceUs;
+        t->bloqueada = true;
+        cederTurno(t, l);
+        if (t->vencio) return condicion();
+    }
+}
+
+bool esperar(const std::function<bool()> &condicion, TickType_t espera) {
+    if (espera == 0) return condicion();
+    return esperarHasta(condicion, venceEnTicks(espera));
+}
+
+void cuerpoTarea(TareaSimulada *t) {
+    {
+        std::unique_lock<std::mutex> l(candado);
+        t->despertar.wait(l, [t] { return t->turno; });
+    }
+    t->funcion(t->parametro);
+    // Una tarea de FreeRTOS no debe volver; se la trata como vTaskDelete(NULL)
+    vTaskDelete(NULL);
+}
+
+TareaSimulada *elegirTarea() {
+    TareaSimulada *elegida = nullptr;
+    for (TareaSimulada *t : tareas) {
+        if (t->terminada) continue;
+        if (t->bloqueada) {
+            if (t->condicion()) {
+                t->vencio = false;
+            } else if (t->venceUs <= relojUs) {
+                t->vencio = true;
+            } else {
+                continue;
+            }
+            t->bloqueada = false;
+            t->condicion = nullptr;
+        }
+        if (elegida == nullptr || t->prioridad > elegida->prioridad ||
+            (t->prioridad == elegida->prioridad && t->ultimoTurno < elegida->ultimoTurno)) {
+            elegida = t;
+        }
+    }
+    return elegida;
+}
+
+uint64_t proximoEvento() {
+    uint64_t proximo = UINT64_MAX;
+    for (TareaSimulada *t : tareas) {
+        if (!t->terminada && t->bloqueada && t->venceUs < proximo) proximo = t->venceUs;
+    }
+    for (const Temporizador &tm : temporizadores) {
+        if (tm.activo && tm.proximoUs < proximo) proximo = tm.proximoUs;
+    }
+    return proximo;
+}
+
+void correrTemporizadoresVencidos() {
+    for (size_t i = 0; i < temporizadores.size(); i++) {
+        Temporizador &tm = temporizadores[i];
+        if (tm.activo && tm.proximoUs <= relojUs) {
+            tm.proximoUs += tm.periodoUs;
+            tm.isr();
+        }
+    }
+}
+
+void tareaArduino(void *) {
+    setup();
+    for (;;) loop();
+}
+
+} // namespace
+
+// --- Reloj y corrida ---
+
+uint64_t simTiempoUs() {
+    return relojUs;
+}
+
+uint64_t simCambiosDeContexto() {
+    return turnos;
+}
+
+int simCrearTemporizador(uint64_t periodoUs, void (*isr)()) {
+    temporizadores.push_back({periodoUs, 0, false, isr});
+    return (int)temporizadores.size() - 1;
+}
+
+void simArrancarTemporizador(int temporizador) {
+    Temporizador &tm = temporizadores[temporizador];
+    if (tm.activo) return;
+    tm.activo = true;
+    tm.proximoUs = relojUs + tm.periodoUs;
+}
+
+void simDetenerTemporizador(int temporizador) {
+    temporizadores[temporizador].activo = false;
+}
+
+bool simCorrer(uint64_t duracionUs) {
+    xTaskCreatePinnedToCore(tareaArduino, "loopTask", 8192, NULL, 1, NULL, 1);
+    uint64_t fin = relojUs + duracionUs;
+    std::unique_lock<std::mutex> l(candado);
+    for (;;) {
+        TareaSimulada *t = elegirTarea();
+        if (t != nullptr) {
+            t->ultimoTurno = ++turnos;
+            actual = t;
+            t->turno = true;
+            t->despertar.notify_one();
+            planificadorLibre.wait(l, [] { return actual == nullptr; });
+            continue;
+        }
+        uint64_t proximo = proximoEvento();
+        if (proximo == UINT64_MAX) return false;
+        if (proximo > fin) {
+            relojUs = fin;
+            return true;
+        }
+        relojUs = proximo;
+        correrTemporizadoresVencidos();
+    }
+}
+
+// --- Tareas ---
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t funcion, const char *nombre, uint32_t pila, void *parametro,
+                                   UBaseType_t prioridad, TaskHandle_t *creada, BaseType_t nucleo) {
+    TareaSimulada *t = new TareaSimulada();
+    t->nombre = nombre;
+    t->funcion = funcion;
+    t->parametro = parametro;
+    t->prioridad = prioridad;
+    t->pila = pila;
+    t->nucleo = nucleo;
+    // Recién creada corre antes que las que ya corrieron
+    t->ultimoTurno = 0;
+    tareas.push_back(t);
+    t->hilo = std::thread(cuerpoTarea, t);
+    if (creada != NULL) *creada = t;
+    return pdPASS;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t funcion, const char *nombre, uint32_t pila, void *parametro,
+                       UBaseType_t prioridad, TaskHandle_t *creada) {
+    return xTaskCreatePinnedToCore(funcion, nombre, pila, parametro, prioridad, creada, tskNO_AFFINITY);
+}
+
+void vTaskDelete(TaskHandle_t tarea) {
+    TareaSimulada *t = tarea != NULL ? tarea : actual;
+    if (t == nullptr) return;
+    t->terminada = true;
+    if (t == actual) {
+        // El hilo queda dormido para siempre; se descarta al terminar el proceso
+        std::unique_lock<std::mutex> l(candado);
+        cederTurno(t, l);
+    }
+}
+
+void vTaskDelay(TickType_t ticks) {
+    if (ticks == 0) {
+        // Cede el turno a las de igual prioridad
+        esperarHasta([] { return false; }, relojUs + 1);
+        return;
+    }
+    esperar([] { return false; }, ticks);
+}
+
+void vTaskDelayUntil(TickType_t *anterior, TickType_t incremento) {
+    *anterior += incremento;
+    esperarHasta([] { return false; }, (uint64_t)*anterior * 1000);
+}
+
+TickType_t xTaskGetTickCount() {
+    return (TickType_t)(relojUs / 1000);
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle() {
+    return actual;
+}
+
+const char *pcTaskGetName(TaskHandle_t tarea) {
+    TareaSimulada *t = tarea != NULL ? tarea : actual;
+    return t != nullptr ? t->nombre.c_str() : "isr";
+}
+
+// En la PC no se mide la pila: se informa la reservada entera
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t tarea) {
+    TareaSimulada *t = tarea != NULL ? tarea : actual;
+    return t != nullptr ? t->pila : 0;
+}
+
+BaseType_t xPortGetCoreID() {
+    return actual != nullptr && actual->nucleo != tskNO_AFFINITY ? actual->nucleo : 0;
+}
+
+// --- Notificaciones ---
+
+BaseType_t xTaskNotify(TaskHandle_t tarea, uint32_t valor, eNotifyAction accion) {
+    if (accion == eSetValueWithoutOverwrite && tarea->notificacionPendiente) return pdFAIL;
+    switch (accion) {
+    case eSetBits: tarea->notificacion |= valor; break;
+    case eIncrement: tarea->notificacion++; break;
+    case eSetValueWithOverwrite:
+    case eSetValueWithoutOverwrite: tarea->notificacion = valor; break;
+    case eNoAction: break;
+    }
+    tarea->notificacionPendiente = true;
+    return pdPASS;
+}
+
+BaseType_t xTaskNotifyFromISR(TaskHandle_t tarea, uint32_t valor, eNotifyAction accion, BaseType_t *despertar) {
+    if (despertar != NULL) *despertar = pdFALSE;
+    return xTaskNotify(tarea, valor, accion);
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t tarea) {
+    return xTaskNotify(tarea, 0, eIncrement);
+}
+
+void vTaskNotifyGiveFromISR(TaskHandle_t tarea, BaseType_t *despertar) {
+    if (despertar != NULL) *despertar = pdFALSE;
+    xTaskNotifyGive(tarea);
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t limpiar, TickType_t espera) {
+    TareaSimulada *t = actual;
+    if (!esperar([t] { return t->notificacion != 0; }, espera)) return 0;
+    uint32_t valor = t->notificacion;
+    t->notificacion = limpiar ? 0 : valor - 1;
+    t->notificacionPendiente = false;
+    return valor;
+}
+
+BaseType_t xTaskNotifyWait(uint32_t limpiarAlEntrar, uint32_t limpiarAlSalir, uint32_t *valor, TickType_t espera) {
+    TareaSimulada *t = actual;
+    if (!t->notificacionPendiente) t->notificacion &= ~limpiarAlEntrar;
+    if (!esperar([t] { return t->notificacionPendiente; }, espera)) return pdFALSE;
+    if (valor != NULL) *valor = t->notificacion;
+    t->notificacion &= ~limpiarAlSalir;
+    t->notificacionPendiente = false;
+    return pdTRUE;
+}
+
+// --- Colas ---
+
+QueueHandle_t xQueueCreate(UBaseType_t longitud, UBaseType_t tamano) {
+    ColaSimulada *cola = new ColaSimulada();
+    cola->longitud = longitud;
+    cola->tamano = tamano;
+    return cola;
+}
+
+BaseType_t xQueueSend(QueueHandle_t cola, const void *elemento, TickType_t espera) {
+    if (!esperar([cola] { return cola->elementos.size() < cola->longitud; }, espera)) return pdFAIL;
+    const uint8_t *bytes = (const uint8_t *)elemento;
+    cola->elementos.emplace_back(bytes, bytes + cola->tamano);
+    return pdPASS;
+}
+
+BaseType_t xQueueSendFromISR(QueueHandle_t cola, const void *elemento, BaseType_t *despertar) {
+    if (despertar != NULL) *despertar = pdFALSE;
+    return xQueueSend(cola, elemento, 0);
+}
+
+BaseType_t xQueueReceive(QueueHandle_t cola, void *elemento, TickType_t espera) {
+    if (!esperar([cola] { return !cola->elementos.empty(); }, espera)) return pdFAIL;
+    memcpy(elemento, cola->elementos.front().data(), cola->tamano);
+    cola->elementos.pop_front();
+    return pdPASS;
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t cola) {
+    return cola->elementos.size();
+}
+
+// --- Event groups ---
+
+EventGroupHandle_t xEventGroupCreate() {
+    return new GrupoEventosSimulado();
+}
+
+EventBits_t xEventGroupSetBits(EventGroupHandle_t grupo, EventBits_t bits) {
+    grupo->bits |= bits;
+    return grupo->bits;
+}
+
+BaseType_t xEventGroupSetBitsFromISR(EventGroupHandle_t grupo, EventBits_t bits, BaseType_t *despertar) {
+    if (despertar != NULL) *despertar = pdFALSE;
+    xEventGroupSetBits(grupo, bits);
+    return pdPASS;
+}
+
+EventBits_t xEventGroupClearBits(EventGroupHandle_t grupo, EventBits_t bits) {
+    EventBits_t antes = grupo->bits;
+    grupo->bits &= ~bits;
+    return antes;
+}
+
+EventBits_t xEventGroupGetBits(EventGroupHandle_t grupo) {
+    return grupo->bits;
+}
+
+EventBits_t xEventGroupWaitBits(EventGroupHandle_t grupo, EventBits_t bits, BaseType_t limpiarAlSalir,
+                                BaseType_t esperarTodos, TickType_t espera) {
+    auto cumplida = [grupo, bits, esperarTodos] {
+        return esperarTodos ? (grupo->bits & bits) == bits : (grupo->bits & bits) != 0;
+    };
+    bool ok = esperar(cumplida, espera);
+    EventBits_t valor = grupo->bits;
+    if (ok && limpiarAlSalir) grupo->bits &= ~bits;
+    return valor;
+}
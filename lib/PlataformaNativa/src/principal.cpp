@@ -0,0 +1,53 @@
+#include "simulacion.h"
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+
+// main() de [env:native]: corre el programa de src/ durante los segundos
+// simulados que se pasen (60 si no se pasa nada) e informa cuánto tardó.
+// Los argumentos siguientes son para simPreparar().
+//   .pio/build/native/program 120
+
+__attribute__((weak)) bool simPreparar(int argc, char **argv) {
+    (void)argc;
+    (void)argv;
+    return true;
+}
+
+__attribute__((weak)) void simInformar(double segundosReales) {
+    (void)segundosReales;
+}
+
+void simSalir(int codigo) {
+    fflush(stdout);
+    fflush(stderr);
+    // Como al final de main(): los hilos de las otras tareas no se destruyen
+    _Exit(codigo);
+}
+
+// Las pruebas (pio test define UNIT_TEST) terminan solas con simSalir()
+#ifdef UNIT_TEST
+#define SEGUNDOS_POR_DEFECTO 36000
+#else
+#define SEGUNDOS_POR_DEFECTO 60
+#endif
+
+int main(int argc, char **argv) {
+    double segundos = argc > 1 ? atof(argv[1]) : SEGUNDOS_POR_DEFECTO;
+    if (!simPreparar(argc > 2 ? argc - 2 : 0, argv + (argc > 2 ? 2 : argc))) return 1;
+    auto inicio = std::chrono::steady_clock::now();
+    bool completa = simCorrer((uint64_t)(segundos * 1e6));
+    double real = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+    fflush(stdout);
+    fprintf(stderr, "[nativo] %.3f s simulados en %.3f s reales, %llu cambios de contexto%s\n",
+            simTiempoUs() / 1e6, real, (unsigned long long)simCambiosDeContexto(),
+            completa ? "" : " (todas las tareas bloqueadas)");
+    simInformar(real);
+#ifdef UNIT_TEST
+    fprintf(stderr, "[nativo] la prueba no llamó a simSalir()\n");
+    completa = false;
+#endif
+    fflush(stderr);
+    // Los hilos de las tareas siguen dormidos: se sale sin destruirlos
+    _Exit(completa ? 0 : 1);
+}
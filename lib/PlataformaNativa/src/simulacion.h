@@ -0,0 +1,38 @@
+#ifndef PLATAFORMA_NATIVA_SIMULACION_H
+#define PLATAFORMA_NATIVA_SIMULACION_H
+
+#include <stdint.h>
+
+// Control del reloj simulado y de la corrida, para hal_nativo.h y para los
+// programas que usen la plataforma (el main nativo corre setup() y loop()).
+
+// Microsegundos simulados desde el arranque
+uint64_t simTiempoUs();
+
+// Temporizador periódico: "isr" corre en contexto de interrupción (entre
+// tareas) cada "periodoUs", desde un periodo después de arrancarlo
+int simCrearTemporizador(uint64_t periodoUs, void (*isr)());
+void simArrancarTemporizador(int temporizador);
+void simDetenerTemporizador(int temporizador);
+
+// Crea la tarea de Arduino (setup() y después loop() para siempre) y corre
+// el planificador hasta "duracionUs" simulados. Devuelve false si antes de
+// eso todas las tareas quedaron bloqueadas sin nada que las despierte.
+bool simCorrer(uint64_t duracionUs);
+
+// Cambios de contexto hechos en la corrida (para medir la simulación)
+uint64_t simCambiosDeContexto();
+
+// Ganchos del programa simulado; principal.cpp trae versiones que no hacen
+// nada y el programa puede definir las suyas (src/simulador.h).
+// simPreparar recibe los argumentos que siguen a los segundos simulados y
+// corre antes de setup(); si devuelve false no se corre.
+bool simPreparar(int argc, char **argv);
+// Al terminar la corrida, con las tareas detenidas
+void simInformar(double segundosReales);
+
+// Termina el programa ya, desde cualquier tarea, con "codigo" como estado de
+// salida (las pruebas de test/ lo llaman al terminar, desde setup())
+void simSalir(int codigo);
+
+#endif // PLATAFORMA_NATIVA_SIMULACION_H
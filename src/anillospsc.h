@@ -0,0 +1,59 @@
+#ifndef ANILLO_SPSC_H
+#define ANILLO_SPSC_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+
+// Buffer circular de capacidad fija para un productor y un consumidor.
+// Ninguno de los dos bloquea: insertar() falla si está lleno y extraer()
+// si está vacío. El productor solo escribe "cabeza" y el consumidor solo
+// escribe "cola", así que basta con índices atómicos (sin mutex).
+template <typename T, size_t N>
+class AnilloSPSC {
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "La capacidad debe ser potencia de 2");
+
+public:
+    // Solo desde el productor
+    bool insertar(const T &elemento) {
+        uint32_t c = cabeza.load(std::memory_order_relaxed);
+        if (c - cola.load(std::memory_order_acquire) == N) {
+            descartados.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        datos[c & (N - 1)] = elemento;
+        // El elemento queda visible para el consumidor recién con este store
+        cabeza.store(c + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Solo desde el consumidor
+    bool extraer(T &elemento) {
+        uint32_t t = cola.load(std::memory_order_relaxed);
+        if (t == cabeza.load(std::memory_order_acquire)) {
+            return false;
+        }
+        elemento = datos[t & (N - 1)];
+        // Recién ahora el productor puede reutilizar la casilla
+        cola.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    size_t disponibles() const {
+        return cabeza.load(std::memory_order_acquire) - cola.load(std::memory_order_acquire);
+    }
+
+    uint32_t totalDescartados() const {
+        return descartados.load(std::memory_order_relaxed);
+    }
+
+    static constexpr size_t capacidad() { return N; }
+
+private:
+    T datos[N];
+    std::atomic<uint32_t> cabeza{0};
+    std::atomic<uint32_t> cola{0};
+    std::atomic<uint32_t> descartados{0};
+};
+
+#endif // ANILLO_SPSC_H
@@ -11,25 +11,25 @@
 #else
 #include <ESP8266WiFi.h>
 #endif
-#include <Wire.h>
+#include <algorithm>
 #include "WiFi.h"
-
-// Definir puntos - AUMENTADO para más capacidad
-#define MAX_PUNTOS 500
+#include "mapaocupacion.h"
+#include "estadorobot.h"
+#include "escritorchunked.h"
+#include "tramabinaria.h"
+#include "dashboard_gz.h"
+#include "radar.h"
+#include "registro.h"
+#include "metricas.h"
+#include "traza.h"
 
 // Variables externas
 extern int numPuntos;
-extern int historialAngulos[];
-extern int historialDistancias[];
-extern float ultimoAngulo;
-extern float ultimaDistancia;
-extern float robotX;
-extern float robotY;
-extern float robotAngulo;
-
-// NUEVAS VARIABLES: Coordenadas absolutas de obstáculos
-extern float obstaculosX[MAX_PUNTOS];
-extern float obstaculosY[MAX_PUNTOS];
+extern AnguloBinario ultimoAngulo;
+extern uint16_t ultimaDistancia;
+
+// Mapa de ocupación: se envían los centros de las celdas ocupadas
+extern MapaRobot mapa;
 
 extern WebServer server;
 
@@ -58,252 +58,223 @@ void escribirStringEnEEPROM(int direccion, String cadena) {
     EEPROM.commit();
 }
 
+// Identifica este arranque: un cursor "since" de otro arranque no sirve
+uint32_t idArranque = 0;
+
+// Respuestas por partes con buffer fijo de 512 bytes en la pila
+typedef EscritorChunked<WebServer> EscritorWeb;
+
+// --- Pico de heap de cada respuesta ---
+// Solo se informa cuando un handler supera su peor marca
+uint32_t heapLibre() {
+    return ESP.getFreeHeap();
+}
+
+void reportarHeap(const char *handler, uint32_t heapInicial, const EscritorWeb &w, uint32_t &peorPico) {
+    uint32_t pico = w.heapMinimo < heapInicial ? heapInicial - w.heapMinimo : 0;
+    if (pico > peorPico) {
+        peorPico = pico;
+        REG_INFO("%s: %u bytes enviados, pico de heap %u bytes", handler, (unsigned)w.totalEnviado(), (unsigned)pico);
+    }
+}
+
+// Pose y última lectura, sin cerrar el objeto JSON. "seq" es el cursor con
+// el que el cliente pide lo siguiente.
+template <typename Escritor>
+void serializarEstado(Escritor &w, uint32_t seq) {
+    w.agregar("{\"numPuntos\":"); w.agregarEntero(numPuntos);
+    w.agregar(",\"ultimoAngulo\":"); w.agregarFijo(decimasDeGrado(ultimoAngulo), 1);
+    w.agregar(",\"ultimaDistancia\":"); w.agregarEntero(ultimaDistancia);
+    // La pose va en mm y grados, con la resolución del punto fijo
+    PoseRobot pose = instantaneaPose();
+    w.agregar(",\"robotX\":"); w.agregarFijo(pose.x, 3);
+    w.agregar(",\"robotY\":"); w.agregarFijo(pose.y, 3);
+    w.agregar(",\"robotAngulo\":"); w.agregarFijo(decimasDeGrado(pose.angulo), 1);
+    w.agregar(",\"arranque\":"); w.agregarNatural(idArranque);
+    w.agregar(",\"seq\":"); w.agregarNatural(seq);
+}
+
+// --- Serializa el estado para /get-data ---
+// Con un cursor válido solo se envían las celdas que cambiaron después de él;
+// si no, el mapa completo. La pose siempre va (son pocos bytes).
+// Escritor puede ser cualquier EscritorChunked (HTTP o canal de eventos)
+template <typename Escritor>
+void serializarDatos(Escritor &w, uint32_t desde, uint32_t arranque) {
+    serializarEstado(w, mapa.secuencia());
+
+    bool primero = true;
+    if (arranque == idArranque && desde > 0 && mapa.hayCambiosDesde(desde)) {
+        // Cambios desde el cursor: [x, y, 1] = nueva celda ocupada, [x, y, 0] = liberada
+        w.agregar(",\"completo\":false,\"cambios\":[");
+        mapa.recorrerCambiosDesde(desde, [&](int32_t x, int32_t y, bool ocupada) {
+            if (!primero) w.agregar(',');
+            w.agregar('['); w.agregarEntero(x);
+            w.agregar(','); w.agregarEntero(y);
+            w.agregar(ocupada ? ",1]" : ",0]");
+            primero = false;
+        });
+        w.agregar("]}");
+        return;
+    }
+
+    // Celdas ocupadas del mapa, en coordenadas absolutas
+    w.agregar(",\"completo\":true,\"obstaculos\":[");
+    mapa.recorrerOcupadas([&](int32_t x, int32_t y) {
+        if (!primero) w.agregar(',');
+        w.agregar('['); w.agregarEntero(x);
+        w.agregar(','); w.agregarEntero(y);
+        w.agregar(']');
+        primero = false;
+    });
+    w.agregar("]}");
+}
+
+// --- Serializa el estado como trama binaria (ver tramabinaria.h) ---
+// En modo incremental cada celda que cambió va en la lista que corresponde a
+// su estado actual, así el orden de los cambios dentro de la ventana no importa.
+template <typename Escritor>
+void serializarTrama(Escritor &w, uint32_t desde, uint32_t arranque) {
+    bool incremental = arranque == idArranque && desde > 0 && mapa.hayCambiosDesde(desde);
+
+    CabeceraTrama c = {};
+    c.banderas = incremental ? 0 : TRAMA_COMPLETA;
+    c.arranque = idArranque;
+    c.seq = mapa.secuencia();
+    PoseRobot pose = instantaneaPose();
+    c.robotX = saturarInt16(mmDesdeMicras(pose.x));
+    c.robotY = saturarInt16(mmDesdeMicras(pose.y));
+    c.robotAngulo = pose.angulo;
+    c.ultimoAngulo = ultimoAngulo;
+    c.ultimaDistancia = ultimaDistancia;
+    c.numPuntos = numPuntos;
+
+    if (!incremental) {
+        c.ocupadas = mapa.totalOcupadas();
+        escribirCabeceraTrama(w, c);
+        mapa.recorrerOcupadas([&](int32_t x, int32_t y) { escribirPuntoTrama(w, x, y); });
+        return;
+    }
+
+    mapa.recorrerCambiosDesde(desde, [&](int32_t x, int32_t y, bool) {
+        if (mapa.ocupadaEn(x, y)) c.ocupadas++; else c.libres++;
+    });
+    escribirCabeceraTrama(w, c);
+    mapa.recorrerCambiosDesde(desde, [&](int32_t x, int32_t y, bool) {
+        if (mapa.ocupadaEn(x, y)) escribirPuntoTrama(w, x, y);
+    });
+    mapa.recorrerCambiosDesde(desde, [&](int32_t x, int32_t y, bool) {
+        if (!mapa.ocupadaEn(x, y)) escribirPuntoTrama(w, x, y);
+    });
+}
+
 // --- Endpoint para obtener datos actualizados (JSON) ---
+// /get-data?since=<seq>&arranque=<id> devuelve solo lo nuevo desde <seq>
 void handleGetData() {
-    String json = "{";
-    json += "\"numPuntos\":" + String(numPuntos) + ",";
-    json += "\"ultimoAngulo\":" + String(ultimoAngulo, 1) + ",";
-    json += "\"ultimaDistancia\":" + String(ultimaDistancia, 1) + ",";
-    json += "\"robotX\":" + String(robotX, 1) + ",";
-    json += "\"robotY\":" + String(robotY, 1) + ",";
-    json += "\"robotAngulo\":" + String(robotAngulo, 1) + ",";
-    
-    // Usar las coordenadas absolutas ya calculadas
-    json += "\"obstaculos\":[";
-    for (int i = 0; i < numPuntos; i++) {
-        json += "{\"x\":" + String(obstaculosX[i], 1) + ",\"y\":" + String(obstaculosY[i], 1) + "}";
-        if (i < numPuntos - 1) json += ",";
+    static uint32_t peorPico = 0;
+    uint32_t heapInicial = heapLibre();
+    uint32_t desde = server.hasArg("since") ? strtoul(server.arg("since").c_str(), NULL, 10) : 0;
+    uint32_t arranque = server.hasArg("arranque") ? strtoul(server.arg("arranque").c_str(), NULL, 10) : 0;
+
+    EscritorWeb w(server);
+    w.medirHeap = heapLibre;
+    w.iniciar(200, "application/json");
+    serializarDatos(w, desde, arranque);
+    w.terminar();
+    reportarHeap("/get-data", heapInicial, w, peorPico);
+}
+
+// --- Endpoint binario: mismo contenido que /get-data en ~4 bytes por celda ---
+void handleGetDataBin() {
+    static uint32_t peorPico = 0;
+    uint32_t heapInicial = heapLibre();
+    uint32_t desde = server.hasArg("since") ? strtoul(server.arg("since").c_str(), NULL, 10) : 0;
+    uint32_t arranque = server.hasArg("arranque") ? strtoul(server.arg("arranque").c_str(), NULL, 10) : 0;
+
+    EscritorWeb w(server);
+    w.medirHeap = heapLibre;
+    w.iniciar(200, "application/octet-stream");
+    serializarTrama(w, desde, arranque);
+    w.terminar();
+    reportarHeap("/get-data.bin", heapInicial, w, peorPico);
+}
+
+// --- Radar: calibración y modo de barrido ---
+// GET /radar devuelve el estado. Parámetros opcionales:
+//   pasosPorVuelta, desfase  calibración (se guarda en la EEPROM)
+//   cero=1                   la posición actual del radar pasa a ser el cero
+//   modo=quieto|vaiven|continuo, amplitud (°), velocidad (°/s)
+// Un modo desconocido o un valor fuera de rango responde 400 sin cambiar nada
+void handleRadar() {
+    CalibracionRadar calibracion = calibracionRadar;
+    bool calibrar = false;
+    if (server.hasArg("pasosPorVuelta")) {
+        long pasos = server.arg("pasosPorVuelta").toInt();
+        if (pasos <= 0 || pasos > 65535) {
+            server.send(400, "text/plain", "pasosPorVuelta fuera de rango");
+            return;
+        }
+        calibracion.pasosPorVuelta = pasos;
+        calibrar = true;
     }
-    json += "]}";
-    
+    if (server.hasArg("desfase")) {
+        calibracion.desfase = server.arg("desfase").toFloat();
+        calibrar = true;
+    }
+
+    bool barrido = server.hasArg("modo") || server.hasArg("amplitud") || server.hasArg("velocidad");
+    ModoRadar modo = modoRadar;
+    if (server.hasArg("modo")) {
+        String nombre = server.arg("modo");
+        if (nombre == "quieto") modo = RADAR_QUIETO;
+        else if (nombre == "vaiven") modo = RADAR_VAIVEN;
+        else if (nombre == "continuo") modo = RADAR_CONTINUO;
+        else {
+            server.send(400, "text/plain", "modo desconocido (quieto, vaiven o continuo)");
+            return;
+        }
+    }
+    float amplitud = server.hasArg("amplitud") ? server.arg("amplitud").toFloat() : amplitudRadar;
+    if (!(amplitud > 0 && amplitud <= 180)) {
+        server.send(400, "text/plain", "amplitud fuera de rango (0 a 180 grados)");
+        return;
+    }
+    // La velocidad del eje va en pasos enteros, entre 1 y la máxima del perfil
+    float velocidad = server.hasArg("velocidad") ? server.arg("velocidad").toFloat() : velocidadRadar;
+    float pasosPorSegundo = velocidad * calibracion.pasosPorVuelta / 360.0f;
+    if (!(pasosPorSegundo >= 1 && pasosPorSegundo <= velocidadMaxima)) {
+        server.send(400, "text/plain", "velocidad fuera de rango");
+        return;
+    }
+
+    if (calibrar) {
+        calibracionRadar = calibracion;
+        guardarCalibracionRadar();
+    }
+    if (server.arg("cero") == "1") ceroRadar = posicionEje(EJE_RADAR);
+    if (barrido) configurarBarrido(modo, amplitud, velocidad);
+
+    static const char *nombresModo[] = {"quieto", "vaiven", "continuo"};
+    char json[192];
+    snprintf(json, sizeof(json),
+             "{\"modo\":\"%s\",\"amplitud\":%.1f,\"velocidad\":%.1f,\"pasosPorVuelta\":%u,"
+             "\"desfase\":%.2f,\"angulo\":%.2f,\"pasadas\":%lu}",
+             nombresModo[modoRadar], amplitudRadar, velocidadRadar, (unsigned)calibracionRadar.pasosPorVuelta,
+             calibracionRadar.desfase, anguloRadar(), (unsigned long)pasadasRadar.load());
     server.send(200, "application/json", json);
 }
 
 // --- Página principal (Mapa Cartesiano) ---
+// El tablero es estático y va comprimido en flash (src/dashboard_gz.h, generado
+// desde web/index.html); el estado del robot lo pide la página a /get-data
 void handleRoot() {
-    int canvasSize = 600; // Aumentamos el tamaño para mejor visualización
-    
-    // Calcular coordenadas iniciales para el mapa usando coordenadas absolutas
-    String obstaculos = "[";
-    for (int i = 0; i < numPuntos; i++) {
-        obstaculos += "{\"x\":" + String(obstaculosX[i], 1) + ",\"y\":" + String(obstaculosY[i], 1) + "}";
-        if (i < numPuntos - 1) obstaculos += ",";
+    server.sendHeader("ETag", DASHBOARD_ETAG);
+    server.sendHeader("Cache-Control", "no-cache");
+    if (server.header("If-None-Match") == DASHBOARD_ETAG) {
+        server.send(304);
+        return;
     }
-    obstaculos += "]";
-
-    // HTML con mapa cartesiano
-    String html = "<!DOCTYPE html><html><head><meta charset='UTF-8'>";
-    html += "<title>Mapa Robot ESP32</title>";
-    html += "<style>";
-    html += "body { font-family: Arial; background: #0a0a0a; color: #eee; text-align: center; padding: 20px; margin: 0; }";
-    html += ".container { max-width: 1200px; margin: 0 auto; }";
-    html += ".header { background: #1a1a1a; border-radius: 10px; padding: 20px; margin-bottom: 20px; }";
-    html += "h1 { color: #00ff88; margin: 0 0 10px 0; font-size: 2.5em; }";
-    html += ".status { display: inline-block; padding: 8px 15px; border-radius: 20px; font-weight: bold; margin-left: 15px; }";
-    html += ".map-container { background: #1a1a1a; border-radius: 15px; padding: 20px; box-shadow: 0 4px 15px rgba(0,0,0,0.5); }";
-    html += "#mapaCanvas { background: #000; border: 2px solid #00ff88; border-radius: 10px; }";
-    html += ".info-grid { display: grid; grid-template-columns: repeat(auto-fit, minmax(250px, 1fr)); gap: 20px; margin-top: 20px; }";
-    html += ".info-card { background: #2a2a2a; border-radius: 10px; padding: 15px; }";
-    html += ".info-title { color: #00ff88; font-weight: bold; margin-bottom: 10px; }";
-    html += ".info-value { font-size: 1.3em; color: #fff; }";
-    html += ".legend { display: flex; justify-content: center; gap: 30px; margin-top: 15px; flex-wrap: wrap; }";
-    html += ".legend-item { display: flex; align-items: center; gap: 8px; }";
-    html += ".legend-color { width: 15px; height: 15px; border-radius: 50%; border: 2px solid #fff; }";
-    html += "</style></head><body>";
-
-    html += "<div class='container'>";
-    html += "<div class='header'>";
-    html += "<h1>Mapa del Entorno</h1>";
-    html += "<span class='status' id='status' style='background: #28a745;'> En línea</span>";
-    html += "</div>";
-
-    html += "<div class='map-container'>";
-    html += "<canvas id='mapaCanvas' width='" + String(canvasSize) + "' height='" + String(canvasSize) + "'></canvas>";
-    
-    html += "<div class='legend'>";
-    html += "<div class='legend-item'><div class='legend-color' style='background: #00ff00;'></div><span>Robot</span></div>";
-    html += "<div class='legend-item'><div class='legend-color' style='background: #ff0040;'></div><span>Obstáculos</span></div>";
-    html += "<div class='legend-item'><div class='legend-color' style='background: #0088ff;'></div><span>Trayectoria</span></div>";
-    html += "<div class='legend-item'><div class='legend-color' style='background: #ffaa00;'></div><span>Dirección</span></div>";
-    html += "</div>";
-    html += "</div>";
-
-    html += "<div class='info-grid'>";
-    html += "<div class='info-card'>";
-    html += "<div class='info-title'> Último Escaneo</div>";
-    html += "<div class='info-value'><span id='ultimoAngulo'>" + String(ultimoAngulo, 1) + "</span>° - <span id='ultimaDistancia'>" + String(ultimaDistancia, 1) + "</span> mm</div>";
-    html += "</div>";
-    html += "<div class='info-card'>";
-    html += "<div class='info-title'> Obstáculos Detectados</div>";
-    html += "<div class='info-value'><span id='numPuntos'>" + String(numPuntos) + "</span></div>";
-    html += "</div>";
-    html += "<div class='info-card'>";
-    html += "<div class='info-title'>Posición Robot</div>";
-    html += "<div class='info-value'>X: <span id='robotX'>" + String(robotX, 1) + "</span> mm</div>";
-    html += "<div class='info-value'>Y: <span id='robotY'>" + String(robotY, 1) + "</span> mm</div>";
-    html += "</div>";
-    html += "<div class='info-card'>";
-    html += "<div class='info-title'> Orientación</div>";
-    html += "<div class='info-value'><span id='robotAngulo'>" + String(robotAngulo, 1) + "</span>°</div>";
-    html += "</div>";
-    html += "</div>";
-    html += "</div>";
-
-    // JavaScript para mapa cartesiano en tiempo real
-    html += "<script>";
-    html += "let canvas = document.getElementById('mapaCanvas');";
-    html += "let ctx = canvas.getContext('2d');";
-    html += "let canvasSize = " + String(canvasSize) + ";";
-    html += "let ultimoNumPuntos = " + String(numPuntos) + ";";
-    html += "let trayectoriaRobot = [{x: " + String(robotX) + ", y: " + String(robotY) + "}];";
-    html += "let escalaPixelPorMM = 0.15;"; // Escala: 0.15 pixels por mm
-    html += "let offsetX = 0, offsetY = 0;"; // Para centrar el mapa dinámicamente
-
-    // Función para convertir coordenadas del mundo a canvas
-    html += "function mundoACanvas(x, y) {";
-    html += "  return {";
-    html += "    x: (canvasSize / 2) + (x * escalaPixelPorMM) + offsetX,";
-    html += "    y: (canvasSize / 2) - (y * escalaPixelPorMM) + offsetY"; // Y invertida para que arriba sea positivo
-    html += "  };";
-    html += "}";
-
-    // Función para dibujar grilla
-    html += "function dibujarGrilla() {";
-    html += "  ctx.strokeStyle = '#333';";
-    html += "  ctx.lineWidth = 1;";
-    html += "  let gridSize = 500 * escalaPixelPorMM;"; // Líneas cada 500mm
-    html += "  for(let i = -canvasSize; i <= canvasSize * 2; i += gridSize) {";
-    html += "    ctx.beginPath();";
-    html += "    ctx.moveTo(i + offsetX, 0);";
-    html += "    ctx.lineTo(i + offsetX, canvasSize);";
-    html += "    ctx.stroke();";
-    html += "    ctx.beginPath();";
-    html += "    ctx.moveTo(0, i + offsetY);";
-    html += "    ctx.lineTo(canvasSize, i + offsetY);";
-    html += "    ctx.stroke();";
-    html += "  }";
-    // Ejes principales
-    html += "  ctx.strokeStyle = '#555';";
-    html += "  ctx.lineWidth = 2;";
-    html += "  ctx.beginPath();";
-    html += "  ctx.moveTo(canvasSize/2 + offsetX, 0);";
-    html += "  ctx.lineTo(canvasSize/2 + offsetX, canvasSize);";
-    html += "  ctx.stroke();";
-    html += "  ctx.beginPath();";
-    html += "  ctx.moveTo(0, canvasSize/2 + offsetY);";
-    html += "  ctx.lineTo(canvasSize, canvasSize/2 + offsetY);";
-    html += "  ctx.stroke();";
-    html += "}";
-
-    // Función para dibujar el mapa completo
-    html += "function dibujarMapa(robotX, robotY, robotAngulo, obstaculos) {";
-    html += "  ctx.clearRect(0, 0, canvasSize, canvasSize);";
-    html += "  ";
-    html += "  dibujarGrilla();";
-    html += "  ";
-    html += "  let posRobot = mundoACanvas(robotX, robotY);";
-    html += "  ";
-    // Dibujar trayectoria del robot
-    html += "  if(trayectoriaRobot.length > 1) {";
-    html += "    ctx.strokeStyle = '#0088ff';";
-    html += "    ctx.lineWidth = 3;";
-    html += "    ctx.beginPath();";
-    html += "    let primerPunto = mundoACanvas(trayectoriaRobot[0].x, trayectoriaRobot[0].y);";
-    html += "    ctx.moveTo(primerPunto.x, primerPunto.y);";
-    html += "    for(let i = 1; i < trayectoriaRobot.length; i++) {";
-    html += "      let punto = mundoACanvas(trayectoriaRobot[i].x, trayectoriaRobot[i].y);";
-    html += "      ctx.lineTo(punto.x, punto.y);";
-    html += "    }";
-    html += "    ctx.stroke();";
-    html += "  }";
-    html += "  ";
-    // Dibujar obstáculos
-    html += "  obstaculos.forEach(obstaculo => {";
-    html += "    let pos = mundoACanvas(obstaculo.x, obstaculo.y);";
-    html += "    ctx.beginPath();";
-    html += "    ctx.arc(pos.x, pos.y, 4, 0, 2 * Math.PI);";
-    html += "    ctx.fillStyle = '#ff0040';";
-    html += "    ctx.fill();";
-    html += "    ctx.strokeStyle = '#ff4070';";
-    html += "    ctx.lineWidth = 2;";
-    html += "    ctx.stroke();";
-    html += "  });";
-    html += "  ";
-    // Dibujar robot con orientación
-    html += "  ctx.beginPath();";
-    html += "  ctx.arc(posRobot.x, posRobot.y, 8, 0, 2 * Math.PI);";
-    html += "  ctx.fillStyle = '#00ff00';";
-    html += "  ctx.fill();";
-    html += "  ctx.strokeStyle = '#00cc00';";
-    html += "  ctx.lineWidth = 3;";
-    html += "  ctx.stroke();";
-    html += "  ";
-    // Flecha de dirección del robot
-    html += "  let anguloRad = robotAngulo * Math.PI / 180;";
-    html += "  let flechaX = posRobot.x + Math.cos(anguloRad) * 20;";
-    html += "  let flechaY = posRobot.y - Math.sin(anguloRad) * 20;";
-    html += "  ctx.beginPath();";
-    html += "  ctx.moveTo(posRobot.x, posRobot.y);";
-    html += "  ctx.lineTo(flechaX, flechaY);";
-    html += "  ctx.strokeStyle = '#ffaa00';";
-    html += "  ctx.lineWidth = 4;";
-    html += "  ctx.stroke();";
-    html += "  ";
-    // Punta de flecha
-    html += "  let punta1X = flechaX - Math.cos(anguloRad - 0.5) * 8;";
-    html += "  let punta1Y = flechaY + Math.sin(anguloRad - 0.5) * 8;";
-    html += "  let punta2X = flechaX - Math.cos(anguloRad + 0.5) * 8;";
-    html += "  let punta2Y = flechaY + Math.sin(anguloRad + 0.5) * 8;";
-    html += "  ctx.beginPath();";
-    html += "  ctx.moveTo(flechaX, flechaY);";
-    html += "  ctx.lineTo(punta1X, punta1Y);";
-    html += "  ctx.moveTo(flechaX, flechaY);";
-    html += "  ctx.lineTo(punta2X, punta2Y);";
-    html += "  ctx.stroke();";
-    html += "}";
-
-    // Función para actualizar todos los datos sin recargar
-    html += "function actualizarDatos() {";
-    html += "  fetch('/get-data')";
-    html += "    .then(response => response.json())";
-    html += "    .then(data => {";
-    html += "      document.getElementById('numPuntos').textContent = data.numPuntos;";
-    html += "      document.getElementById('ultimoAngulo').textContent = data.ultimoAngulo;";
-    html += "      document.getElementById('ultimaDistancia').textContent = data.ultimaDistancia;";
-    html += "      document.getElementById('robotX').textContent = data.robotX;";
-    html += "      document.getElementById('robotY').textContent = data.robotY;";
-    html += "      document.getElementById('robotAngulo').textContent = data.robotAngulo;";
-    html += "      ";
-    // Actualizar trayectoria si el robot se movió
-    html += "      let ultimaPosicion = trayectoriaRobot[trayectoriaRobot.length - 1];";
-    html += "      if(Math.abs(ultimaPosicion.x - data.robotX) > 10 || Math.abs(ultimaPosicion.y - data.robotY) > 10) {";
-    html += "        trayectoriaRobot.push({x: data.robotX, y: data.robotY});";
-    html += "        if(trayectoriaRobot.length > 50) trayectoriaRobot.shift();"; // Limitar trayectoria
-    html += "      }";
-    html += "      ";
-    html += "      dibujarMapa(data.robotX, data.robotY, data.robotAngulo, data.obstaculos);";
-    html += "      document.getElementById('status').innerHTML = ' En línea';";
-    html += "      if(data.numPuntos !== ultimoNumPuntos) {";
-    html += "        ultimoNumPuntos = data.numPuntos;";
-    html += "        console.log('Nuevos obstáculos detectados: ' + data.numPuntos);";
-    html += "      }";
-    html += "    })";
-    html += "    .catch(error => {";
-    html += "      document.getElementById('status').innerHTML = 'Desconectado';";
-    html += "      document.getElementById('status').style.background = '#dc3545';";
-    html += "      console.error('Error:', error);";
-    html += "    });";
-    html += "}";
-
-    // Dibujar mapa inicial
-    html += "dibujarMapa(" + String(robotX) + ", " + String(robotY) + ", " + String(robotAngulo) + ", " + obstaculos + ");";
-    
-    // Actualizar cada 1.5 segundos
-    html += "setInterval(actualizarDatos, 1500);";
-    html += "</script>";
-
-    html += "</body></html>";
-    server.send(200, "text/html", html);
+    server.sendHeader("Content-Encoding", "gzip");
+    server.send_P(200, "text/html", (const char *)DASHBOARD_GZ, DASHBOARD_GZ_LEN);
 }
 
 // --- Manejo de registro WiFi ---
@@ -317,6 +288,77 @@ void handleWifi() {
     ESP.restart();
 }
 
+// --- Contadores de rendimiento para Prometheus (ver metricas.h) ---
+void handleMetricas() {
+    EscritorWeb w(server);
+    w.iniciar(200, "text/plain; version=0.0.4; charset=utf-8");
+    escribirMetricas(w);
+    w.terminar();
+}
+
+// --- Traza de eventos (ver traza.h y tools/traza_a_chrome.py) ---
+void handleTraza() {
+    EscritorWeb w(server);
+    w.iniciar(200, "application/octet-stream");
+    escribirTraza(w);
+    w.terminar();
+}
+
+// --- Tiempo de pasada de los pedidos ---
+// Desde que el servidor terminó la vuelta anterior del lazo hasta que el
+// handler del pedido terminó: lo que tarda el lazo en volver a
+// handleClient() más el handler. No es la latencia que ve el cliente (el
+// WebServer no dice cuándo llegó el pedido); esa la mide el simulador
+// desde que manda cada pedido.
+#define MUESTRAS_PASADA 256
+uint32_t pasadasUs[MUESTRAS_PASADA];
+int numPasadas = 0;
+uint32_t finVueltaServidorUs = 0;
+
+void registrarPasada(uint32_t finUs) {
+    if (numPasadas < MUESTRAS_PASADA) {
+        pasadasUs[numPasadas++] = finUs - finVueltaServidorUs;
+    }
+}
+
+// Imprime p50/p99 de los pedidos desde el último reporte y reinicia
+void reportarPasadas(const char *etiqueta) {
+    if (numPasadas == 0) return;
+    std::sort(pasadasUs, pasadasUs + numPasadas);
+    uint32_t p50 = pasadasUs[numPasadas / 2];
+    uint32_t p99 = pasadasUs[(numPasadas * 99) / 100];
+    REG_INFO("%s: %d pedidos, pasada del servidor p50 %u us, p99 %u us", etiqueta, numPasadas, (unsigned)p50, (unsigned)p99);
+    numPasadas = 0;
+}
+
+void registrarRuta(const char *uri, HTTPMethod metodo, void (*handler)()) {
+    server.on(uri, metodo, [handler]() {
+        uint32_t inicio = micros();
+        TRAZAR_INICIO(TRAZA_PEDIDO_HTTP);
+        handler();
+        TRAZAR_FIN(TRAZA_PEDIDO_HTTP);
+        uint32_t fin = micros();
+        registrarPasada(fin);
+        metricas.pedidoHttp.observar(fin - inicio);
+    });
+}
+
+// --- Rutas del servidor web ---
+void registrarRutas() {
+    static const char *cabeceras[] = {"If-None-Match"};
+    server.collectHeaders(cabeceras, 1);
+    registrarRuta("/", HTTP_ANY, handleRoot);
+    registrarRuta("/get-data", HTTP_ANY, handleGetData);
+    registrarRuta("/get-data.bin", HTTP_ANY, handleGetDataBin);
+    registrarRuta("/wifi", HTTP_POST, handleWifi);
+    registrarRuta("/radar", HTTP_ANY, handleRadar);
+    registrarRuta("/metrics", HTTP_GET, handleMetricas);
+    registrarRuta("/traza.bin", HTTP_GET, handleTraza);
+}
+
+// Último estado informado por vigilarConexionWiFi()
+bool wifiConectado = false;
+
 // --- Intenta conectar a la última red guardada ---
 bool conectarUltimaRed() {
     String ssid = leerStringDeEEPROM(0);
@@ -336,33 +378,44 @@ bool conectarUltimaRed() {
 void iniciarAP(const char* apSsid, const char* apPassword) {
     WiFi.mode(WIFI_AP);
     WiFi.softAP(apSsid, apPassword);
-    server.on("/", handleRoot);
-    server.on("/get-data", handleGetData);
-    server.on("/wifi", HTTP_POST, handleWifi);
+    registrarRutas();
     server.begin();
-    Serial.println("Servidor web iniciado en modo AP.");
+    REG_INFO("Servidor web iniciado en modo AP.");
 }
 
 // --- Lógica principal de conexión WiFi ---
 void iniciarConexionWiFi(const char* apSsid, const char* apPassword) {
     EEPROM.begin(512);
+    idArranque = esp_random();
     if (conectarUltimaRed()) {
-        Serial.println("Conectado a la red guardada.");
-        Serial.print("IP: ");
-        Serial.println(WiFi.localIP());
-        server.on("/", handleRoot);
-        server.on("/get-data", handleGetData);
-        server.on("/wifi", HTTP_POST, handleWifi);
+        wifiConectado = true;
+        REG_INFO("Conectado a la red guardada.");
+        REG_INFO("IP: %s", WiFi.localIP().toString().c_str());
+        registrarRutas();
         server.begin();
     } else {
-        Serial.println("No se pudo conectar. Iniciando Access Point para registrar nueva red.");
+        REG_INFO("No se pudo conectar. Iniciando Access Point para registrar nueva red.");
         iniciarAP(apSsid, apPassword);
     }
 }
 
+// --- Avisa solo cuando cambia el estado de la conexión, una vez por ciclo ---
+// En modo AP nunca hubo conexión y no se avisa nada
+void vigilarConexionWiFi() {
+    bool ahora = WiFi.status() == WL_CONNECTED;
+    if (ahora == wifiConectado) return;
+    wifiConectado = ahora;
+    if (ahora) {
+        REG_INFO("WiFi reconectado. IP: %s", WiFi.localIP().toString().c_str());
+    } else {
+        REG_AVISO("WiFi desconectado");
+    }
+}
+
 // --- Loop para servidor web ---
 void loopServidorWeb() {
     server.handleClient();
+    finVueltaServidorUs = micros();
 }
 
 #endif // AP_WIFI_EEPROM_MODE_H
\ No newline at end of file
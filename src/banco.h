@@ -0,0 +1,361 @@
+#ifndef BANCO_H
+#define BANCO_H
+
+#include <Arduino.h>
+#include <new>
+#include <stdio.h>
+#include <string.h>
+#include "hal.h"
+#include "anillospsc.h"
+#include "apwifieeprommode.h"
+#include "escritorchunked.h"
+#include "estadorobot.h"
+#include "lectorvl53l0x.h"
+#include "mapaocupacion.h"
+#include "tramabinaria.h"
+#include "traza.h"
+#include "trigonometria.h"
+
+// Banco de rendimiento de los caminos calientes ([env:banco] en la PC,
+// [env:banco_esp32] en el robot). Con BANCO_RENDIMIENTO, setup() llama a
+// correrBanco() antes de iniciar nada: mide cada caso y deja el robot
+// detenido (en la PC termina el programa).
+//
+// Casos, cada uno con 100, 500, 10000 y 100000 puntos:
+//  - ingesta: una muestra del lector al mapa (ángulo del haz, pose
+//    interpolada, anillo y drenarMuestras(): transformación y mapa)
+//  - transformacion: rayo a coordenadas absolutas (polarACartesiano)
+//  - mapa: integrarRayo() en la grilla
+//  - traza: un evento de traza.h (la mitad inicio, la mitad fin)
+//  - direccion: buscarDireccion() con una muestra del giro de escaneo
+//  - json, binario: /get-data y /get-data.bin completos con ese número de
+//    celdas ocupadas, armando los chunks HTTP como el servidor pero sin red
+//  - json_incremental: /get-data con el cursor de un tablero que ya tenía
+//    ese mapa, después de RAYOS_INCREMENTAL_BANCO rayos nuevos
+//  - http: el handler real de /get-data atendido por el WebServer (solo en
+//    la PC, donde los pedidos se inyectan sin socket)
+// El mapa tiene 160 x 160 celdas: los casos de serialización con más
+// celdas que esas se informan como omitidos.
+//
+// Cada resultado es una línea JSON por Serial, para comparar corridas con
+// tools/comparar_banco.py. Los tiempos salen de halCiclos(): ciclos de CPU
+// en el ESP32, reloj del sistema en la PC.
+
+// Variables externas
+extern MapaRobot mapa;
+extern AnilloSPSC<MuestraRango, 128> anilloMuestras;
+void drenarMuestras();
+void buscarDireccion(const MuestraRango &muestra);
+
+#define MUESTRAS_BANCO 256          // Muestras distintas, se repiten en orden
+#define REPETICIONES_MINIMAS_BANCO 3
+#define REPETICIONES_MAXIMAS_BANCO 50
+#define CICLOS_OBJETIVO_BANCO_US 200000 // Se repite cada caso hasta cubrir esto
+// Rayos entre dos pedidos del tablero: 1,5 s de escaneo a 30 muestras/s
+#define RAYOS_INCREMENTAL_BANCO 45
+
+const uint32_t puntosBanco[] = {100, 500, 10000, 100000};
+
+MuestraRango muestrasBanco[MUESTRAS_BANCO];
+int32_t pasosBanco[MUESTRAS_BANCO];
+
+// Destino de EscritorChunked que arma cada chunk como el WebServer del core
+// (tamaño en hex, datos y CRLF) en un buffer del tamaño de un segmento TCP
+class DestinoBanco {
+public:
+    void setContentLength(size_t longitud) { (void)longitud; }
+    void send(int codigo, const char *tipo, const char *contenido) {
+        (void)codigo;
+        (void)tipo;
+        (void)contenido;
+        bytes = 0;
+    }
+    void sendContent(const char *datos, size_t longitud) {
+        char tamano[12];
+        int n = snprintf(tamano, sizeof(tamano), "%x\r\n", (unsigned)longitud);
+        copiar(tamano, n);
+        copiar(datos, longitud);
+        copiar("\r\n", 2);
+    }
+    void sendContent(const char *texto) { sendContent(texto, strlen(texto)); }
+
+    size_t bytes = 0;
+
+private:
+    char segmento[1460];
+    size_t usado = 0;
+
+    void copiar(const char *datos, size_t longitud) {
+        while (longitud > 0) {
+            size_t parte = longitud < sizeof(segmento) - usado ? longitud : sizeof(segmento) - usado;
+            memcpy(segmento + usado, datos, parte);
+            usado = (usado + parte) % sizeof(segmento);
+            datos += parte;
+            longitud -= parte;
+            bytes += parte;
+        }
+    }
+};
+
+DestinoBanco destinoBanco;
+
+// xorshift32: las mismas muestras en cada corrida y en cada plataforma
+uint32_t azarBanco = 12345;
+uint32_t siguienteAzarBanco() {
+    azarBanco ^= azarBanco << 13;
+    azarBanco ^= azarBanco >> 17;
+    azarBanco ^= azarBanco << 5;
+    return azarBanco;
+}
+
+// Mapa vacío sin pasar uno de 28 KB por la pila
+void vaciarMapaBanco() {
+    new (&mapa) MapaRobot();
+    numPuntos = 0;
+}
+
+// Mapa con "celdas" ocupadas, repartidas por toda la grilla
+void llenarMapaBanco(uint32_t celdas) {
+    vaciarMapaBanco();
+    const uint32_t total = MAPA_CELDAS * MAPA_CELDAS;
+    for (uint32_t i = 0; i < celdas; i++) {
+        // Paso coprimo con el total: recorre celdas distintas
+        uint32_t celda = (i * 7919) % total;
+        int32_t x = MapaRobot::centroX(celda % MAPA_CELDAS);
+        int32_t y = MapaRobot::centroY(celda / MAPA_CELDAS);
+        while (!mapa.ocupadaEn(x, y)) mapa.integrarRayo(x, y, x, y, true);
+    }
+    numPuntos = mapa.totalOcupadas();
+}
+
+// Muestras con la forma de un escaneo: pasos del radar crecientes, distancias
+// de 100 a 2400 mm (las de más de 2000 fuera de rango) y poses dentro de ±2 m.
+// Registra poses cada 10 ms para que cada muestra interpole entre dos.
+void prepararMuestrasBanco() {
+    for (int i = 0; i < MUESTRAS_BANCO; i++) {
+        MuestraRango &m = muestrasBanco[i];
+        m.tiempoUs = 5000 + i * 33000;
+        m.distancia = 100 + siguienteAzarBanco() % 2300;
+        if (m.distancia > 2000) m.distancia = 8190;
+        m.calidad = 1000;
+        m.estado = m.distancia == 8190 ? 4 : 11;
+        m.angulo = 0;
+        pasosBanco[i] = i * 8;
+    }
+    posesRegistradas = 0;
+    for (uint32_t t = 0; t <= (MUESTRAS_BANCO + 1) * 33000; t += PERIODO_ODOMETRIA_MS * 1000) {
+        PoseRobot p = {(int32_t)(siguienteAzarBanco() % 4000000) - 2000000,
+                       (int32_t)(siguienteAzarBanco() % 4000000) - 2000000, (AnguloBinario)siguienteAzarBanco()};
+        registrarPose(t, p);
+    }
+}
+
+void informarCaso(const char *caso, uint32_t puntos, uint32_t repeticiones, uint64_t ciclos,
+                  uint32_t minimo, size_t bytes) {
+    double nsPorCiclo = 1000.0 / halCiclosPorUs();
+    double porPunto = (double)ciclos / repeticiones / puntos * nsPorCiclo;
+    double minimoPorPunto = (double)minimo / puntos * nsPorCiclo;
+    Serial.printf("{\"caso\":\"%s\",\"puntos\":%u,\"repeticiones\":%u,\"ns_por_punto\":%.1f,"
+                  "\"ns_minimo_por_punto\":%.1f,\"bytes\":%u,\"plataforma\":\"%s\"}\n",
+                  caso, (unsigned)puntos, (unsigned)repeticiones, porPunto, minimoPorPunto, (unsigned)bytes,
+#ifdef ENTORNO_NATIVO
+                  "nativo"
+#else
+                  "esp32"
+#endif
+    );
+}
+
+void informarOmitido(const char *caso, uint32_t puntos, const char *motivo) {
+    Serial.printf("{\"caso\":\"%s\",\"puntos\":%u,\"omitido\":\"%s\"}\n", caso, (unsigned)puntos, motivo);
+}
+
+// Corre "lote(puntos)" hasta cubrir el tiempo objetivo (entre el mínimo y el
+// máximo de repeticiones, más una de calentamiento) e informa. "preparar"
+// deja el estado igual antes de cada repetición y no se mide.
+template <typename Preparar, typename Lote>
+void medirCaso(const char *caso, uint32_t puntos, Preparar preparar, Lote lote) {
+    preparar();
+    size_t bytes = lote(puntos);
+    uint64_t objetivo = (uint64_t)CICLOS_OBJETIVO_BANCO_US * halCiclosPorUs();
+    uint64_t total = 0;
+    uint32_t minimo = UINT32_MAX;
+    uint32_t repeticiones = 0;
+    while (repeticiones < REPETICIONES_MINIMAS_BANCO ||
+           (total < objetivo && repeticiones < REPETICIONES_MAXIMAS_BANCO)) {
+        preparar();
+        uint32_t inicio = halCiclos();
+        lote(puntos);
+        uint32_t ciclos = halCiclos() - inicio;
+        total += ciclos;
+        if (ciclos < minimo) minimo = ciclos;
+        repeticiones++;
+    }
+    informarCaso(caso, puntos, repeticiones, total, minimo, bytes);
+    vTaskDelay(1); // Que corran las tareas del sistema entre casos
+}
+
+// Una muestra como la arma TaskLECTOR y como la lleva TaskMUESTRAS al anillo;
+// cada 64 se drena al mapa como hace TaskSERVIDOR
+size_t loteIngesta(uint32_t puntos) {
+    for (uint32_t i = 0; i < puntos; i++) {
+        uint32_t k = i % MUESTRAS_BANCO;
+        MuestraRango muestra = muestrasBanco[k];
+        uint32_t tiempo = muestra.tiempoUs + 16500;
+        uint32_t anterior = k > 0 ? tiempo - 33000 : 0;
+        muestra.angulo = anguloSensorEnPasos(pasosEnMitadDeVentana(anterior, pasosBanco[k > 0 ? k - 1 : 0], tiempo,
+                                                                   pasosBanco[k], 16500));
+        poseEnInstante(muestra.tiempoUs, muestra.pose);
+        anilloMuestras.insertar(muestra);
+        if ((i & 63) == 63) drenarMuestras();
+    }
+    drenarMuestras();
+    return 0;
+}
+
+volatile int32_t sumideroBanco; // Para que el compilador no descarte el cálculo
+
+size_t loteTransformacion(uint32_t puntos) {
+    int32_t suma = 0;
+    for (uint32_t i = 0; i < puntos; i++) {
+        const MuestraRango &m = muestrasBanco[i % MUESTRAS_BANCO];
+        AnguloBinario absoluto = (AnguloBinario)(pasosBanco[i % MUESTRAS_BANCO] * 32) + m.pose.angulo;
+        int32_t dx, dy;
+        polarACartesiano(m.distancia == 8190 ? 2000 : m.distancia, absoluto, dx, dy);
+        suma += mmDesdeMicras(m.pose.x) + dx + mmDesdeMicras(m.pose.y) + dy;
+    }
+    sumideroBanco = suma;
+    return 0;
+}
+
+// Rayos ya transformados: solo el recorrido de la grilla
+int32_t rayosBanco[MUESTRAS_BANCO][4];
+bool impactosBanco[MUESTRAS_BANCO];
+
+size_t loteMapa(uint32_t puntos) {
+    for (uint32_t i = 0; i < puntos; i++) {
+        const int32_t *r = rayosBanco[i % MUESTRAS_BANCO];
+        mapa.integrarRayo(r[0], r[1], r[2], r[3], impactosBanco[i % MUESTRAS_BANCO]);
+    }
+    return 0;
+}
+
+size_t loteTraza(uint32_t puntos) {
+    for (uint32_t i = 0; i < puntos; i++) {
+        trazar(TRAZA_MUESTRA, i & 1 ? FASE_FIN : FASE_INICIO, 0);
+    }
+    return 0;
+}
+
+size_t loteDireccion(uint32_t puntos) {
+    for (uint32_t i = 0; i < puntos; i++) {
+        buscarDireccion(muestrasBanco[i % MUESTRAS_BANCO]);
+    }
+    return 0;
+}
+
+size_t loteJson(uint32_t puntos) {
+    (void)puntos;
+    EscritorChunked<DestinoBanco> w(destinoBanco);
+    w.iniciar(200, "application/json");
+    serializarDatos(w, 0, 0);
+    w.terminar();
+    return destinoBanco.bytes;
+}
+
+size_t loteBinario(uint32_t puntos) {
+    (void)puntos;
+    EscritorChunked<DestinoBanco> w(destinoBanco);
+    w.iniciar(200, "application/octet-stream");
+    serializarTrama(w, 0, 0);
+    w.terminar();
+    return destinoBanco.bytes;
+}
+
+// Cursor del tablero antes de los rayos nuevos
+uint32_t cursorBanco = 0;
+
+// Los rayos que llegan entre dos pedidos; cada uno se ve en varias pasadas
+// del escaneo, así que se integra unas veces seguidas
+void avanzarMapaBanco() {
+    cursorBanco = mapa.secuencia();
+    for (int i = 0; i < RAYOS_INCREMENTAL_BANCO; i++) {
+        const int32_t *r = rayosBanco[i];
+        for (int j = 0; j < 4; j++) mapa.integrarRayo(r[0], r[1], r[2], r[3], impactosBanco[i]);
+    }
+}
+
+size_t loteJsonIncremental(uint32_t puntos) {
+    (void)puntos;
+    EscritorChunked<DestinoBanco> w(destinoBanco);
+    w.iniciar(200, "application/json");
+    serializarDatos(w, cursorBanco, idArranque);
+    w.terminar();
+    return destinoBanco.bytes;
+}
+
+#ifdef ENTORNO_NATIVO
+size_t loteHttp(uint32_t puntos) {
+    (void)puntos;
+    return server.atender("/get-data").cuerpo.size();
+}
+#endif
+
+void correrBanco() {
+    Serial.printf("{\"banco\":\"inicio\",\"ciclos_por_us\":%u}\n", (unsigned)halCiclosPorUs());
+    prepararMuestrasBanco();
+    for (int i = 0; i < MUESTRAS_BANCO; i++) {
+        const MuestraRango &m = muestrasBanco[i];
+        int32_t dx, dy;
+        impactosBanco[i] = m.distancia < 2000;
+        polarACartesiano(impactosBanco[i] ? m.distancia : 2000, (AnguloBinario)(i * 256) + m.pose.angulo, dx, dy);
+        rayosBanco[i][0] = mmDesdeMicras(m.pose.x);
+        rayosBanco[i][1] = mmDesdeMicras(m.pose.y);
+        rayosBanco[i][2] = rayosBanco[i][0] + dx;
+        rayosBanco[i][3] = rayosBanco[i][1] + dy;
+    }
+    for (int i = 0; i < MUESTRAS_BANCO; i++) {
+        poseEnInstante(muestrasBanco[i].tiempoUs, muestrasBanco[i].pose);
+    }
+#ifdef ENTORNO_NATIVO
+    server.on("/get-data", HTTP_GET, handleGetData);
+#endif
+
+    for (uint32_t puntos : puntosBanco) {
+        medirCaso("ingesta", puntos, vaciarMapaBanco, loteIngesta);
+        medirCaso("transformacion", puntos, [] {}, loteTransformacion);
+        medirCaso("mapa", puntos, vaciarMapaBanco, loteMapa);
+        medirCaso("traza", puntos, [] {}, loteTraza);
+        medirCaso("direccion", puntos, [] {}, loteDireccion);
+    }
+    for (uint32_t puntos : puntosBanco) {
+        if (puntos > MAPA_CELDAS * MAPA_CELDAS) {
+            informarOmitido("json", puntos, "mas puntos que celdas en el mapa");
+            informarOmitido("json_incremental", puntos, "mas puntos que celdas en el mapa");
+            informarOmitido("binario", puntos, "mas puntos que celdas en el mapa");
+            informarOmitido("http", puntos, "mas puntos que celdas en el mapa");
+            continue;
+        }
+        llenarMapaBanco(puntos);
+        medirCaso("json", puntos, [] {}, loteJson);
+        medirCaso("binario", puntos, [] {}, loteBinario);
+#ifdef ENTORNO_NATIVO
+        medirCaso("http", puntos, [] {}, loteHttp);
+#else
+        informarOmitido("http", puntos, "sin cliente HTTP en el robot");
+#endif
+        avanzarMapaBanco();
+        medirCaso("json_incremental", puntos, [] {}, loteJsonIncremental);
+    }
+    vaciarMapaBanco();
+    Serial.printf("{\"banco\":\"fin\"}\n");
+
+#ifdef ENTORNO_NATIVO
+    fflush(stdout);
+    _Exit(0);
+#else
+    for (;;) vTaskDelay(portMAX_DELAY);
+#endif
+}
+
+#endif // BANCO_H
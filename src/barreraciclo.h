@@ -0,0 +1,111 @@
+#ifndef BARRERA_CICLO_H
+#define BARRERA_CICLO_H
+
+#include <stdint.h>
+
+// Barrera de un ciclo con hasta 24 participantes. El coordinador abre el
+// ciclo, cada participante avisa una vez al terminar su parte y el
+// coordinador duerme hasta que avisaron todos o vence la espera. Si vence,
+// esperar() devuelve false e informa qué participantes faltan; sus avisos
+// tardíos siguen valiendo para ese ciclo hasta el próximo abrirCiclo().
+//
+// En el ESP32 y en el entorno nativo (FreeRTOS simulado) usa un event group.
+// Fuera de los dos, o definiendo BARRERA_CON_PTHREAD antes de incluirlo, usa
+// pthread, para probar la coordinación sola en la PC con hilos de verdad.
+
+#if (defined(ESP_PLATFORM) || defined(ENTORNO_NATIVO)) && !defined(BARRERA_CON_PTHREAD)
+#define BARRERA_CON_FREERTOS
+#endif
+
+#ifdef BARRERA_CON_FREERTOS
+#include <freertos/FreeRTOS.h>
+#include <freertos/event_groups.h>
+#else
+#include <pthread.h>
+#include <errno.h>
+#include <time.h>
+#endif
+
+class BarreraCiclo {
+public:
+    explicit BarreraCiclo(uint8_t participantes)
+        : todos(participantes >= 24 ? 0xFFFFFFu : (1u << participantes) - 1) {}
+
+    // Reserva el event group; llamar una vez, antes de usar la barrera
+    bool iniciar() {
+#ifdef BARRERA_CON_FREERTOS
+        grupo = xEventGroupCreate();
+        return grupo != NULL;
+#else
+        // La espera se mide con el reloj monótono: un ajuste de la hora no la corta ni la estira
+        pthread_condattr_t atributos;
+        if (pthread_condattr_init(&atributos) != 0) return false;
+        bool listo = pthread_condattr_setclock(&atributos, CLOCK_MONOTONIC) == 0 &&
+                     pthread_mutex_init(&candado, NULL) == 0 && pthread_cond_init(&condicion, &atributos) == 0;
+        pthread_condattr_destroy(&atributos);
+        return listo;
+#endif
+    }
+
+    // Borra los avisos del ciclo anterior; antes de despertar a los participantes
+    void abrirCiclo() {
+#ifdef BARRERA_CON_FREERTOS
+        xEventGroupClearBits(grupo, todos);
+#else
+        pthread_mutex_lock(&candado);
+        bits = 0;
+        pthread_mutex_unlock(&candado);
+#endif
+    }
+
+    // Desde el participante (0..participantes-1) al terminar su parte
+    void avisar(uint8_t participante) {
+        uint32_t bit = (1u << participante) & todos;
+#ifdef BARRERA_CON_FREERTOS
+        xEventGroupSetBits(grupo, bit);
+#else
+        pthread_mutex_lock(&candado);
+        bits |= bit;
+        pthread_cond_broadcast(&condicion);
+        pthread_mutex_unlock(&candado);
+#endif
+    }
+
+    // true si avisaron todos dentro de "esperaMs". Si no, "faltantes" recibe
+    // un bit por cada participante que todavía no avisó.
+    bool esperar(uint32_t esperaMs, uint32_t *faltantes = NULL) {
+        uint32_t llegados;
+#ifdef BARRERA_CON_FREERTOS
+        llegados = xEventGroupWaitBits(grupo, todos, pdFALSE, pdTRUE, pdMS_TO_TICKS(esperaMs)) & todos;
+#else
+        timespec limite;
+        clock_gettime(CLOCK_MONOTONIC, &limite);
+        limite.tv_sec += esperaMs / 1000;
+        limite.tv_nsec += (long)(esperaMs % 1000) * 1000000L;
+        if (limite.tv_nsec >= 1000000000L) {
+            limite.tv_sec++;
+            limite.tv_nsec -= 1000000000L;
+        }
+        pthread_mutex_lock(&candado);
+        while (bits != todos) {
+            if (pthread_cond_timedwait(&condicion, &candado, &limite) == ETIMEDOUT) break;
+        }
+        llegados = bits;
+        pthread_mutex_unlock(&candado);
+#endif
+        if (faltantes != NULL) *faltantes = todos & ~llegados;
+        return llegados == todos;
+    }
+
+private:
+    const uint32_t todos;
+#ifdef BARRERA_CON_FREERTOS
+    EventGroupHandle_t grupo = NULL;
+#else
+    pthread_mutex_t candado;
+    pthread_cond_t condicion;
+    uint32_t bits = 0;
+#endif
+};
+
+#endif // BARRERA_CICLO_H
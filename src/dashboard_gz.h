@@ -0,0 +1,227 @@
+#ifndef DASHBOARD_GZ_H
+#define DASHBOARD_GZ_H
+
+// Generado por tools/generar_dashboard.py a partir de web/index.html. No editar.
+// Original: 10648 bytes, comprimido: 3392 bytes
+
+#include <Arduino.h>
+
+#define DASHBOARD_ETAG "\"239e9bccc661842d\""
+
+const size_t DASHBOARD_GZ_LEN = 3392;
+const uint8_t DASHBOARD_GZ[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xb5, 0x1a, 0xdb, 0x6e, 0xdb, 0x46,
+    0xf6, 0xdd, 0x5f, 0x31, 0x41, 0xb1, 0x25, 0x55, 0xeb, 0x42, 0xc9, 0x56, 0x2a, 0x48, 0x96, 0x0b,
+    0x37, 0x76, 0x77, 0xbb, 0x68, 0x5a, 0x23, 0x49, 0x77, 0x2b, 0x18, 0x7e, 0x18, 0x91, 0x43, 0x69,
+    0x12, 0x92, 0xa3, 0x92, 0x94, 0x6d, 0x35, 0xf5, 0x8f, 0xec, 0x5b, 0x3f, 0x60, 0x81, 0x05, 0xf6,
+    0x0f, 0x36, 0x3f, 0xb6, 0xe7, 0xcc, 0x85, 0x1c, 0x5e, 0x24, 0x27, 0x45, 0x0b, 0x27, 0x96, 0x38,
+    0x73, 0xee, 0xf7, 0x19, 0xfa, 0xec, 0xd9, 0xe5, 0x0f, 0x2f, 0xde, 0x2c, 0xae, 0xaf, 0xc8, 0x3a,
+    0x8f, 0xa3, 0xf3, 0xa3, 0x33, 0xf3, 0xc1, 0x68, 0x00, 0x1f, 0x31, 0xcb, 0x29, 0xf1, 0xd7, 0x34,
+    0xcd, 0x58, 0x3e, 0x77, 0x7e, 0x7c, 0xf3, 0x4d, 0x6f, 0xe2, 0xc0, 0x72, 0xce, 0xf3, 0x88, 0x9d,
+    0xbf, 0xa4, 0x1b, 0x4a, 0x5e, 0x89, 0xa5, 0xc8, 0xc9, 0xd5, 0xeb, 0xeb, 0x93, 0xd1, 0xd9, 0x40,
+    0xad, 0x1f, 0x9d, 0x65, 0xf9, 0x0e, 0x3f, 0x97, 0x22, 0xd8, 0x91, 0xf7, 0x24, 0x14, 0x49, 0xde,
+    0x0b, 0x69, 0xcc, 0xa3, 0xdd, 0x94, 0x5c, 0xa4, 0x9c, 0x46, 0x33, 0xb2, 0xa4, 0xfe, 0xbb, 0x55,
+    0x2a, 0xb6, 0x49, 0x30, 0x25, 0x9f, 0x79, 0x14, 0x7f, 0x66, 0xc4, 0x17, 0x91, 0x48, 0xe1, 0x99,
+    0x31, 0x36, 0x23, 0x39, 0x7b, 0xc8, 0x7b, 0x34, 0xe2, 0xab, 0x64, 0x4a, 0x7c, 0x96, 0xe4, 0x2c,
+    0x9d, 0x91, 0x0d, 0x0d, 0x02, 0x9e, 0xac, 0xa6, 0x64, 0xe4, 0x6d, 0x1e, 0x66, 0x24, 0xa6, 0xe9,
+    0x8a, 0xc3, 0xb6, 0x37, 0x23, 0x8f, 0x47, 0x7d, 0x1f, 0xd8, 0x50, 0x9e, 0xb0, 0x14, 0x58, 0xc6,
+    0xf4, 0xa1, 0x77, 0xcf, 0x83, 0x7c, 0x3d, 0x25, 0xc3, 0x91, 0x57, 0x05, 0x26, 0x74, 0x9b, 0x0b,
+    0x89, 0x81, 0x4a, 0x4a, 0xf0, 0x8a, 0x34, 0x43, 0x8a, 0x3f, 0x20, 0xa2, 0x48, 0x61, 0xb7, 0x97,
+    0xd2, 0x80, 0x6f, 0x33, 0xa0, 0x23, 0xa9, 0xb4, 0x4a, 0xd0, 0x03, 0x13, 0xe4, 0x22, 0x36, 0x8b,
+    0x8f, 0x47, 0xeb, 0x21, 0x10, 0x35, 0xda, 0x78, 0x5e, 0x18, 0x4e, 0x26, 0xb6, 0x00, 0x9e, 0x24,
+    0x86, 0x62, 0x4b, 0xd3, 0x64, 0xfc, 0x17, 0x06, 0xb8, 0xfd, 0x31, 0x8b, 0xa5, 0x58, 0x59, 0x4e,
+    0xf3, 0x6d, 0x06, 0x14, 0x02, 0x9e, 0x6d, 0x22, 0x0a, 0x46, 0xe3, 0x49, 0x04, 0x8a, 0xf5, 0x96,
+    0x91, 0xf0, 0xdf, 0x59, 0x32, 0x4c, 0x80, 0xc8, 0x70, 0x8c, 0x2c, 0x6b, 0xb2, 0x2a, 0x39, 0x24,
+    0xf1, 0x7b, 0xc6, 0x57, 0xeb, 0x7c, 0x0a, 0x10, 0x51, 0x50, 0xc8, 0x1b, 0xb1, 0x10, 0x96, 0x14,
+    0x2a, 0x30, 0x8c, 0xe9, 0xa6, 0x67, 0x5b, 0xef, 0xa3, 0xcc, 0x31, 0x6e, 0x31, 0xc7, 0x52, 0x3c,
+    0xf4, 0xb2, 0x35, 0x0d, 0xc4, 0x3d, 0xaa, 0x79, 0xaa, 0xc5, 0x23, 0xe9, 0x6a, 0x49, 0x5d, 0xaf,
+    0x2b, 0x7f, 0xfa, 0xe3, 0x0e, 0xf2, 0xfc, 0x0c, 0x78, 0xd2, 0x17, 0x34, 0xb9, 0xa3, 0x59, 0x9d,
+    0xa1, 0xe7, 0x79, 0x86, 0x1b, 0xd0, 0x05, 0xf4, 0x4c, 0x44, 0x3c, 0x28, 0xed, 0xd8, 0xea, 0x17,
+    0xd0, 0x82, 0x27, 0xa1, 0xe8, 0xad, 0x52, 0x00, 0xb5, 0x2c, 0x87, 0xcf, 0x33, 0xf9, 0xbb, 0x97,
+    0xb3, 0x18, 0xd6, 0x72, 0x06, 0xaa, 0x46, 0xdb, 0x38, 0x01, 0xd4, 0x94, 0x6d, 0x18, 0xcd, 0x5d,
+    0x8c, 0x87, 0x5e, 0xc8, 0xf3, 0x2e, 0x89, 0x79, 0x02, 0x91, 0xe3, 0x8e, 0xc6, 0x40, 0xb3, 0x4b,
+    0x86, 0x61, 0xda, 0x01, 0x61, 0x57, 0x74, 0x53, 0x73, 0x77, 0x2e, 0x36, 0xa5, 0xaf, 0x15, 0x5f,
+    0x9f, 0xa6, 0x41, 0x5d, 0x91, 0x11, 0xc5, 0x9f, 0xa7, 0x02, 0xa9, 0xf0, 0x82, 0xa4, 0x23, 0x33,
+    0xa8, 0x25, 0x78, 0xf6, 0xfb, 0xd2, 0xc4, 0x5e, 0xd5, 0x0e, 0x77, 0x34, 0xda, 0x32, 0x93, 0x7b,
+    0x2a, 0xc0, 0x86, 0xfd, 0x13, 0x0c, 0x30, 0x43, 0x39, 0x0c, 0x43, 0x09, 0x1e, 0xb1, 0x15, 0x4b,
+    0x2a, 0x36, 0x0b, 0x23, 0x06, 0x94, 0xde, 0x6e, 0xb3, 0x9c, 0x87, 0x3b, 0x19, 0x18, 0x90, 0x7e,
+    0x65, 0x12, 0x4a, 0x7b, 0x9c, 0x34, 0xec, 0xa1, 0xf4, 0x40, 0xdc, 0xde, 0x7d, 0x8a, 0x20, 0xf8,
+    0xdb, 0xe2, 0xd0, 0xe3, 0xe0, 0x80, 0x26, 0x1b, 0x99, 0xe1, 0x72, 0x2f, 0xab, 0xb1, 0x98, 0x68,
+    0x7d, 0x34, 0xba, 0x94, 0x1b, 0xf0, 0x4d, 0x5a, 0x4b, 0x76, 0x6b, 0x6d, 0x91, 0xd6, 0x2c, 0x18,
+    0x7b, 0x7f, 0x69, 0x0d, 0x24, 0xad, 0xf9, 0xd9, 0x40, 0x97, 0xa9, 0xb3, 0x81, 0xae, 0x76, 0x58,
+    0xaf, 0xe0, 0x23, 0xe0, 0x77, 0xc4, 0x8f, 0x68, 0x96, 0xcd, 0x9d, 0x22, 0x2b, 0xa0, 0xea, 0x11,
+    0x62, 0xef, 0xa8, 0xda, 0x21, 0x97, 0x61, 0x63, 0x3d, 0x54, 0xd5, 0x30, 0x60, 0x11, 0xb9, 0x4a,
+    0x72, 0x91, 0x26, 0x02, 0xa8, 0x0e, 0xf5, 0x6e, 0xb6, 0xa1, 0x89, 0xc1, 0x53, 0xc9, 0xed, 0x10,
+    0x1e, 0x94, 0xdf, 0xa5, 0x1c, 0x73, 0xa7, 0x1a, 0x3c, 0x13, 0xfa, 0xe5, 0xe9, 0x78, 0xe6, 0x9c,
+    0x03, 0x3d, 0x12, 0x7d, 0xf8, 0x77, 0xc2, 0x28, 0x08, 0x0c, 0x84, 0xa4, 0x20, 0x03, 0x90, 0xe4,
+    0xfc, 0xa8, 0x26, 0x52, 0x25, 0x8d, 0x8d, 0x64, 0xbe, 0xca, 0x31, 0x64, 0x57, 0xa6, 0x9c, 0xa3,
+    0xac, 0x38, 0x77, 0x9e, 0x7b, 0x9e, 0xa3, 0x8d, 0xa8, 0x1e, 0xce, 0xcf, 0x06, 0x0a, 0x43, 0xa3,
+    0x5b, 0xe4, 0x95, 0x1f, 0x34, 0xdd, 0xb6, 0x2d, 0xe9, 0x45, 0xa0, 0xd0, 0xdc, 0x90, 0xbe, 0x6b,
+    0xd7, 0x13, 0x03, 0x1c, 0x12, 0x1e, 0x19, 0xa3, 0x4e, 0xd2, 0x56, 0xe7, 0xb2, 0xa9, 0x68, 0x75,
+    0xb5, 0xae, 0x7f, 0x28, 0x53, 0x64, 0x79, 0x5a, 0x67, 0xfa, 0xc3, 0x32, 0xcb, 0x3f, 0xfc, 0xe6,
+    0x6f, 0x23, 0x91, 0xfd, 0x89, 0xac, 0x3d, 0x6f, 0x32, 0x81, 0xf8, 0xab, 0xb2, 0x7e, 0x93, 0xd2,
+    0x1d, 0xf3, 0x21, 0x6c, 0x38, 0xfd, 0x53, 0xb5, 0xa6, 0xb4, 0x61, 0xea, 0x4b, 0x9e, 0x32, 0xdf,
+    0xe7, 0x1f, 0xfe, 0x9b, 0x34, 0x39, 0x17, 0x5f, 0xdb, 0xe3, 0xad, 0x28, 0xb8, 0x4e, 0x33, 0x58,
+    0x8a, 0xa2, 0xd8, 0x1a, 0x2f, 0x65, 0xa9, 0x83, 0xf8, 0xfe, 0xf0, 0xaf, 0x28, 0xe7, 0xb1, 0x20,
+    0x57, 0x19, 0x44, 0x1e, 0x13, 0x7b, 0x35, 0x2f, 0xeb, 0x9a, 0xa3, 0x64, 0x97, 0x41, 0xbd, 0x95,
+    0xc8, 0x17, 0xc9, 0x0a, 0xfc, 0xe6, 0x9c, 0xf7, 0xb4, 0x12, 0xff, 0xfb, 0x0f, 0xe9, 0x91, 0x1a,
+    0x10, 0xbd, 0xe4, 0x90, 0x70, 0x89, 0xcf, 0x69, 0x09, 0x47, 0xe2, 0xb8, 0x4d, 0xdf, 0xdf, 0xad,
+    0x8b, 0x15, 0x43, 0xe4, 0x92, 0xe5, 0xe0, 0x53, 0x68, 0x86, 0xd9, 0x27, 0xaa, 0x94, 0x6c, 0xe3,
+    0xeb, 0x2d, 0x14, 0x91, 0xac, 0x94, 0xf3, 0x8f, 0x14, 0xf2, 0x5a, 0x64, 0x5c, 0x3a, 0x9c, 0xe8,
+    0x34, 0xfb, 0x08, 0xe1, 0x7e, 0x9a, 0x5a, 0xd6, 0x4c, 0x11, 0xed, 0xa7, 0x7d, 0x46, 0xdc, 0x4f,
+    0x64, 0xd1, 0x20, 0xb2, 0xf8, 0x13, 0x3d, 0x91, 0x72, 0x68, 0x26, 0x54, 0x47, 0xf6, 0x27, 0xd9,
+    0x5f, 0x8a, 0xd6, 0x8c, 0xa8, 0x03, 0x89, 0x61, 0xf2, 0xe3, 0x2c, 0xf3, 0x53, 0xbe, 0xc9, 0xcf,
+    0x8f, 0x06, 0x03, 0x72, 0xfd, 0xe1, 0x37, 0xe8, 0x8d, 0x94, 0x30, 0x8c, 0x88, 0x9c, 0xfb, 0x74,
+    0x4a, 0x72, 0x11, 0x08, 0x02, 0x1d, 0x02, 0x96, 0x20, 0x2c, 0x64, 0xb3, 0x90, 0xbc, 0x48, 0x04,
+    0xc9, 0x4b, 0xc9, 0x06, 0xfa, 0xdb, 0x60, 0xc5, 0xf2, 0x5e, 0x40, 0x73, 0x7a, 0x14, 0xb1, 0x9c,
+    0xe8, 0xe2, 0x3d, 0x27, 0x81, 0xf0, 0xb7, 0x31, 0xe8, 0xd3, 0x87, 0xed, 0xab, 0x88, 0xe1, 0xd7,
+    0xaf, 0x77, 0xdf, 0x06, 0xae, 0x5d, 0xd3, 0x3b, 0x33, 0x85, 0x93, 0x3f, 0x00, 0x82, 0xc2, 0x44,
+    0xf0, 0x17, 0xd8, 0xbf, 0x1f, 0x72, 0xd7, 0x19, 0x05, 0x05, 0x88, 0xdc, 0x7c, 0x0d, 0x53, 0x41,
+    0x09, 0x29, 0x1b, 0x82, 0xda, 0x56, 0x29, 0xf5, 0xbd, 0x89, 0x42, 0x80, 0xf1, 0xd4, 0x46, 0x5e,
+    0x96, 0x29, 0x35, 0xf6, 0xcf, 0xc9, 0xcd, 0xad, 0xda, 0x62, 0x90, 0xbc, 0x11, 0xbd, 0xe6, 0x0f,
+    0x2c, 0xba, 0x16, 0xe9, 0xcb, 0x97, 0x88, 0xd4, 0x1f, 0x8e, 0x67, 0x04, 0x2c, 0x71, 0x25, 0xf7,
+    0xa6, 0x72, 0x81, 0x6c, 0x10, 0x24, 0x93, 0xba, 0xc6, 0xb1, 0x44, 0x15, 0x61, 0x08, 0xa7, 0x8b,
+    0x9f, 0x10, 0xa3, 0xab, 0x1f, 0x16, 0x92, 0x27, 0xe2, 0x5e, 0xd3, 0x94, 0xca, 0xb1, 0x20, 0xa5,
+    0x29, 0x9a, 0x2e, 0x96, 0x5d, 0x96, 0x27, 0x1f, 0x7e, 0x8b, 0xc1, 0xa4, 0x68, 0x07, 0x76, 0x84,
+    0xd6, 0x7e, 0x21, 0x36, 0x9c, 0x12, 0x98, 0x8f, 0x69, 0x24, 0xed, 0x8a, 0x70, 0x53, 0x44, 0xc8,
+    0x58, 0x7a, 0xc7, 0x03, 0xe0, 0x06, 0xcd, 0x5f, 0xc0, 0x72, 0x12, 0x20, 0x18, 0xf9, 0x19, 0xa6,
+    0x23, 0xc0, 0x5f, 0x42, 0x78, 0x00, 0x7c, 0x16, 0x30, 0xe2, 0x64, 0xec, 0x67, 0x47, 0x09, 0x04,
+    0x49, 0x4c, 0x55, 0x0e, 0xcf, 0x49, 0xc2, 0xee, 0x09, 0xb4, 0x76, 0x57, 0x9b, 0x0e, 0x80, 0x94,
+    0xa0, 0x34, 0x4d, 0x69, 0x82, 0x54, 0xa4, 0x75, 0x94, 0x08, 0xc9, 0x1d, 0x67, 0x69, 0x0e, 0x84,
+    0x05, 0x0e, 0x1d, 0x09, 0x0d, 0xc0, 0x77, 0x52, 0x18, 0xa8, 0xbf, 0x82, 0xb8, 0x71, 0xdc, 0x21,
+    0x54, 0x19, 0x80, 0xa9, 0x0d, 0x65, 0xfb, 0xa3, 0x70, 0x9b, 0xf8, 0x39, 0x17, 0x89, 0x02, 0xbc,
+    0x50, 0xfe, 0x74, 0x61, 0x02, 0xdd, 0x75, 0xc8, 0x7b, 0x88, 0xb2, 0x94, 0xe5, 0xdb, 0x34, 0x91,
+    0x5f, 0x09, 0x79, 0x98, 0x12, 0xd7, 0x72, 0xe0, 0x80, 0x8c, 0x3a, 0xe4, 0x98, 0xb8, 0x0f, 0xe4,
+    0x8b, 0x86, 0x13, 0x70, 0x43, 0x5b, 0xb7, 0x2b, 0x71, 0x77, 0x2d, 0xb8, 0x3d, 0xe2, 0xee, 0x0e,
+    0xe2, 0x2e, 0xd0, 0x0f, 0x0b, 0x38, 0x83, 0xdc, 0x81, 0x72, 0x1c, 0xcc, 0xb7, 0x41, 0x9f, 0xa0,
+    0xea, 0x60, 0x03, 0xbe, 0xa4, 0x60, 0x13, 0x8c, 0xdd, 0x8c, 0xe7, 0xfc, 0x4e, 0x00, 0x9b, 0xc7,
+    0xd9, 0xd1, 0xa3, 0x34, 0xc8, 0x5f, 0x53, 0x1e, 0x45, 0xe0, 0x3d, 0x61, 0x06, 0x98, 0x0c, 0x14,
+    0x06, 0xfc, 0xb1, 0xe7, 0xa1, 0xef, 0x0b, 0xad, 0x03, 0xbe, 0xdc, 0xbe, 0xa5, 0xa9, 0x02, 0x77,
+    0x95, 0xca, 0x10, 0xc5, 0x70, 0x0e, 0x4a, 0xc5, 0x3b, 0xf6, 0x1a, 0x3b, 0x19, 0x58, 0xd9, 0xf9,
+    0xec, 0xe4, 0xe4, 0xc4, 0x99, 0xe9, 0x3d, 0x3c, 0x0f, 0xfd, 0x13, 0x43, 0x16, 0x76, 0x86, 0xb8,
+    0x88, 0xce, 0xc1, 0x5e, 0xa4, 0xa3, 0x1a, 0x79, 0x34, 0x95, 0x42, 0xc0, 0x50, 0xa4, 0x2e, 0x02,
+    0x73, 0x80, 0xea, 0x95, 0xc6, 0x98, 0xc1, 0xc2, 0xd9, 0xdc, 0x4e, 0x8d, 0x2f, 0xc8, 0x08, 0x17,
+    0x8f, 0xe7, 0x05, 0xdd, 0x8e, 0x76, 0x01, 0x0a, 0xb0, 0x64, 0x90, 0xdd, 0xd7, 0x34, 0x5f, 0x63,
+    0x64, 0x98, 0xc5, 0x58, 0xdc, 0xb1, 0x37, 0xc2, 0xe5, 0x96, 0xdd, 0x89, 0x67, 0xed, 0xa3, 0xd4,
+    0xf5, 0xfd, 0x92, 0xa3, 0x05, 0xa8, 0x54, 0xb7, 0x49, 0x1f, 0xe2, 0x07, 0xe1, 0x58, 0x92, 0x5c,
+    0x34, 0xf9, 0x95, 0x2c, 0xf6, 0x01, 0xda, 0xfc, 0x1e, 0xe1, 0x3f, 0x66, 0xed, 0x5b, 0x08, 0xd2,
+    0x4d, 0xca, 0xa1, 0x61, 0x6e, 0x28, 0x04, 0xec, 0x1e, 0xa7, 0x8c, 0xc7, 0xe3, 0x56, 0xa7, 0x8c,
+    0xcc, 0x62, 0x4d, 0x70, 0x4b, 0xec, 0x52, 0xac, 0xc1, 0xa8, 0x69, 0xb1, 0x56, 0xf9, 0xab, 0x80,
+    0x35, 0xd3, 0xd5, 0x15, 0x39, 0xcc, 0xdd, 0xb3, 0xf1, 0x2d, 0xba, 0x8b, 0xfd, 0xdc, 0x9f, 0xc4,
+    0x28, 0xb9, 0x43, 0x06, 0xd4, 0xe3, 0x1b, 0x0f, 0x08, 0xae, 0xea, 0x9d, 0x5d, 0x55, 0xf7, 0x17,
+    0xfa, 0x53, 0xf5, 0x9a, 0xae, 0x55, 0x78, 0xca, 0x24, 0xf0, 0x23, 0x46, 0xd3, 0x57, 0x50, 0x75,
+    0x51, 0xe0, 0x8a, 0xcc, 0x0d, 0xfd, 0x6b, 0x79, 0x64, 0xb2, 0x02, 0x52, 0xd3, 0x54, 0xeb, 0x4a,
+    0x7d, 0xa9, 0x8a, 0x02, 0xe0, 0xca, 0xef, 0xd6, 0x2c, 0x5a, 0x76, 0x28, 0xd8, 0xe2, 0xa1, 0x5b,
+    0xaf, 0xff, 0x70, 0x34, 0x4b, 0x56, 0xe0, 0xed, 0x73, 0x32, 0xb4, 0x53, 0xa3, 0x1e, 0x22, 0x6a,
+    0xe4, 0x75, 0xaa, 0x61, 0x69, 0xe2, 0xe4, 0xe4, 0x40, 0x88, 0x4b, 0xe9, 0x53, 0x1e, 0xb3, 0x54,
+    0x76, 0xa2, 0xba, 0x02, 0x75, 0x71, 0x6e, 0xbc, 0xdb, 0x3e, 0x14, 0xcd, 0xb6, 0xe5, 0x5d, 0x33,
+    0x69, 0x2c, 0xc2, 0x88, 0x65, 0x3f, 0x1a, 0x68, 0xbb, 0x54, 0x0c, 0x65, 0x81, 0x20, 0x7b, 0x4c,
+    0x00, 0x9b, 0xc7, 0xc7, 0xc6, 0x06, 0x5a, 0xf0, 0x8f, 0x12, 0x99, 0xb7, 0x8b, 0xcc, 0x4b, 0x91,
+    0x2b, 0xb1, 0xb8, 0x29, 0xc4, 0xad, 0x08, 0xfa, 0xb8, 0x27, 0x91, 0x95, 0x47, 0xad, 0xa1, 0x14,
+    0x16, 0xca, 0x20, 0xeb, 0x83, 0x7e, 0x57, 0xd4, 0x5f, 0xbb, 0xc5, 0x12, 0x99, 0x9f, 0x6b, 0x1d,
+    0x74, 0xe0, 0xd4, 0xe5, 0x2f, 0x20, 0x51, 0x86, 0xf2, 0x61, 0xf7, 0x54, 0xa1, 0xa2, 0xa9, 0xef,
+    0x02, 0x39, 0x29, 0x39, 0x7c, 0xec, 0xba, 0xe4, 0x54, 0x46, 0xf3, 0x08, 0xaa, 0xec, 0x4b, 0x80,
+    0xed, 0x5f, 0x7f, 0x6b, 0x41, 0x87, 0x10, 0xc0, 0x65, 0xf8, 0xa8, 0xc3, 0x9a, 0x53, 0xdd, 0x76,
+    0x1b, 0xc5, 0xcb, 0x46, 0x38, 0xf5, 0xbe, 0xf4, 0xf6, 0xc4, 0xdb, 0x68, 0x4f, 0xd1, 0x2b, 0xe2,
+    0x5f, 0xe5, 0x0a, 0x36, 0xad, 0x6c, 0x4b, 0x84, 0x35, 0x45, 0xee, 0xaf, 0x28, 0x5a, 0x3b, 0x15,
+    0x10, 0x4a, 0x45, 0xf5, 0x1d, 0xf4, 0x9c, 0xb4, 0xea, 0xd9, 0xd4, 0x52, 0x9d, 0x83, 0x1d, 0x7b,
+    0xd3, 0xad, 0xd5, 0x15, 0x1b, 0xd8, 0xf7, 0x2d, 0xe0, 0x46, 0x3e, 0x55, 0xb5, 0xd3, 0x75, 0x80,
+    0xca, 0x2a, 0xf3, 0x8a, 0x06, 0x00, 0x65, 0x95, 0x9d, 0x52, 0x32, 0x98, 0x07, 0x86, 0x13, 0xcf,
+    0x94, 0x8d, 0x30, 0x62, 0xfe, 0x9a, 0xe2, 0x58, 0x56, 0xaa, 0x06, 0x25, 0x4f, 0xc2, 0xfa, 0x22,
+    0x73, 0x0b, 0x72, 0x1d, 0xec, 0x94, 0x35, 0xb4, 0x85, 0x8d, 0xb6, 0x83, 0x19, 0x43, 0xa2, 0x65,
+    0x3c, 0x69, 0x43, 0x3b, 0x5c, 0xa7, 0xdb, 0x0d, 0x5b, 0x2f, 0xd2, 0x5a, 0xda, 0xae, 0xe1, 0xbf,
+    0xd7, 0x74, 0xea, 0x10, 0xdc, 0x6a, 0xba, 0xd3, 0x56, 0xd3, 0xe1, 0x10, 0x0a, 0xc9, 0x86, 0xc5,
+    0x50, 0x13, 0x3f, 0x2a, 0x13, 0x9c, 0x0e, 0xd1, 0x40, 0xc6, 0x54, 0xbd, 0x16, 0xeb, 0xc0, 0x22,
+    0xde, 0x79, 0x82, 0xb2, 0x93, 0x59, 0x05, 0x71, 0x51, 0x20, 0x2e, 0x8c, 0x59, 0x2b, 0xf6, 0xd9,
+    0x87, 0x38, 0x7a, 0x92, 0xe3, 0xf1, 0x1e, 0xc4, 0x27, 0x39, 0x56, 0x11, 0x0f, 0xbb, 0x65, 0xaf,
+    0xc1, 0xad, 0x4a, 0x05, 0xd6, 0xe9, 0x1a, 0x6d, 0x7f, 0x17, 0xfe, 0xc8, 0xe0, 0x8f, 0xf6, 0xf4,
+    0x58, 0x70, 0xce, 0xc5, 0x26, 0x82, 0x93, 0x00, 0xd9, 0x26, 0xe6, 0x58, 0x95, 0x32, 0x9f, 0x2f,
+    0x79, 0xe5, 0x7c, 0xe5, 0xe2, 0x71, 0x83, 0xdd, 0x31, 0xac, 0xc8, 0xa2, 0x7a, 0xce, 0xea, 0x90,
+    0x1d, 0x60, 0xa8, 0xd6, 0x59, 0xb6, 0x6c, 0x2a, 0x89, 0xa6, 0x97, 0x14, 0xce, 0x3f, 0xae, 0x02,
+    0xc3, 0xba, 0xb8, 0xf7, 0x18, 0x56, 0x1e, 0xd9, 0x3b, 0x7d, 0x3c, 0x6d, 0xbd, 0x50, 0x97, 0xa6,
+    0x78, 0x72, 0x03, 0xe4, 0x7e, 0xb1, 0x3d, 0x3b, 0x44, 0xa4, 0x72, 0x95, 0xd1, 0x4a, 0xc7, 0x86,
+    0x78, 0x9a, 0x94, 0x75, 0xe1, 0xb1, 0x9f, 0x5a, 0x09, 0x74, 0x90, 0xa0, 0x3e, 0xf3, 0xb7, 0xd2,
+    0x51, 0x7b, 0x4f, 0xa3, 0x2f, 0x0e, 0xa0, 0x2f, 0x9e, 0x46, 0x3f, 0x64, 0x18, 0x0b, 0xc0, 0x24,
+    0xed, 0x85, 0x9f, 0x6f, 0x69, 0xc4, 0x7f, 0x81, 0x73, 0xa3, 0xd5, 0x5e, 0x49, 0xc6, 0x49, 0x11,
+    0x16, 0x19, 0x23, 0x10, 0x8d, 0x50, 0xdb, 0x75, 0x9a, 0x28, 0x83, 0xa8, 0xfb, 0x11, 0x08, 0x82,
+    0x79, 0xb3, 0x2f, 0xef, 0x9b, 0x80, 0x7a, 0x64, 0x78, 0x3b, 0x53, 0x43, 0xd2, 0xb3, 0x1a, 0x95,
+    0x5f, 0x7f, 0x55, 0xa9, 0x46, 0x97, 0x99, 0x5b, 0xdd, 0x82, 0x7a, 0xda, 0xb3, 0x2d, 0xd8, 0xc1,
+    0x41, 0xca, 0x3b, 0x84, 0xb0, 0xab, 0x20, 0x2c, 0x14, 0x82, 0x19, 0x3b, 0x1a, 0xb2, 0x6d, 0xb6,
+    0xd9, 0xda, 0x7d, 0x0f, 0xe7, 0x45, 0x8b, 0x47, 0x17, 0xcf, 0x80, 0x16, 0x89, 0x47, 0xdd, 0x47,
+    0x0f, 0x4e, 0x77, 0x63, 0xe0, 0xd1, 0xd8, 0xcd, 0xd6, 0x3c, 0xcc, 0x21, 0x0d, 0xd1, 0xd6, 0xdf,
+    0xf1, 0x98, 0xe7, 0x55, 0x43, 0x5b, 0xf3, 0xc7, 0x05, 0x78, 0x75, 0x1b, 0xc1, 0x36, 0x9e, 0xa8,
+    0xe5, 0xa1, 0x1b, 0x3e, 0x5d, 0x4c, 0x54, 0xf9, 0x46, 0x46, 0x7a, 0x08, 0x6f, 0x46, 0x94, 0x6b,
+    0x8a, 0x03, 0x3b, 0x9e, 0xd5, 0xe1, 0x74, 0x6e, 0x0e, 0xfd, 0xbe, 0x00, 0x60, 0x96, 0x8b, 0x8e,
+    0x32, 0xb3, 0xd4, 0xa1, 0x58, 0xd3, 0x26, 0xb0, 0x66, 0x1b, 0x39, 0x37, 0x9b, 0x29, 0x41, 0x02,
+    0xb7, 0x0c, 0x3e, 0x3e, 0x0e, 0x3c, 0xd6, 0x3a, 0x0c, 0xf3, 0xae, 0x0f, 0xf3, 0x22, 0x54, 0x42,
+    0xa7, 0xeb, 0xc0, 0x6f, 0xff, 0x66, 0x78, 0xdb, 0x25, 0x68, 0x43, 0x5c, 0x96, 0xc6, 0xc3, 0xa5,
+    0xc7, 0x8e, 0x1a, 0x1a, 0x40, 0x38, 0x88, 0xa1, 0xf7, 0x25, 0x0f, 0xad, 0x5d, 0x95, 0x81, 0x99,
+    0x0a, 0x41, 0x6a, 0xff, 0x66, 0x74, 0xdb, 0xf9, 0x7d, 0x1c, 0xcd, 0x34, 0x28, 0x59, 0x5a, 0x14,
+    0xa0, 0xca, 0xb1, 0x9c, 0x35, 0x89, 0x98, 0xd1, 0xb0, 0x38, 0xd3, 0xa9, 0xab, 0x0b, 0x29, 0x26,
+    0x7c, 0xc5, 0x55, 0xeb, 0x0e, 0x43, 0x2e, 0x9b, 0x67, 0x99, 0x42, 0xf6, 0xa9, 0xa5, 0x12, 0x40,
+    0x56, 0xf4, 0x74, 0x1b, 0xd9, 0xd7, 0x25, 0x17, 0x40, 0x64, 0xd7, 0x0f, 0x53, 0x11, 0xbb, 0x96,
+    0x94, 0xf2, 0x92, 0x2d, 0x73, 0x3b, 0xca, 0x70, 0x7b, 0x13, 0x5d, 0xbf, 0x11, 0xe9, 0xf4, 0x79,
+    0x92, 0xb0, 0xf4, 0x6f, 0x6f, 0x5e, 0x7e, 0x87, 0x4d, 0xbb, 0x7c, 0x05, 0xe2, 0x7c, 0x1c, 0xb6,
+    0xbc, 0xfd, 0xee, 0x97, 0x97, 0xdf, 0xb2, 0xf3, 0xab, 0x37, 0x2a, 0xce, 0xcc, 0x8a, 0x9f, 0xa2,
+    0x2e, 0x93, 0x67, 0xf3, 0x79, 0xfd, 0xde, 0xcb, 0x04, 0x55, 0xf3, 0x3a, 0xac, 0x59, 0xd3, 0x09,
+    0x0e, 0x8c, 0x99, 0x00, 0xa6, 0x91, 0x58, 0xb9, 0xce, 0xf7, 0x5b, 0x76, 0x07, 0x90, 0xc2, 0xba,
+    0x0d, 0x0e, 0x8a, 0xdb, 0xe0, 0x29, 0x41, 0x17, 0x55, 0x69, 0x68, 0x27, 0xa9, 0x8e, 0x76, 0xc9,
+    0x7c, 0x11, 0xf0, 0x10, 0xbb, 0x5a, 0x44, 0x31, 0xa7, 0x62, 0x4a, 0x96, 0x3c, 0xa1, 0xea, 0x44,
+    0x56, 0xb6, 0xae, 0x3e, 0x2c, 0x12, 0x17, 0x42, 0x2d, 0x86, 0x36, 0x45, 0x18, 0x0c, 0xac, 0xa9,
+    0x3f, 0x90, 0xe0, 0x1a, 0xba, 0xbf, 0xee, 0x20, 0x3d, 0x0a, 0x19, 0xc4, 0xb3, 0x18, 0x5a, 0xdf,
+    0xf2, 0x2d, 0x24, 0x8b, 0xbc, 0xba, 0x51, 0x17, 0x61, 0x05, 0x29, 0xc4, 0xfe, 0xfb, 0xeb, 0x1f,
+    0xbe, 0xb7, 0x0e, 0xad, 0x85, 0x10, 0xe9, 0x1b, 0x24, 0xe9, 0x2e, 0xb7, 0x61, 0xc8, 0x52, 0x65,
+    0x14, 0x2c, 0x96, 0x77, 0xfa, 0x72, 0x0c, 0x7a, 0x24, 0xfd, 0x07, 0x67, 0xf7, 0x06, 0x40, 0xdb,
+    0xf7, 0x0e, 0xbd, 0xf3, 0x23, 0x4f, 0xf2, 0x89, 0x0b, 0xd5, 0x03, 0xcd, 0xeb, 0x3d, 0x9c, 0x5e,
+    0x62, 0x71, 0xb3, 0x76, 0x86, 0x66, 0x67, 0x3c, 0xaa, 0xed, 0x8c, 0xd4, 0x4e, 0x71, 0xae, 0xcc,
+    0xd7, 0xa9, 0xb8, 0x97, 0xfc, 0xae, 0xd2, 0x14, 0x8e, 0x65, 0x8e, 0x14, 0x0a, 0xaf, 0xee, 0xc0,
+    0xf0, 0xc2, 0xe7, 0x01, 0x75, 0x8a, 0x40, 0x97, 0x57, 0x9c, 0xba, 0x32, 0x80, 0x90, 0xb6, 0x28,
+    0x27, 0x1d, 0xf2, 0x39, 0x31, 0x5c, 0xcd, 0x74, 0x04, 0xe1, 0xb4, 0x91, 0x77, 0x75, 0xf3, 0x52,
+    0x82, 0xe1, 0x73, 0x77, 0x74, 0x8a, 0x07, 0xb3, 0x2d, 0x2b, 0x0e, 0xd2, 0x11, 0x5f, 0xa6, 0xac,
+    0x01, 0xf5, 0xbc, 0x06, 0x25, 0xcd, 0x39, 0x37, 0xc7, 0x61, 0x2d, 0xc6, 0xb4, 0xf8, 0xa6, 0x2e,
+    0xe2, 0x4c, 0xa6, 0x4d, 0x4b, 0x5a, 0x27, 0x23, 0xd7, 0x30, 0x54, 0x30, 0x90, 0xa4, 0xd5, 0xed,
+    0x49, 0x65, 0x5b, 0xa5, 0xa3, 0x86, 0xf8, 0x56, 0xca, 0x32, 0x1c, 0x35, 0x21, 0x16, 0x55, 0x88,
+    0xd3, 0x26, 0x84, 0x4a, 0xdc, 0x29, 0x39, 0x76, 0x6d, 0xbd, 0x86, 0x46, 0x2f, 0x18, 0x07, 0x4f,
+    0x9e, 0x7b, 0x70, 0x36, 0x78, 0x3e, 0x1e, 0x9f, 0x3c, 0x87, 0xee, 0x2b, 0xbe, 0xe1, 0x0f, 0x2c,
+    0x00, 0xdf, 0x75, 0xad, 0xf4, 0xd8, 0x43, 0x64, 0xf2, 0x29, 0x44, 0xca, 0x51, 0x64, 0x5a, 0x35,
+    0xb1, 0x57, 0x11, 0xba, 0x48, 0x9a, 0x1a, 0x54, 0x55, 0xf9, 0xb2, 0xf6, 0x4c, 0xc9, 0xcd, 0xad,
+    0x5a, 0xd3, 0xd5, 0x19, 0x17, 0xd4, 0x3d, 0xa5, 0xf6, 0x7f, 0x18, 0xe2, 0xc1, 0x70, 0x52, 0xbf,
+    0x1d, 0xf4, 0xd4, 0x91, 0xbf, 0x08, 0x8f, 0x63, 0x1d, 0x01, 0xf2, 0xb0, 0x2f, 0xaf, 0xaa, 0xf1,
+    0x72, 0xf0, 0xb4, 0x63, 0x1d, 0x99, 0x1f, 0x4c, 0x74, 0x28, 0x73, 0x03, 0x88, 0x11, 0x0a, 0xc6,
+    0xcc, 0xfa, 0x16, 0x10, 0x1c, 0x59, 0xc1, 0xa3, 0x1a, 0x44, 0xd1, 0xd1, 0xea, 0x3d, 0x4b, 0x76,
+    0xf3, 0x1b, 0xbc, 0x14, 0x36, 0xa5, 0x5d, 0x76, 0x82, 0x4a, 0xdb, 0x29, 0x61, 0xba, 0x55, 0xd1,
+    0xbf, 0x22, 0x43, 0x32, 0x25, 0xde, 0x6d, 0x91, 0x23, 0xfa, 0x4a, 0x19, 0xb1, 0xcd, 0x20, 0x7d,
+    0xcd, 0xa1, 0xb8, 0xd0, 0x62, 0x36, 0xc2, 0xeb, 0x72, 0xf8, 0x97, 0x60, 0x29, 0xb3, 0xaf, 0xc8,
+    0x89, 0x1b, 0x0b, 0x39, 0x5c, 0x03, 0x8d, 0x6c, 0x43, 0x23, 0xd9, 0xb8, 0x13, 0x3d, 0x5d, 0x67,
+    0x1d, 0x6b, 0x86, 0x2e, 0x06, 0x30, 0x35, 0x46, 0x2b, 0x3b, 0x85, 0x2c, 0x87, 0xbe, 0xe8, 0x54,
+    0x8a, 0xd8, 0x57, 0x40, 0xc0, 0x67, 0x73, 0x2c, 0x8b, 0xd8, 0xa4, 0xa0, 0x8b, 0x7d, 0x6e, 0x12,
+    0x44, 0x2e, 0x9a, 0x87, 0x8e, 0x54, 0xbb, 0x9f, 0xaf, 0x59, 0xe2, 0x22, 0x73, 0x28, 0xb9, 0x0c,
+    0x1b, 0xac, 0xf9, 0x2e, 0x1b, 0xd8, 0xee, 0x6b, 0x59, 0x87, 0xa0, 0xd5, 0x58, 0xd0, 0xaa, 0x36,
+    0x21, 0x6c, 0x75, 0xb2, 0xdf, 0x53, 0xe4, 0x0c, 0xae, 0x4f, 0x51, 0x58, 0x86, 0x15, 0xc7, 0x6e,
+    0xe4, 0x9f, 0xd8, 0xbe, 0x2e, 0x65, 0x91, 0x52, 0xd5, 0xdf, 0x99, 0x7d, 0x34, 0x8d, 0xd6, 0x26,
+    0x16, 0xf8, 0x27, 0x63, 0xdd, 0xc4, 0xec, 0xae, 0xc3, 0x54, 0x51, 0x94, 0xb5, 0x71, 0xea, 0x74,
+    0x89, 0x7c, 0xb6, 0x26, 0x00, 0xe5, 0xe1, 0x57, 0xda, 0x61, 0x53, 0x89, 0x07, 0x39, 0x07, 0x93,
+    0x97, 0xbc, 0x91, 0x1f, 0xf6, 0xc7, 0x60, 0xf9, 0x15, 0xde, 0xf4, 0x64, 0xfa, 0x45, 0x09, 0x97,
+    0xef, 0x5c, 0x32, 0x92, 0x08, 0xb2, 0xa6, 0x3b, 0x6a, 0xfc, 0x2b, 0x5f, 0x82, 0x70, 0xfc, 0x2b,
+    0x0d, 0xe8, 0xe8, 0xe2, 0x85, 0x26, 0x83, 0xad, 0x60, 0x1b, 0x45, 0xb3, 0xd2, 0xf9, 0x3c, 0x81,
+    0x89, 0x95, 0xa6, 0x06, 0x40, 0x3b, 0x1f, 0x02, 0xbc, 0x05, 0x77, 0xae, 0xb0, 0x4d, 0x1e, 0x35,
+    0xe2, 0x46, 0x27, 0x47, 0x0b, 0xd3, 0x4c, 0x66, 0x93, 0x5c, 0x76, 0x6b, 0x68, 0x5d, 0x32, 0x1c,
+    0x7b, 0x5e, 0xd1, 0x57, 0xad, 0xbe, 0x06, 0xe7, 0x06, 0xf6, 0x51, 0x82, 0x3d, 0xab, 0x09, 0x26,
+    0x47, 0xca, 0x82, 0x5f, 0x03, 0xfe, 0x80, 0x9c, 0xca, 0x38, 0x65, 0x87, 0xbf, 0x32, 0x59, 0x06,
+    0x03, 0x30, 0x0c, 0x59, 0xca, 0x09, 0x31, 0x0c, 0x48, 0x60, 0x72, 0x28, 0x14, 0xf2, 0x51, 0xe5,
+    0x34, 0xe6, 0xd9, 0x46, 0x64, 0x4c, 0x1e, 0x5a, 0x61, 0x14, 0xde, 0x6c, 0x59, 0x0a, 0x5d, 0x6d,
+    0x32, 0xec, 0xcb, 0x57, 0x4e, 0x12, 0x10, 0x62, 0xeb, 0x41, 0xbe, 0xcf, 0xc5, 0x5c, 0xa5, 0x48,
+    0x93, 0xb3, 0x5f, 0xd4, 0x7b, 0x97, 0xfa, 0xf0, 0xdc, 0x2f, 0x0d, 0xa1, 0x43, 0x32, 0xbd, 0x52,
+    0x8e, 0x2d, 0x0d, 0xf1, 0xec, 0x9e, 0x43, 0x1c, 0xdc, 0xf7, 0xe5, 0xc6, 0x6b, 0xb1, 0x4d, 0xfd,
+    0xe2, 0xc5, 0x47, 0xc3, 0xab, 0x4a, 0x65, 0x55, 0x4c, 0xec, 0xf6, 0xab, 0xa3, 0x45, 0x8f, 0x08,
+    0x16, 0x25, 0xd7, 0x59, 0xe7, 0xf9, 0x66, 0x3a, 0x18, 0x60, 0x5e, 0xe3, 0xeb, 0x3a, 0x94, 0xa5,
+    0xbf, 0x16, 0x59, 0x9e, 0xd0, 0x98, 0x61, 0xea, 0x4f, 0x27, 0xc3, 0x81, 0xea, 0xe5, 0x9a, 0x48,
+    0x1f, 0x1a, 0xfc, 0x86, 0xe1, 0x71, 0x0c, 0x64, 0x84, 0x2c, 0x6c, 0x78, 0xb0, 0x0a, 0x1b, 0xb3,
+    0x2c, 0xa3, 0x2b, 0x9c, 0x69, 0x59, 0x23, 0xdf, 0x71, 0xc4, 0xe9, 0x6f, 0xf0, 0xaf, 0x19, 0x5d,
+    0xd6, 0x97, 0xc7, 0xfa, 0x1a, 0xb2, 0x4e, 0x75, 0xcd, 0xa9, 0xa9, 0xae, 0x7c, 0x31, 0x52, 0x6a,
+    0x03, 0x9a, 0x73, 0x79, 0x0e, 0xa5, 0x32, 0x6b, 0xd0, 0xbb, 0xf6, 0xd8, 0xac, 0x6e, 0xec, 0xe1,
+    0xdf, 0x0d, 0x16, 0xde, 0x86, 0xc1, 0x67, 0xf8, 0x27, 0x48, 0xfa, 0x85, 0xf1, 0xd9, 0x40, 0xff,
+    0xf1, 0xd1, 0x40, 0xfd, 0x01, 0xe6, 0xff, 0x01, 0xe9, 0xe3, 0xd1, 0xbc, 0x98, 0x29, 0x00, 0x00,
+};
+
+#endif // DASHBOARD_GZ_H
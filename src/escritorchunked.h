@@ -0,0 +1,106 @@
+#ifndef ESCRITOR_CHUNKED_H
+#define ESCRITOR_CHUNKED_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+// Escribe una respuesta HTTP por partes (Transfer-Encoding: chunked) a
+// través de un buffer fijo en la pila. El texto se copia al buffer y cada
+// vez que se llena se envía, así que la respuesta nunca existe completa en
+// el heap: el consumo de memoria no depende del tamaño del mapa.
+//
+// Destino es el servidor web (setContentLength / send / sendContent).
+// Si se asigna medirHeap, se consulta en cada envío y queda el mínimo de
+// heap libre visto durante la respuesta.
+template <typename Destino, size_t TAMANO = 512>
+class EscritorChunked {
+public:
+    explicit EscritorChunked(Destino &destino) : destino(destino) {}
+
+    void iniciar(int codigo, const char *tipo) {
+        destino.setContentLength(CONTENT_LENGTH_UNKNOWN);
+        destino.send(codigo, tipo, "");
+    }
+
+    void agregar(const char *texto) {
+        agregar(texto, strlen(texto));
+    }
+
+    void agregar(const char *datos, size_t longitud) {
+        while (longitud > 0) {
+            size_t libre = TAMANO - usado;
+            size_t parte = longitud < libre ? longitud : libre;
+            memcpy(buffer + usado, datos, parte);
+            usado += parte;
+            datos += parte;
+            longitud -= parte;
+            if (usado == TAMANO) vaciar();
+        }
+    }
+
+    void agregar(char c) {
+        if (usado == TAMANO) vaciar();
+        buffer[usado++] = c;
+    }
+
+    void agregarEntero(long valor) {
+        char numero[12];
+        int n = snprintf(numero, sizeof(numero), "%ld", valor);
+        agregar(numero, n);
+    }
+
+    void agregarNatural(uint32_t valor) {
+        char numero[12];
+        int n = snprintf(numero, sizeof(numero), "%lu", (unsigned long)valor);
+        agregar(numero, n);
+    }
+
+    // Entero en punto fijo: agregarFijo(12345, 3) escribe 12.345
+    void agregarFijo(long valor, int decimales) {
+        long divisor = 1;
+        for (int i = 0; i < decimales; i++) divisor *= 10;
+        unsigned long absoluto = valor < 0 ? -(unsigned long)valor : valor;
+        char numero[24];
+        int n = snprintf(numero, sizeof(numero), "%s%lu.%0*lu", valor < 0 ? "-" : "",
+                         absoluto / divisor, decimales, absoluto % divisor);
+        agregar(numero, n);
+    }
+
+    void agregarDecimal(float valor, int decimales = 1) {
+        char numero[24];
+        int n = snprintf(numero, sizeof(numero), "%.*f", decimales, valor);
+        agregar(numero, n);
+    }
+
+    // Envía lo pendiente y el chunk vacío que cierra la respuesta
+    void terminar() {
+        vaciar();
+        destino.sendContent("");
+    }
+
+    size_t totalEnviado() const { return enviado; }
+
+    uint32_t (*medirHeap)() = nullptr;
+    uint32_t heapMinimo = UINT32_MAX;
+
+private:
+    Destino &destino;
+    char buffer[TAMANO];
+    size_t usado = 0;
+    size_t enviado = 0;
+
+    void vaciar() {
+        if (medirHeap) {
+            uint32_t libre = medirHeap();
+            if (libre < heapMinimo) heapMinimo = libre;
+        }
+        if (usado == 0) return;
+        destino.sendContent(buffer, usado);
+        enviado += usado;
+        usado = 0;
+    }
+};
+
+#endif // ESCRITOR_CHUNKED_H
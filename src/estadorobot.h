@@ -0,0 +1,108 @@
+#ifndef ESTADO_ROBOT_H
+#define ESTADO_ROBOT_H
+
+#include <Arduino.h>
+#include "trigonometria.h"
+
+// Posición del robot copiada en un instante dado. En punto fijo: la
+// odometría y el mapa trabajan con enteros y el rumbo da la vuelta solo.
+struct PoseRobot {
+    int32_t x;             // µm
+    int32_t y;             // µm
+    AnguloBinario angulo;  // 65536 = 360°, 0 = hacia adelante al arrancar
+};
+
+#define MICRAS_POR_MM 1000
+
+// µm a mm redondeado (también para negativos)
+inline int32_t mmDesdeMicras(int32_t micras) {
+    return micras >= 0 ? (micras + MICRAS_POR_MM / 2) / MICRAS_POR_MM
+                       : -((-micras + MICRAS_POR_MM / 2) / MICRAS_POR_MM);
+}
+
+// Grados en décimas, redondeado, en [0, 3600)
+inline int32_t decimasDeGrado(AnguloBinario angulo) {
+    return (int32_t)(((uint32_t)angulo * 3600 + 32768) >> 16) % 3600;
+}
+
+// Copia publicada de la pose. La escribe la odometría y la leen
+// el lector del sensor y el servidor web (en otra CPU); el spinlock evita
+// que un lector vea x de una pose e y de la siguiente.
+portMUX_TYPE candadoPose = portMUX_INITIALIZER_UNLOCKED;
+PoseRobot posePublicada = {0, 0, 0};
+
+PoseRobot instantaneaPose() {
+    portENTER_CRITICAL(&candadoPose);
+    PoseRobot pose = posePublicada;
+    portEXIT_CRITICAL(&candadoPose);
+    return pose;
+}
+
+// Historial de poses con su instante (micros) para ubicar cada muestra del
+// sensor en la pose que tenía el robot al tomarla, aunque se esté moviendo.
+// Lo llena la odometría a intervalos fijos; 128 entradas cubren más de un segundo.
+#define LONGITUD_HISTORIAL_POSES 128
+
+struct PoseFechada {
+    uint32_t tiempoUs;
+    PoseRobot pose;
+};
+
+PoseFechada historialPoses[LONGITUD_HISTORIAL_POSES];
+uint32_t posesRegistradas = 0;
+
+// Publica la pose y la agrega al historial
+void registrarPose(uint32_t tiempoUs, const PoseRobot &pose) {
+    portENTER_CRITICAL(&candadoPose);
+    posePublicada = pose;
+    historialPoses[posesRegistradas % LONGITUD_HISTORIAL_POSES] = {tiempoUs, pose};
+    posesRegistradas++;
+    portEXIT_CRITICAL(&candadoPose);
+}
+
+// Pose en el instante t, interpolada entre las dos registradas que lo rodean.
+// Devuelve false si todavía no se registró ninguna pose posterior a t.
+// Si t es anterior a todo el historial, devuelve la más vieja.
+bool poseEnInstante(uint32_t t, PoseRobot &pose) {
+    PoseFechada antes, despues;
+    bool hayAntes = false;
+    portENTER_CRITICAL(&candadoPose);
+    uint32_t n = posesRegistradas;
+    if (n == 0 || (int32_t)(historialPoses[(n - 1) % LONGITUD_HISTORIAL_POSES].tiempoUs - t) < 0) {
+        portEXIT_CRITICAL(&candadoPose);
+        return false;
+    }
+    // Las muestras suelen ser recientes: se busca desde la última hacia atrás
+    uint32_t primera = n > LONGITUD_HISTORIAL_POSES ? n - LONGITUD_HISTORIAL_POSES : 0;
+    uint32_t i = n - 1;
+    while (i > primera && (int32_t)(historialPoses[(i - 1) % LONGITUD_HISTORIAL_POSES].tiempoUs - t) >= 0) i--;
+    despues = historialPoses[i % LONGITUD_HISTORIAL_POSES];
+    if (i > primera) {
+        antes = historialPoses[(i - 1) % LONGITUD_HISTORIAL_POSES];
+        hayAntes = true;
+    }
+    portEXIT_CRITICAL(&candadoPose);
+
+    if (!hayAntes || despues.tiempoUs == antes.tiempoUs) {
+        pose = despues.pose;
+        return true;
+    }
+    // Fracción del intervalo en Q16
+    int64_t f = ((uint64_t)(t - antes.tiempoUs) << 16) / (despues.tiempoUs - antes.tiempoUs);
+    // La resta en 16 bits con signo ya es el giro por el lado corto
+    int16_t giro = (int16_t)(despues.pose.angulo - antes.pose.angulo);
+    pose.x = antes.pose.x + (int32_t)(((int64_t)(despues.pose.x - antes.pose.x) * f) >> 16);
+    pose.y = antes.pose.y + (int32_t)(((int64_t)(despues.pose.y - antes.pose.y) * f) >> 16);
+    pose.angulo = antes.pose.angulo + (AnguloBinario)((giro * f) >> 16);
+    return true;
+}
+
+// Como poseEnInstante(), pero espera (a lo sumo un periodo de odometría) a
+// que se registre una pose posterior a t
+PoseRobot esperarPoseEn(uint32_t t) {
+    PoseRobot pose;
+    while (!poseEnInstante(t, pose)) vTaskDelay(1);
+    return pose;
+}
+
+#endif // ESTADO_ROBOT_H
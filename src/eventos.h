@@ -0,0 +1,281 @@
+#ifndef EVENTOS_H
+#define EVENTOS_H
+
+#include <Arduino.h>
+#include <WiFi.h>
+#include <atomic>
+#include "escritorchunked.h"
+#include "hal.h"
+#include "traza.h"
+
+// Canal de eventos (Server-Sent Events) para el tablero. El WebServer de
+// Arduino atiende un pedido a la vez, así que una conexión que queda
+// abierta lo bloquearía: por eso los eventos van por un puerto aparte.
+#define PUERTO_EVENTOS 81
+#define MAX_CLIENTES_EVENTOS 3
+
+// Cadencia por cliente: se junta todo lo que cambió en el intervalo en un
+// solo evento
+#define INTERVALO_EVENTOS_MS 50
+#define LATIDO_EVENTOS_MS 15000
+// Un evento lleva a lo sumo esta cantidad de celdas; el mapa completo y las
+// rachas de cambios largas van en varios eventos seguidos. Así cada evento
+// cabe en el buffer del cliente: cabecera (~200 bytes) y 19 por celda.
+#define CELDAS_POR_EVENTO 64
+#define TAMANO_EVENTO 1600
+// Un cliente que no recibe nada en este tiempo se da por caído
+#define ESPERA_CLIENTE_TRABADO_MS 10000
+// El pedido HTTP se lee de a lo que haya llegado en cada vuelta; quien no lo
+// termina en este tiempo pierde su lugar
+#define ESPERA_PEDIDO_EVENTOS_MS 2000
+#define BYTES_PEDIDO_POR_VUELTA 256
+
+// Variables externas
+extern MapaRobot mapa;
+extern std::atomic<uint32_t> versionPose;
+extern std::atomic<uint32_t> muestrasIntegradas;
+
+WiFiServer servidorEventos(PUERTO_EVENTOS);
+
+// Lo que ya recibió cada cliente; con eso se sabe qué falta mandarle.
+// Cada evento se arma entero en su buffer y sale de a lo que acepte el
+// socket en cada vuelta: un cliente lento nunca hace esperar al servidor.
+// Mientras quede algo por salir no se arma otro, y el siguiente junta todo
+// lo que cambió entretanto.
+struct ClienteEventos {
+    WiFiClient conexion;
+    bool activo = false;
+    bool leyendoPedido = false; // Todavía no llegó la línea vacía del pedido
+    uint8_t saltosSeguidos = 0; // '\n' seguidos (sin contar '\r') al leer el pedido
+    unsigned long aceptado = 0;
+    bool sincronizado = false;   // Ya recibió el mapa completo
+    int celdaSincronizacion = 0; // Mientras no: por dónde va el mapa completo
+    uint32_t seqSincronizacion = 0;
+    uint32_t seq = 0;            // Cursor del mapa
+    uint32_t versionPose = 0;
+    uint32_t muestras = 0;
+    unsigned long ultimoEnvio = 0;
+    unsigned long ultimoAvance = 0; // Sin nada pendiente, o el socket aceptó algo
+    char *pendiente = NULL;         // Buffer del evento en curso
+    uint16_t largo = 0;
+    uint16_t enviado = 0;
+};
+
+ClienteEventos clientesEventos[MAX_CLIENTES_EVENTOS];
+// Aparte de ClienteEventos, que se reinicia copiando uno nuevo
+char buffersEventos[MAX_CLIENTES_EVENTOS][TAMANO_EVENTO];
+
+// Adapta el buffer de un cliente a la interfaz que espera EscritorChunked
+struct DestinoEventos {
+    ClienteEventos &c;
+    bool desbordado = false;
+
+    void setContentLength(size_t) {}
+    void send(int, const char *, const char *) {}
+    void sendContent(const char *datos, size_t longitud) {
+        if (longitud > (size_t)(TAMANO_EVENTO - c.largo)) {
+            desbordado = true;
+            return;
+        }
+        memcpy(c.pendiente + c.largo, datos, longitud);
+        c.largo += longitud;
+    }
+    void sendContent(const char *texto) { sendContent(texto, strlen(texto)); }
+};
+
+void cerrarClienteEventos(ClienteEventos &c) {
+    c.conexion.stop();
+    c.activo = false;
+}
+
+// --- Manda lo que el socket acepte de lo pendiente ---
+void vaciarPendiente(ClienteEventos &c) {
+    int n = halEscribirSinEsperar(c.conexion, (const uint8_t *)c.pendiente + c.enviado, c.largo - c.enviado);
+    if (n < 0) {
+        cerrarClienteEventos(c);
+        return;
+    }
+    if (n > 0) {
+        c.enviado += n;
+        c.ultimoAvance = millis();
+    }
+    if (c.enviado == c.largo) c.largo = c.enviado = 0;
+}
+
+void encolarTexto(ClienteEventos &c, const char *texto) {
+    DestinoEventos destino{c};
+    destino.sendContent(texto);
+}
+
+// --- Acepta un cliente nuevo; el pedido se lee después, sin esperarlo ---
+void aceptarClienteEventos() {
+    WiFiClient nuevo = servidorEventos.accept();
+    if (!nuevo) return;
+
+    for (int i = 0; i < MAX_CLIENTES_EVENTOS; i++) {
+        ClienteEventos &c = clientesEventos[i];
+        if (c.activo) continue;
+        c = ClienteEventos();
+        c.conexion = nuevo;
+        c.pendiente = buffersEventos[i];
+        c.conexion.setNoDelay(true);
+        c.activo = true;
+        c.leyendoPedido = true;
+        c.aceptado = millis();
+        c.ultimoAvance = c.aceptado;
+        return;
+    }
+
+    // Sin lugar: el navegador sigue con /get-data
+    nuevo.print("HTTP/1.1 503 Service Unavailable\r\nConnection: close\r\n\r\n");
+    nuevo.stop();
+}
+
+// --- Consume lo que llegó del pedido HTTP (la ruta no importa: solo hay un
+// stream) y, al terminar las cabeceras, responde con la del stream ---
+void leerPedidoEventos(ClienteEventos &c) {
+    for (int n = 0; n < BYTES_PEDIDO_POR_VUELTA && c.conexion.available(); n++) {
+        int b = c.conexion.read();
+        if (b == '\r') continue;
+        c.saltosSeguidos = b == '\n' ? c.saltosSeguidos + 1 : 0;
+        if (c.saltosSeguidos < 2) continue;
+
+        // Línea vacía: fin de cabeceras
+        c.leyendoPedido = false;
+        encolarTexto(c, "HTTP/1.1 200 OK\r\n"
+                        "Content-Type: text/event-stream\r\n"
+                        "Cache-Control: no-cache\r\n"
+                        "Access-Control-Allow-Origin: *\r\n"
+                        "Connection: keep-alive\r\n\r\n"
+                        "retry: 2000\n\n");
+        vaciarPendiente(c);
+        return;
+    }
+    if (millis() - c.aceptado > ESPERA_PEDIDO_EVENTOS_MS) {
+        cerrarClienteEventos(c);
+    }
+}
+
+// Celda del evento: [x, y] en el mapa completo, [x, y, 1|0] en los cambios
+template <typename Escritor>
+void agregarCelda(Escritor &w, bool &primero, int32_t x, int32_t y, const char *cierre) {
+    if (!primero) w.agregar(',');
+    w.agregar('['); w.agregarEntero(x);
+    w.agregar(','); w.agregarEntero(y);
+    w.agregar(cierre);
+    primero = false;
+}
+
+// --- Arma el próximo evento del cliente: una página del mapa completo o
+// hasta CELDAS_POR_EVENTO cambios desde su cursor ---
+void armarEventoDatos(ClienteEventos &c) {
+    DestinoEventos destino{c};
+    EscritorChunked<DestinoEventos, 256> w(destino);
+
+    if (c.sincronizado && !mapa.hayCambiosDesde(c.seq)) {
+        c.sincronizado = false; // Se perdió cambios: vuelve a recibir el mapa entero
+        c.celdaSincronizacion = 0;
+    }
+    if (!c.sincronizado && c.celdaSincronizacion > 0 && !mapa.hayCambiosDesde(c.seqSincronizacion)) {
+        c.celdaSincronizacion = 0; // El mapa cambió demasiado mientras se mandaba: de nuevo
+    }
+
+    uint32_t pose = versionPose;
+    uint32_t muestras = muestrasIntegradas;
+    bool primero = true;
+    w.agregar("data: ");
+    if (c.sincronizado) {
+        // Cambios desde el cursor: [x, y, 1] = nueva celda ocupada, [x, y, 0] = liberada
+        uint32_t hasta = mapa.secuencia();
+        if (hasta - c.seq > CELDAS_POR_EVENTO) hasta = c.seq + CELDAS_POR_EVENTO;
+        serializarEstado(w, hasta);
+        w.agregar(",\"completo\":false,\"cambios\":[");
+        mapa.recorrerCambiosEntre(c.seq, hasta, [&](int32_t x, int32_t y, bool ocupada) {
+            agregarCelda(w, primero, x, y, ocupada ? ",1]" : ",0]");
+        });
+        c.seq = hasta;
+    } else {
+        // El mapa completo por páginas: la primera reemplaza lo que tenga el
+        // tablero, las demás agregan celdas. Lo que cambie mientras tanto se
+        // manda después como cambios desde seqSincronizacion; el cursor
+        // recién vale al terminar, hasta ahí va 0.
+        int desde = c.celdaSincronizacion;
+        if (desde == 0) c.seqSincronizacion = mapa.secuencia();
+        // Primero solo para saber dónde termina la página
+        int siguiente = mapa.recorrerOcupadasDesde(desde, CELDAS_POR_EVENTO, [](int32_t, int32_t) {});
+        bool ultima = siguiente == MapaRobot::ancho() * MapaRobot::alto();
+        serializarEstado(w, ultima ? c.seqSincronizacion : 0);
+        w.agregar(desde == 0 ? ",\"completo\":true,\"obstaculos\":[" : ",\"completo\":false,\"cambios\":[");
+        // Si el mapa cambió entre las dos pasadas sigue desde donde llegó esta
+        siguiente = mapa.recorrerOcupadasDesde(desde, CELDAS_POR_EVENTO, [&](int32_t x, int32_t y) {
+            agregarCelda(w, primero, x, y, desde == 0 ? "]" : ",1]");
+        });
+        c.celdaSincronizacion = siguiente;
+        if (siguiente == MapaRobot::ancho() * MapaRobot::alto()) {
+            c.sincronizado = true;
+            c.seq = c.seqSincronizacion;
+        }
+    }
+    w.agregar("]}\n\n");
+    w.terminar();
+
+    if (destino.desbordado) {
+        cerrarClienteEventos(c); // No debería pasar con CELDAS_POR_EVENTO
+        return;
+    }
+    c.versionPose = pose;
+    c.muestras = muestras;
+    c.ultimoEnvio = millis();
+}
+
+// --- Se llama seguido desde el lazo del servidor web ---
+void atenderEventos() {
+    if (servidorEventos.hasClient()) {
+        aceptarClienteEventos();
+    }
+
+    for (int i = 0; i < MAX_CLIENTES_EVENTOS; i++) {
+        ClienteEventos &c = clientesEventos[i];
+        if (!c.activo) continue;
+        if (!c.conexion.connected()) {
+            cerrarClienteEventos(c);
+            continue;
+        }
+        if (c.leyendoPedido) {
+            leerPedidoEventos(c);
+            continue;
+        }
+
+        TRAZAR_INICIO(TRAZA_EVENTOS_SSE);
+        unsigned long ahora = millis();
+        if (c.largo == 0) {
+            c.ultimoAvance = ahora;
+            bool hayNovedades = !c.sincronizado || c.seq != mapa.secuencia() ||
+                                c.versionPose != versionPose || c.muestras != muestrasIntegradas;
+            // El mapa completo va enseguida, y lo mismo si ya hay más cambios
+            // de los que entran en un evento: esperar no junta nada
+            bool enseguida = !c.sincronizado || mapa.secuencia() - c.seq > CELDAS_POR_EVENTO;
+            if (hayNovedades && (enseguida || ahora - c.ultimoEnvio >= INTERVALO_EVENTOS_MS)) {
+                armarEventoDatos(c);
+            } else if (!hayNovedades && ahora - c.ultimoEnvio > LATIDO_EVENTOS_MS) {
+                // Comentario SSE: mantiene viva la conexión y detecta clientes caídos
+                encolarTexto(c, ":\n\n");
+                c.ultimoEnvio = ahora;
+            }
+        }
+        if (c.activo && c.largo > 0) {
+            vaciarPendiente(c);
+            if (c.activo && c.largo > 0 && ahora - c.ultimoAvance > ESPERA_CLIENTE_TRABADO_MS) {
+                cerrarClienteEventos(c); // Si vuelve, reconecta y recibe el mapa completo
+            }
+        }
+        TRAZAR_FIN(TRAZA_EVENTOS_SSE);
+    }
+}
+
+void iniciarEventos() {
+    servidorEventos.begin();
+    servidorEventos.setNoDelay(true);
+}
+
+#endif // EVENTOS_H
@@ -0,0 +1,63 @@
+#ifndef HAL_H
+#define HAL_H
+
+#include <Arduino.h>
+#include <WiFi.h>
+
+// Capa de hardware: lo que cambia entre el robot y la PC. El resto de src/
+// usa estas funciones y la API de Arduino/FreeRTOS, que en la PC da
+// lib/PlataformaNativa sobre un reloj simulado.
+//  - Reloj: halTiempoUs(); micros(), millis() y las esperas de FreeRTOS;
+//    halCiclos() para medir rendimiento
+//  - Motores: salidas de las bobinas y el temporizador de pasos
+//  - Sensor de rango: el VL53L0X en modo continuo y su aviso de medición lista
+//  - Servidor web: WebServer/WiFi de Arduino (en la PC, pedidos simulados) y
+//    una escritura a socket que no espera
+// En el robot se compila hal_esp32.h; con ENTORNO_NATIVO ([env:native] en
+// platformio.ini), hal_nativo.h.
+
+// Una medición cruda del sensor
+struct LecturaSensor {
+    uint16_t distancia;  // mm
+    uint16_t calidad;    // Tasa de señal de retorno (MCPS en formato 9.7)
+    uint8_t estado;      // Estado de rango del dispositivo (11 = medición válida)
+};
+
+// Microsegundos desde el arranque, sin desborde
+int64_t halTiempoUs();
+// Reloj para medir cuánto cuesta un cálculo: cuenta de ciclos de la CPU
+// (32 bits, medir intervalos cortos) y ciclos por microsegundo. En la PC
+// son nanosegundos del reloj del sistema, porque el simulado no avanza
+// mientras una tarea calcula.
+uint32_t halCiclos();
+uint32_t halCiclosPorUs();
+
+// Apaga y enciende salidas de los bancos de GPIO 0-31 y 32-39 (desde el ISR de pasos)
+void halEscribirBobinas(uint32_t encender, uint32_t apagar, uint32_t encender1, uint32_t apagar1);
+// Temporizador periódico del ISR de pasos; queda detenido hasta halArrancarTemporizadorPasos()
+void halIniciarTemporizadorPasos(uint32_t frecuenciaHz, void (*isr)());
+void halArrancarTemporizadorPasos();
+void halDetenerTemporizadorPasos();
+
+// Inicia el sensor en modo continuo; false si no responde
+bool halIniciarSensor(uint16_t timeoutMs);
+uint32_t halVentanaSensorUs();   // Ventana de integración de cada medición
+uint16_t halTimeoutSensorMs();
+bool halMedicionLista();         // Sin bloquear
+// Lee la última medición y libera al sensor para la siguiente
+void halLeerMedicion(LecturaSensor &lectura);
+// Llama a "isr" (en contexto de interrupción) cada vez que hay una medición lista
+void halAvisarMedicionLista(void (*isr)());
+
+// Escribe en la conexión lo que entre en el buffer del socket, sin esperar
+// (WiFiClient::write reintenta hasta que se va todo). Devuelve los bytes
+// aceptados, 0 si el socket está lleno y -1 si la conexión se cayó.
+int halEscribirSinEsperar(WiFiClient &conexion, const uint8_t *datos, size_t longitud);
+
+#ifdef ENTORNO_NATIVO
+#include "hal_nativo.h"
+#else
+#include "hal_esp32.h"
+#endif
+
+#endif // HAL_H
@@ -0,0 +1,106 @@
+#ifndef HAL_ESP32_H
+#define HAL_ESP32_H
+
+#include <Arduino.h>
+#include <Wire.h>
+#include <VL53L0X.h>
+#include <esp_timer.h>
+#include <errno.h>
+#include <lwip/sockets.h>
+#include "soc/gpio_reg.h"
+#include "soc/soc.h"
+
+// Backend de hal.h para la Feather ESP32
+
+// Bus I2C del VL53L0X
+#define PIN_SDA_SENSOR 21
+#define PIN_SCL_SENSOR 22
+// Pin conectado a GPIO1 del VL53L0X (salida "medición lista", activa en bajo).
+// El módulo ya trae pull-up, por eso sirve un pin de solo entrada.
+#define PIN_VL53_GPIO1 34
+
+VL53L0X sensor;
+hw_timer_t *temporizadorPasos = NULL;
+
+int64_t halTiempoUs() {
+    return esp_timer_get_time();
+}
+
+uint32_t IRAM_ATTR halCiclos() {
+    return ESP.getCycleCount();
+}
+
+uint32_t halCiclosPorUs() {
+    return ESP.getCpuFreqMHz();
+}
+
+void IRAM_ATTR halEscribirBobinas(uint32_t encender, uint32_t apagar, uint32_t encender1, uint32_t apagar1) {
+    REG_WRITE(GPIO_OUT_W1TC_REG, apagar);
+    REG_WRITE(GPIO_OUT_W1TS_REG, encender);
+    REG_WRITE(GPIO_OUT1_W1TC_REG, apagar1);
+    REG_WRITE(GPIO_OUT1_W1TS_REG, encender1);
+}
+
+void halIniciarTemporizadorPasos(uint32_t frecuenciaHz, void (*isr)()) {
+    temporizadorPasos = timerBegin(1000000); // Cuenta en microsegundos
+    timerAttachInterrupt(temporizadorPasos, isr);
+    timerAlarm(temporizadorPasos, 1000000 / frecuenciaHz, true, 0);
+    timerStop(temporizadorPasos);
+}
+
+void halArrancarTemporizadorPasos() {
+    timerStart(temporizadorPasos);
+}
+
+void halDetenerTemporizadorPasos() {
+    timerStop(temporizadorPasos);
+}
+
+bool halIniciarSensor(uint16_t timeoutMs) {
+    Wire.begin(PIN_SDA_SENSOR, PIN_SCL_SENSOR);
+    bool respondio = sensor.init();
+    sensor.setTimeout(timeoutMs);
+    sensor.startContinuous();
+    return respondio;
+}
+
+uint32_t halVentanaSensorUs() {
+    return sensor.getMeasurementTimingBudget();
+}
+
+uint16_t halTimeoutSensorMs() {
+    return sensor.getTimeout();
+}
+
+// Consulta sin bloquear si el VL53L0X terminó una medición (modo continuo)
+bool halMedicionLista() {
+    return (sensor.readReg(VL53L0X::RESULT_INTERRUPT_STATUS) & 0x07) != 0;
+}
+
+// Lee el bloque de resultados en una sola transacción I2C y libera la
+// interrupción del sensor para la siguiente medición
+void halLeerMedicion(LecturaSensor &lectura) {
+    uint8_t resultado[12];
+    sensor.readMulti(VL53L0X::RESULT_RANGE_STATUS, resultado, sizeof(resultado));
+    sensor.writeReg(VL53L0X::SYSTEM_INTERRUPT_CLEAR, 0x01);
+
+    lectura.estado = (resultado[0] & 0x78) >> 3;
+    lectura.calidad = ((uint16_t)resultado[6] << 8) | resultado[7];
+    lectura.distancia = ((uint16_t)resultado[10] << 8) | resultado[11];
+}
+
+void halAvisarMedicionLista(void (*isr)()) {
+    pinMode(PIN_VL53_GPIO1, INPUT);
+    attachInterrupt(digitalPinToInterrupt(PIN_VL53_GPIO1), isr, FALLING);
+    // Una medición pudo quedar pendiente antes de habilitar la interrupción
+    sensor.writeReg(VL53L0X::SYSTEM_INTERRUPT_CLEAR, 0x01);
+}
+
+int halEscribirSinEsperar(WiFiClient &conexion, const uint8_t *datos, size_t longitud) {
+    if (!conexion.connected()) return -1;
+    int n = send(conexion.fd(), datos, longitud, MSG_DONTWAIT);
+    if (n >= 0) return n;
+    return errno == EAGAIN || errno == EWOULDBLOCK ? 0 : -1;
+}
+
+#endif // HAL_ESP32_H
@@ -0,0 +1,105 @@
+#ifndef HAL_NATIVO_H
+#define HAL_NATIVO_H
+
+#include <Arduino.h>
+#include <chrono>
+#include "simulacion.h"
+
+// Backend de hal.h para la PC ([env:native]). Las bobinas quedan en
+// "salidasSimuladas" y el sensor termina una medición por ventana; quien
+// simule el entorno engancha "alCambiarBobinas" y "modeloSensorNativo".
+
+// Una salida por GPIO (0-39), como los dos bancos del ESP32
+uint64_t salidasSimuladas = 0;
+void (*alCambiarBobinas)(uint64_t salidas) = NULL;
+
+// Modelo del sensor: completa la lectura al final de cada ventana; false si
+// esa medición no llega (el lector ve un timeout). Sin modelo, fuera de rango.
+bool (*modeloSensorNativo)(LecturaSensor &lectura) = NULL;
+
+#define VENTANA_SENSOR_NATIVO_US 33000
+
+int temporizadorPasosNativo = -1;
+int temporizadorSensorNativo = -1;
+uint16_t timeoutSensorNativoMs = 0;
+LecturaSensor lecturaNativa;
+bool medicionNativaPendiente = false;
+void (*isrSensorNativo)() = NULL;
+
+int64_t halTiempoUs() {
+    return (int64_t)simTiempoUs();
+}
+
+uint32_t halCiclos() {
+    auto ahora = std::chrono::steady_clock::now().time_since_epoch();
+    return (uint32_t)std::chrono::duration_cast<std::chrono::nanoseconds>(ahora).count();
+}
+
+uint32_t halCiclosPorUs() {
+    return 1000;
+}
+
+void halEscribirBobinas(uint32_t encender, uint32_t apagar, uint32_t encender1, uint32_t apagar1) {
+    uint64_t antes = salidasSimuladas;
+    salidasSimuladas &= ~((uint64_t)apagar | ((uint64_t)apagar1 << 32));
+    salidasSimuladas |= (uint64_t)encender | ((uint64_t)encender1 << 32);
+    if (alCambiarBobinas != NULL && salidasSimuladas != antes) alCambiarBobinas(salidasSimuladas);
+}
+
+void halIniciarTemporizadorPasos(uint32_t frecuenciaHz, void (*isr)()) {
+    temporizadorPasosNativo = simCrearTemporizador(1000000 / frecuenciaHz, isr);
+}
+
+void halArrancarTemporizadorPasos() {
+    simArrancarTemporizador(temporizadorPasosNativo);
+}
+
+void halDetenerTemporizadorPasos() {
+    simDetenerTemporizador(temporizadorPasosNativo);
+}
+
+// Fin de una ventana: el sensor deja la medición y avisa por GPIO1
+void finVentanaSensorNativo() {
+    LecturaSensor lectura = {8190, 0, 4}; // Sin modelo: fuera de rango
+    if (modeloSensorNativo != NULL && !modeloSensorNativo(lectura)) return;
+    lecturaNativa = lectura;
+    medicionNativaPendiente = true;
+    if (isrSensorNativo != NULL) isrSensorNativo();
+}
+
+bool halIniciarSensor(uint16_t timeoutMs) {
+    timeoutSensorNativoMs = timeoutMs;
+    temporizadorSensorNativo = simCrearTemporizador(VENTANA_SENSOR_NATIVO_US, finVentanaSensorNativo);
+    simArrancarTemporizador(temporizadorSensorNativo);
+    return true;
+}
+
+uint32_t halVentanaSensorUs() {
+    return VENTANA_SENSOR_NATIVO_US;
+}
+
+uint16_t halTimeoutSensorMs() {
+    return timeoutSensorNativoMs;
+}
+
+bool halMedicionLista() {
+    return medicionNativaPendiente;
+}
+
+void halLeerMedicion(LecturaSensor &lectura) {
+    lectura = lecturaNativa;
+    medicionNativaPendiente = false;
+}
+
+void halAvisarMedicionLista(void (*isr)()) {
+    isrSensorNativo = isr;
+    medicionNativaPendiente = false;
+}
+
+// La conexión simulada acepta "capacidad" bytes por escritura
+int halEscribirSinEsperar(WiFiClient &conexion, const uint8_t *datos, size_t longitud) {
+    if (!conexion.connected()) return -1;
+    return (int)conexion.write(datos, longitud);
+}
+
+#endif // HAL_NATIVO_H
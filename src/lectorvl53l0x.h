@@ -0,0 +1,146 @@
+#ifndef LECTOR_VL53L0X_H
+#define LECTOR_VL53L0X_H
+
+#include <Arduino.h>
+#include "hal.h"
+#include "estadorobot.h"
+#include "registro.h"
+#include "traza.h"
+
+// 1: el lector duerme hasta la interrupción de GPIO1
+// 0: el lector consulta RESULT_INTERRUPT_STATUS cada tick (sin cable GPIO1)
+#ifndef MUESTREO_POR_INTERRUPCION
+#define MUESTREO_POR_INTERRUPCION 1
+#endif
+
+// Capacidad de la cola entre el lector y el escaneo
+#define LONGITUD_COLA_MUESTRAS 32
+
+// Una medición del sensor tal como la entrega el lector
+struct MuestraRango {
+    uint32_t tiempoUs;   // Mitad de la ventana de integración de la medición
+    AnguloBinario angulo; // Ángulo del haz respecto del frente del robot
+    uint16_t distancia;  // mm
+    uint16_t calidad;    // Tasa de señal de retorno (MCPS en formato 9.7)
+    uint8_t estado;      // Estado de rango del dispositivo (11 = medición válida)
+    PoseRobot pose;      // Pose del robot interpolada al instante de la medición
+};
+
+#define ESTADO_RANGO_VALIDO 11
+#define DISTANCIA_SIN_OBJETIVO 8190 // El sensor da 8190 u 8191 si no hubo retorno
+
+// Lo que dice una muestra del espacio a lo largo del haz
+enum ClaseMuestra : uint8_t {
+    MUESTRA_IMPACTO,    // Obstáculo a "distancia"
+    MUESTRA_LIBRE,      // Nada hasta el alcance confiable del sensor
+    MUESTRA_DESCARTADA  // Demasiado cerca, o el sensor no confía en la distancia
+};
+
+// Con un estado distinto de 11 (sigma, señal o fase fuera de límites) la
+// distancia no sirve ni como obstáculo ni como espacio libre; solo la falta
+// total de retorno dice que no hay nada al alcance.
+ClaseMuestra clasificarMuestra(const MuestraRango &muestra, uint16_t minimo, uint16_t maximo) {
+    if (muestra.estado != ESTADO_RANGO_VALIDO) {
+        return muestra.distancia >= DISTANCIA_SIN_OBJETIVO ? MUESTRA_LIBRE : MUESTRA_DESCARTADA;
+    }
+    if (muestra.distancia <= minimo) return MUESTRA_DESCARTADA;
+    return muestra.distancia < maximo ? MUESTRA_IMPACTO : MUESTRA_LIBRE;
+}
+
+// Variables externas
+int32_t pasosSensor();                 // Posición del motor que orienta el haz (se lee en el ISR)
+AnguloBinario anguloSensorEnPasos(int32_t pasos);
+
+QueueHandle_t colaMuestras = NULL;
+TaskHandle_t tareaLector = NULL;
+volatile uint32_t tiempoInterrupcionUs = 0;
+volatile int32_t pasosInterrupcion = 0;
+uint32_t muestrasDescartadas = 0;
+uint32_t timeoutsSensor = 0;
+uint32_t ventanaMedicionUs = 33000;    // Se lee del sensor al iniciar el lector
+
+// --- Interrupción de GPIO1: instante y posición del haz, y despierta al lector ---
+void IRAM_ATTR isrMedicionLista() {
+    tiempoInterrupcionUs = micros();
+    pasosInterrupcion = pasosSensor();
+    BaseType_t despertar = pdFALSE;
+    vTaskNotifyGiveFromISR(tareaLector, &despertar);
+    portYIELD_FROM_ISR(despertar);
+}
+
+void leerMedicion(MuestraRango &muestra) {
+    LecturaSensor lectura;
+    halLeerMedicion(lectura);
+    muestra.estado = lectura.estado;
+    muestra.calidad = lectura.calidad;
+    muestra.distancia = lectura.distancia;
+}
+
+// El sensor integra durante toda la ventana y avisa al final: la medición
+// corresponde a la mitad de la ventana. La posición del haz en ese instante
+// se interpola entre la captura del aviso anterior y la de este.
+int32_t pasosEnMitadDeVentana(uint32_t tiempoAnterior, int32_t pasosAnterior,
+                              uint32_t tiempo, int32_t pasos, uint32_t mitad) {
+    uint32_t intervalo = tiempo - tiempoAnterior;
+    if (intervalo == 0 || intervalo > 4 * ventanaMedicionUs) return pasos; // Sin aviso anterior cercano
+    uint32_t hastaMitad = tiempo - mitad - tiempoAnterior;
+    if ((int32_t)hastaMitad < 0) return pasosAnterior;
+    return pasosAnterior + (int32_t)((int64_t)(pasos - pasosAnterior) * hastaMitad / intervalo);
+}
+
+// --- Tarea lectora: única dueña del bus I2C del sensor ---
+void TaskLECTOR(void *pvParameters) {
+    uint32_t tiempoAnterior = 0;
+    int32_t pasosAnterior = 0;
+    for (;;) {
+#if MUESTREO_POR_INTERRUPCION
+        if (ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(halTimeoutSensorMs())) == 0) {
+            timeoutsSensor++;
+            TRAZAR_INSTANTE(TRAZA_TIMEOUT_SENSOR, 0);
+            REG_AVISO("Timeout del sensor");
+            continue;
+        }
+        uint32_t tiempo = tiempoInterrupcionUs;
+        int32_t pasos = pasosInterrupcion;
+#else
+        if (!halMedicionLista()) {
+            vTaskDelay(1);
+            continue;
+        }
+        uint32_t tiempo = micros();
+        int32_t pasos = pasosSensor();
+#endif
+        uint32_t mitad = ventanaMedicionUs / 2;
+        MuestraRango muestra;
+        muestra.tiempoUs = tiempo - mitad;
+        muestra.angulo = anguloSensorEnPasos(pasosEnMitadDeVentana(tiempoAnterior, pasosAnterior, tiempo, pasos, mitad));
+        tiempoAnterior = tiempo;
+        pasosAnterior = pasos;
+        TRAZAR_INICIO(TRAZA_LECTURA_SENSOR);
+        leerMedicion(muestra);
+        TRAZAR_FIN(TRAZA_LECTURA_SENSOR);
+        // La odometría registra la pose cada pocos ms: se espera a tener una
+        // posterior a la medición para interpolar entre las dos que la rodean
+        TRAZAR_INICIO(TRAZA_ESPERA_POSE);
+        muestra.pose = esperarPoseEn(muestra.tiempoUs);
+        TRAZAR_FIN(TRAZA_ESPERA_POSE);
+
+        // Si el consumidor se atrasa la muestra se descarta
+        if (xQueueSend(colaMuestras, &muestra, 0) != pdTRUE) {
+            muestrasDescartadas++;
+            TRAZAR_INSTANTE(TRAZA_MUESTRA_DESCARTADA, uxQueueMessagesWaiting(colaMuestras));
+        }
+    }
+}
+
+// Arranca el lector; el sensor ya debe estar en modo continuo
+void iniciarLectorSensor(BaseType_t nucleo) {
+    ventanaMedicionUs = halVentanaSensorUs();
+    colaMuestras = xQueueCreate(LONGITUD_COLA_MUESTRAS, sizeof(MuestraRango));
+    xTaskCreatePinnedToCore(TaskLECTOR, "TaskLECTOR", 3072, NULL, 2, &tareaLector, nucleo);
+#if MUESTREO_POR_INTERRUPCION
+    halAvisarMedicionLista(isrMedicionLista);
+#endif
+}
+
+#endif // LECTOR_VL53L0X_H
@@ -1,8 +1,19 @@
-#include <AccelStepper.h>
-#include <Wire.h>
-#include <VL53L0X.h>
 #include "apwifieeprommode.h"
+#include "eventos.h"
+#include "lectorvl53l0x.h"
+#include "anillospsc.h"
+#include "motorespasos.h"
+#include "traccion.h"
+#include "barreraciclo.h"
+#include "registro.h"
+#include "trigonometria.h"
 #include <EEPROM.h>
+#ifdef SIMULADOR_HABITACION
+#include "simulador.h" // Sala simulada ([env:simulador])
+#endif
+#ifdef BANCO_RENDIMIENTO
+#include "banco.h" // Banco de rendimiento ([env:banco], [env:banco_esp32])
+#endif
 
 // Definir el servidor web
 WebServer server(80);
@@ -25,279 +36,586 @@ WebServer server(80);
 #define IN3_M3 4
 #define IN4_M3 2
 
-// Definir puntos - AUMENTADO para más capacidad
-#define MAX_PUNTOS 500
-int historialAngulos[MAX_PUNTOS];
-int historialDistancias[MAX_PUNTOS];
+// Mapa de ocupación (memoria fija) y cantidad de celdas ocupadas
+MapaRobot mapa;
 int numPuntos = 0;
 
-// NUEVOS ARRAYS: Coordenadas absolutas de obstáculos
-float obstaculosX[MAX_PUNTOS];
-float obstaculosY[MAX_PUNTOS];
+// Contadores que el canal de eventos compara para saber si hay algo nuevo
+std::atomic<uint32_t> versionPose{0};
+std::atomic<uint32_t> muestrasIntegradas{0};
+std::atomic<bool> pedirReportePasadas{false};
+
+// Muestras del escaneo hacia el mapa: produce TaskMUESTRAS, consume TaskSERVIDOR.
+// El mapa solo lo escribe TaskSERVIDOR, la misma tarea que atiende la web.
+AnilloSPSC<MuestraRango, 128> anilloMuestras;
+
+// 1: el sensor barre sobre el motor 3 (radar), independiente del chasis
+// 0: el sensor va fijo al frente y el escaneo gira el robot entero
+#define USAR_RADAR 1
+
+// 1: las muestras se integran al mapa también mientras el robot avanza o gira
+// 0: solo durante el giro de escaneo
+#define ESCANEO_CONTINUO 1
 
 // CPUs a utilizar
 #define PRO_CPU 0
 #define APP_CPU 1
 #define NOAFF_CPU tskNO_AFFINITY
 
-// Crear objetos de motores
-AccelStepper motor1(AccelStepper::FULL4WIRE, IN1_M1, IN3_M1, IN2_M1, IN4_M1);
-AccelStepper motor2(AccelStepper::FULL4WIRE, IN1_M2, IN3_M2, IN2_M2, IN4_M2);
-
-// Sensor LIDAR
-VL53L0X sensor;
+// El sensor LIDAR (VL53L0X) lo maneja la capa de hardware (hal.h)
 
 // Constantes
-const int pasosPorGrado = 2048 / 360; // Motor 28BYJ-48 // Ajusta según pruebas
-const int pasosPorMM = 50; // pasos para avanzar un mm // Ajusta según pruebas
 const int margenSeguridad = 165; // mm, radio del robot
+const int rangoMaximo = 2000; // mm, alcance confiable del VL53L0X
+const int rangoMinimo = 30; // mm, lecturas más cercanas se descartan
+// Lo más que un pivote puede correr el camino al costado de la línea
+// medida: media celda del mapa, que el escaneo no llega a distinguir
+const float corrimientoMaximoPivote = MAPA_RESOLUCION_MM / 2.0f; // mm
 
 // Variables
 int mejorAngulo = 0;
 int mayorDistancia = 0;
-float ultimoAngulo = 0;
-float ultimaDistancia = 0;
-
-// Posición del robot (en mm)
-float robotX = 0;
-float robotY = 0;
-float robotAngulo = 0; // Ángulo actual del robot (0° = hacia adelante)
+// Lectura más larga del escaneo en cada sector de 10°, y su ángulo
+#define SECTORES_ESCANEO 36
+int distanciaSector[SECTORES_ESCANEO];
+int anguloSector[SECTORES_ESCANEO];
+// Impacto más cercano del escaneo en cada grado de rumbo absoluto (0 = sin
+// impacto), medido desde (origenEscaneoX, origenEscaneoY). Una pared vista
+// en un solo giro todavía no marca sus celdas en el mapa, así que los
+// avances se recortan también contra estos puntos.
+uint16_t impactoEscaneo[360];
+int32_t origenEscaneoX = 0, origenEscaneoY = 0;
+AnguloBinario ultimoAngulo = 0;
+uint16_t ultimaDistancia = 0;
+
+// La posición del robot la lleva la odometría (traccion.h); se lee con instantaneaPose()
 
 // Variables para control de escaneo
 bool nuevoEscaneoCompleto = false;
 int puntosAntesDeCiclo = 0;
 
+// El escaneo dura lo que dura el giro: TaskROTARCOM baja esta bandera al terminar
+volatile bool giroEscaneoEnCurso = false;
+uint32_t inicioGiroUs = 0;    // Las muestras anteriores no cuentan para el giro
+AnguloBinario anguloInicioGiro = 0; // Rumbo del robot al empezar el giro de escaneo
+int muestrasGiro = 0;
+
 // Prototipos
 void escanearYBuscar();
+void buscarDireccion(const MuestraRango &muestra);
+void elegirDireccion();
+void drenarMuestras();
+int32_t pasosSensor();
+AnguloBinario anguloSensorEnPasos(int32_t pasos);
+void reportarPose();
+long pasosParaGirar(int angulo);
 void girarRobot(int angulo);
 void avanzarRobot(int mm);
+void irHacia(int angulo, int mm);
+int avanceLibre(int32_t x, int32_t y, AnguloBinario rumbo, int mm);
+void esperarMovimiento(uint32_t inicioUs);
 
-void TestHwm(char *taskName);
 void TaskESCANEO(void *pvParameters);
 void TaskROTARCOM(void *pvParameters);
-
-// Para sincronización
-SemaphoreHandle_t xSemaphore = NULL;
-volatile int tareasTerminadas = 0;  
+void TaskSERVIDOR(void *pvParameters);
+void TaskMUESTRAS(void *pvParameters);
+struct OrdenCiclo;
+void reportarCiclo(const OrdenCiclo &orden, uint32_t despertarUs);
+
+// Para sincronización: TaskESCANEO y TaskROTARCOM viven todo el programa,
+// reciben una orden por ciclo en su cola y avisan con un bit al terminar
+struct OrdenCiclo {
+  uint32_t ciclo;
+  uint32_t enviadaUs;
+};
+QueueHandle_t colaEscaneo = NULL;
+QueueHandle_t colaGiro = NULL;
 // Hay 2 tareas paralelas por loop, que gire 360 y que escanee
-const int TOTAL_TAREAS = 2;
+#define PARTICIPANTE_ESCANEO 0
+#define PARTICIPANTE_GIRO 1
+BarreraCiclo barreraCiclo(2);
+// Un giro completo del chasis tarda ~20 s; pasado esto algo se trabó
+#define ESPERA_MAXIMA_CICLO_MS 60000
+
+// Costo de coordinar cada ciclo: de la orden al arranque de cada tarea y
+// del último aviso a que loop() despierta
+uint32_t ciclosEscaneo = 0;
+uint32_t arranqueEscaneoUs = 0, arranqueGiroUs = 0;
+uint32_t finEscaneoUs = 0, finGiroUs = 0;
+// Tiempo de TaskMUESTRAS por muestra desde el último reporte
+std::atomic<uint32_t> muestrasProcesadas{0};
+std::atomic<uint32_t> tiempoMuestrasUs{0};
 
 void setup() {
   Serial.begin(115200);
+#ifdef BANCO_RENDIMIENTO
+  correrBanco(); // Mide los caminos calientes y no vuelve
+#endif
+  // La UART la atiende TaskREGISTRO en PRO_CPU, junto con la web
+  iniciarRegistro(PRO_CPU);
   // Inicializar EEPROM
   EEPROM.begin(512);
 
-  // Task paralelos
-  xTaskCreatePinnedToCore(TaskESCANEO, "TaskESCANEO", 4096, NULL, 1, NULL, APP_CPU);
-  xTaskCreatePinnedToCore(TaskROTARCOM, "TaskROTARCOM", 4096, NULL, 1, NULL, APP_CPU);
+  // Motores: los pasos los genera el temporizador (ver motorespasos.h).
+  // Antes que cualquier tarea que pueda mover el robot.
+  configurarEje(EJE_IZQUIERDO, IN1_M1, IN3_M1, IN2_M1, IN4_M1);
+  configurarEje(EJE_DERECHO, IN1_M2, IN3_M2, IN2_M2, IN4_M2);
+  configurarEje(EJE_RADAR, IN1_M3, IN3_M3, IN2_M3, IN4_M3);
+  configurarPerfil(800, 400);
+  iniciarMotores();
+  xTaskCreatePinnedToCore(TaskODOMETRIA, "TaskODOMETRIA", 3072, NULL, 3, nuevaTareaVigilada(), APP_CPU);
+#if USAR_RADAR
+  iniciarRadar(APP_CPU);
+  configurarBarrido(RADAR_VAIVEN, 180, 90); // ±180° a 90°/s: una pasada cada 4 s
+#endif
+
+  // Task paralelos: se crean una sola vez y esperan órdenes
+  colaEscaneo = xQueueCreate(1, sizeof(OrdenCiclo));
+  colaGiro = xQueueCreate(1, sizeof(OrdenCiclo));
+  barreraCiclo.iniciar();
+  xTaskCreatePinnedToCore(TaskESCANEO, "TaskESCANEO", 4096, NULL, 1, nuevaTareaVigilada(), APP_CPU);
+  xTaskCreatePinnedToCore(TaskROTARCOM, "TaskROTARCOM", 4096, NULL, 1, nuevaTareaVigilada(), APP_CPU);
 
   // Intentar conectarse a la red guardada (la de la laptop/hotspot)
   // Si no puede, crea el AP para registrar la red
   iniciarConexionWiFi("ESP32_AP", "clave1234"); // Cambia nombre y clave si lo deseas
 
-  // Configurar servidor web
-  server.on("/", handleRoot);
-  server.on("/get-data",handleGetData);
-  server.on("/wifi", handleWifi);
-  server.begin();
-  Serial.println("Servidor web iniciado");
+  // Las rutas del servidor web se registran en iniciarConexionWiFi()
+  iniciarEventos();
 
-  Wire.begin(21, 22); // SDA, SCL para VL53L0X
+  halIniciarSensor(500);
+  iniciarLectorSensor(APP_CPU);
+  xTaskCreatePinnedToCore(TaskMUESTRAS, "TaskMUESTRAS", 4096, NULL, 1, nuevaTareaVigilada(), APP_CPU);
 
-  sensor.init();
-  sensor.setTimeout(500);
-  sensor.startContinuous();
+  // Tareas creadas en los módulos y la de loop(), para /metrics
+  vigilarTarea(tareaRegistro);
+#if USAR_RADAR
+  vigilarTarea(tareaRadar);
+#endif
+  vigilarTarea(tareaLector);
+  vigilarTarea(xTaskGetCurrentTaskHandle());
 
-  motor1.setMaxSpeed(800);
-  motor1.setAcceleration(400);
+  // La web se atiende en PRO_CPU; movimiento y escaneo quedan en APP_CPU.
+  // Última: /metrics lee la tabla de tareas vigiladas sin candado, así que
+  // tiene que estar completa antes de que arranque TaskSERVIDOR
+  xTaskCreatePinnedToCore(TaskSERVIDOR, "TaskSERVIDOR", 6144, NULL, 2, nuevaTareaVigilada(), PRO_CPU);
+  REG_INFO("Servidor web iniciado");
 
-  motor2.setMaxSpeed(800);
-  motor2.setAcceleration(400);
-
-  // Se inicia "semáforo"
-  xSemaphore = xSemaphoreCreateBinary();
-  // Liberamos inicialmente
-  xSemaphoreGive(xSemaphore); 
   delay(1000);
   
-  Serial.println("Sistema iniciado. Comenzando escaneo continuo...");
+  REG_INFO("Sistema iniciado. Comenzando escaneo continuo...");
 }
 
 void loop() {
-  // Manejar el servidor web
-  server.handleClient();
-  loopServidorWeb();
-  
+  // Cada vuelta es un escaneo y un movimiento; la primera no tiene anterior
+  static uint32_t vueltaAnteriorUs = 0;
+  uint32_t vueltaUs = micros();
+  if (vueltaAnteriorUs != 0) metricas.cicloLoop.observar(vueltaUs - vueltaAnteriorUs);
+  vueltaAnteriorUs = vueltaUs;
+  TRAZAR_INICIO(TRAZA_CICLO);
+
   // Recordar cuántos puntos teníamos antes del ciclo
   puntosAntesDeCiclo = numPuntos;
   
   // Escanear continuamente para mostrar el mapa del entorno
-  if (xSemaphoreTake(xSemaphore, portMAX_DELAY) == pdTRUE) {
-    tareasTerminadas = 0;
-    // Se reinicia el contador por ciclo
-    xSemaphoreGive(xSemaphore);
-    
-    xTaskCreatePinnedToCore(TaskESCANEO, "TaskESCANEO", 4096, NULL, 1, NULL, APP_CPU);
-    xTaskCreatePinnedToCore(TaskROTARCOM, "TaskROTARCOM", 4096, NULL, 1, NULL, APP_CPU);
-  }
+  // Se marca el giro antes de dar las órdenes para que el escaneo no termine antes de empezar
+  mejorAngulo = 0;
+  mayorDistancia = 0;
+  for (int s = 0; s < SECTORES_ESCANEO; s++) distanciaSector[s] = 0;
+  memset(impactoEscaneo, 0, sizeof(impactoEscaneo));
+  muestrasGiro = 0;
+  anguloInicioGiro = instantaneaPose().angulo;
+  inicioGiroUs = micros();
+  giroEscaneoEnCurso = true;
+
+  barreraCiclo.abrirCiclo();
+  OrdenCiclo orden = {++ciclosEscaneo, (uint32_t)micros()};
+  xQueueSend(colaEscaneo, &orden, portMAX_DELAY);
+  xQueueSend(colaGiro, &orden, portMAX_DELAY);
 
   // AMBAS deben terminar
-  while (true) {
-    xSemaphoreTake(xSemaphore, portMAX_DELAY);
-    if (tareasTerminadas >= TOTAL_TAREAS) {
-      xSemaphoreGive(xSemaphore);
-      break;
+  uint32_t faltantes;
+  if (!barreraCiclo.esperar(ESPERA_MAXIMA_CICLO_MS, &faltantes)) {
+    metricas.ciclosVencidos++;
+    REG_ERROR("Ciclo %u vencido, falta:%s%s", (unsigned)orden.ciclo,
+                  (faltantes & (1u << PARTICIPANTE_ESCANEO)) ? " escaneo" : "",
+                  (faltantes & (1u << PARTICIPANTE_GIRO)) ? " giro" : "");
+    // Con el escaneo a medias no se elige dirección: se corta y se espera a
+    // que ambas tareas queden libres antes del próximo ciclo
+    giroEscaneoEnCurso = false;
+    while (!barreraCiclo.esperar(ESPERA_MAXIMA_CICLO_MS)) {
+      REG_AVISO("Tareas del ciclo todavía ocupadas");
     }
-    xSemaphoreGive(xSemaphore);
-    delay(10);
-    // Seguridad
+    TRAZAR_FIN(TRAZA_CICLO);
+    return;
   }
+  reportarCiclo(orden, micros());
+  vigilarConexionWiFi();
+  pedirReportePasadas = true;
 
   // Verificar si hay nuevos puntos
   if (numPuntos > puntosAntesDeCiclo) {
     nuevoEscaneoCompleto = true;
-    Serial.println("Nuevos puntos detectados: " + String(numPuntos - puntosAntesDeCiclo));
-    Serial.println("Total de puntos acumulados: " + String(numPuntos));
+    REG_INFO("Nuevos puntos detectados: %d", numPuntos - puntosAntesDeCiclo);
+    REG_INFO("Total de puntos acumulados: %d", numPuntos);
   }
   
+#if !ESCANEO_CONTINUO
   delay(3000); // Pausa entre escaneos (3 segundos)
-  girarRobot(mejorAngulo);
+#endif
+  elegirDireccion();
   int distancia_rec = mayorDistancia-margenSeguridad;
-  avanzarRobot(distancia_rec);
+  irHacia(mejorAngulo, distancia_rec);
+  TRAZAR_FIN(TRAZA_CICLO);
 }
 
 // ---------- FUNCIONES -------------
 
 void escanearYBuscar() {
-  mejorAngulo = 0;
-  mayorDistancia = 0;
+  unsigned long inicio = millis();
   
-  Serial.println("Iniciando escaneo 360°...");
+  REG_INFO("Iniciando escaneo 360°...");
 
-  // IDA: 0° a 360° (sentido antihorario/izquierda)
-  for (int angulo = 0; angulo <= 360; angulo += 5) {
-    int dist = sensor.readRangeContinuousMillimeters();
-    Serial.print("→ Ángulo: "); Serial.print(angulo);
-    Serial.print(" mm: "); Serial.println(dist);
+  // TaskMUESTRAS busca la mejor dirección con cada muestra mientras dure el giro
+  while (giroEscaneoEnCurso) {
+    vTaskDelay(pdMS_TO_TICKS(50));
+  }
+  
+  REG_INFO("Escaneo completado en %lu ms con %d muestras", millis() - inicio, (int)muestrasGiro);
+  REG_INFO("Mayor distancia: %d° (%dmm)", (int)mejorAngulo, (int)mayorDistancia);
+}
 
-    // Actualizar último escaneo
-    ultimoAngulo = (float)angulo;
-    ultimaDistancia = (float)dist;
-
-    // Solo agregar puntos válidos que estén dentro del rango
-    if (!sensor.timeoutOccurred() && dist < 2000 && dist > 30) { // Filtrar lecturas muy cercanas también
-      if (numPuntos < MAX_PUNTOS) {
-        historialAngulos[numPuntos] = angulo;
-        historialDistancias[numPuntos] = dist;
-        
-        // CALCULAR Y GUARDAR COORDENADAS ABSOLUTAS AQUÍ
-        float anguloAbsoluto = angulo + robotAngulo;
-        float anguloRad = anguloAbsoluto * 3.14159265 / 180.0;
-        obstaculosX[numPuntos] = robotX + dist * cos(anguloRad);
-        obstaculosY[numPuntos] = robotY + dist * sin(anguloRad);
-        
-        numPuntos++;
-        Serial.println("Punto agregado #" + String(numPuntos) + " - Ángulo: " + String(angulo) + "° Distancia: " + String(dist) + "mm");
-        Serial.println("Coordenadas absolutas: X=" + String(obstaculosX[numPuntos-1], 1) + " Y=" + String(obstaculosY[numPuntos-1], 1));
-      } else {
-        Serial.println("Límite de puntos alcanzado (" + String(MAX_PUNTOS) + ")");
-      }
+// Entre los sectores medidos, el que deja avanzar más lejos sin que el
+// chasis toque el mapa (ver avanceLibre). Con el mapa vacío alrededor es la
+// lectura más larga, la que ya eligió buscarDireccion().
+void elegirDireccion() {
+  PoseRobot pose = instantaneaPose();
+  int32_t x = mmDesdeMicras(pose.x), y = mmDesdeMicras(pose.y);
+  int mejorAvance = -1;
+  for (int s = 0; s < SECTORES_ESCANEO; s++) {
+    if (distanciaSector[s] == 0) continue;
+    AnguloBinario rumbo = pose.angulo + anguloBinarioDesdeGrados(anguloSector[s]);
+    int avance = avanceLibre(x, y, rumbo, distanciaSector[s] - margenSeguridad);
+    if (avance > mejorAvance) {
+      mejorAvance = avance;
+      mejorAngulo = anguloSector[s];
+      mayorDistancia = distanciaSector[s];
     }
+  }
+  REG_INFO("Mejor dirección: %d° (%dmm)", (int)mejorAngulo, (int)mayorDistancia);
+}
 
-    // Verificar conexión WiFi
-    if (WiFi.status() == WL_CONNECTED) {
-      // No enviar datos individuales, solo verificar conexión
-    } else {
-      Serial.println("WiFi desconectado");
-    }
+// Una muestra del giro de escaneo, en ángulo relativo al rumbo con que empezó el giro
+void buscarDireccion(const MuestraRango &muestra) {
+  int dist = muestra.distancia;
+  // En ángulo binario la suma y la resta dan la vuelta solas
+  AnguloBinario relativo = muestra.pose.angulo + muestra.angulo - anguloInicioGiro;
+  int decimas = decimasDeGrado(relativo);
+  int angulo = (decimas + 5) / 10;
+  muestrasGiro++;
+
+  // Una línea por muestra: solo con NIVEL_REGISTRO de depuración
+  REG_DEPURAR("→ Ángulo: %d.%d mm: %d", decimas / 10, decimas % 10, dist);
+
+  // Buscar la mejor dirección para moverse
+  if (clasificarMuestra(muestra, rangoMinimo, rangoMaximo) != MUESTRA_IMPACTO) return;
+  if (dist > mayorDistancia) {
+    mayorDistancia = dist;
+    mejorAngulo = angulo % 360;
+  }
+  int sector = (angulo % 360) / (360 / SECTORES_ESCANEO);
+  if (dist > distanciaSector[sector]) {
+    distanciaSector[sector] = dist;
+    anguloSector[sector] = angulo % 360;
+  }
+  // El chasis gira en el lugar: todas las muestras salen del mismo punto
+  int grado = ((decimasDeGrado(muestra.pose.angulo + muestra.angulo) + 5) / 10) % 360;
+  if (impactoEscaneo[grado] == 0 || dist < impactoEscaneo[grado]) impactoEscaneo[grado] = dist;
+  origenEscaneoX = mmDesdeMicras(muestra.pose.x);
+  origenEscaneoY = mmDesdeMicras(muestra.pose.y);
+}
 
-    // Buscar la mejor dirección para moverse
-    if (!sensor.timeoutOccurred() && dist > mayorDistancia && dist < 2000) {
-      mayorDistancia = dist;
-      mejorAngulo = angulo;
+// Pasa las muestras pendientes del anillo al mapa que lee el servidor web
+void drenarMuestras() {
+  MuestraRango muestra;
+  if (!anilloMuestras.extraer(muestra)) return; // Se llama cada tick: sin muestras no se traza
+  TRAZAR_INICIO(TRAZA_MAPA);
+  do {
+    int dist = muestra.distancia;
+    muestrasIntegradas++;
+
+    // Rayo en coordenadas absolutas, con la pose del momento de la muestra
+    AnguloBinario anguloAbsoluto = muestra.angulo + muestra.pose.angulo;
+
+    // Actualizar último escaneo
+    ultimoAngulo = anguloAbsoluto;
+    ultimaDistancia = dist;
+
+    // Lecturas muy cercanas o con estado inválido no se integran. Fuera de
+    // rango no hay obstáculo, pero sí espacio libre hasta el alcance del sensor
+    ClaseMuestra clase = clasificarMuestra(muestra, rangoMinimo, rangoMaximo);
+    if (clase == MUESTRA_DESCARTADA) {
+      if (muestra.estado != ESTADO_RANGO_VALIDO) metricas.muestrasInvalidas++;
+      continue;
     }
-    
-    delay(200); // Escanea cada 200 milisegundos
+    bool impacto = clase == MUESTRA_IMPACTO;
+    if (!impacto) dist = rangoMaximo;
+
+    // Con la tabla de trigonometria.h: el ESP32 no tiene FPU para double
+    int32_t dx, dy;
+    polarACartesiano(dist, anguloAbsoluto, dx, dy);
+    int32_t x0 = mmDesdeMicras(muestra.pose.x), y0 = mmDesdeMicras(muestra.pose.y);
+    mapa.integrarRayo(x0, y0, x0 + dx, y0 + dy, impacto);
+  } while (anilloMuestras.extraer(muestra));
+  TRAZAR_FIN(TRAZA_MAPA);
+
+  if (mapa.totalOcupadas() != numPuntos) {
+    numPuntos = mapa.totalOcupadas();
   }
-  
-  Serial.println("Escaneo completado. Mejor dirección: " + String(mejorAngulo) + "° (" + String(mayorDistancia) + "mm)");
+}
+
+// Posición del motor que orienta el haz; la lee el ISR del sensor al avisar cada medición
+int32_t IRAM_ATTR pasosSensor() {
+#if USAR_RADAR
+  return posicionEje(EJE_RADAR);
+#else
+  return 0; // El sensor va fijo al chasis
+#endif
+}
+
+// Dirección del haz respecto del frente del robot para esa posición
+AnguloBinario anguloSensorEnPasos(int32_t pasos) {
+#if USAR_RADAR
+  return anguloBinarioRadarDesdePasos(pasos);
+#else
+  return 0;
+#endif
+}
+
+long pasosParaGirar(int angulo) {
+  return 6.516 * map(angulo, 0, 360, 0, 2048);
 }
 
 void girarRobot(int angulo) {
   if (angulo == 0) return; // No girar si el ángulo es 0
   
-  int pasosGiro = 6.516 * map(angulo, 0, 360, 0, 2048);
-
-  Serial.println("Girará " + String(angulo) + "° Tomará " + String(pasosGiro) + " pasos");
+  int pasosGiro = pasosParaGirar(angulo);
 
-  motor1.moveTo(motor1.currentPosition() - pasosGiro); // Izquierda atrás
-  motor2.moveTo(motor2.currentPosition() + pasosGiro); // Derecha adelante
+  REG_INFO("Girará %d° Tomará %d pasos", angulo, pasosGiro);
 
-  while (motor1.distanceToGo() != 0 || motor2.distanceToGo() != 0) {
-    motor1.run();
-    motor2.run();
-  }
-    
-  // Actualizar ángulo del robot
-  robotAngulo += angulo;
-  if (robotAngulo >= 360) robotAngulo -= 360;
-  if (robotAngulo < 0) robotAngulo += 360;
+  // Izquierda atrás, derecha adelante; la tarea duerme mientras gira
+  uint32_t inicio = micros();
+  encolarGiro(angulo);
+  esperarMovimiento(inicio);
   
-  Serial.println("Robot giró " + String(angulo) + "°. Ángulo actual: " + String(robotAngulo) + "°");
+  REG_INFO("Robot giró %d°", angulo);
+  reportarPose();
 }
 
 void avanzarRobot(int mm) {
   if (mm <= 0) {
-    Serial.println("No hay espacio seguro para avanzar");
+    REG_INFO("No hay espacio seguro para avanzar");
     return;
   }
   
   int pasosAvance = 3.012 * map(mm, 0, 360, 0, 2048);
-  Serial.println("Debe avanzar " + String(mm) + "mm Tomará " + String(pasosAvance) + " pasos");
+  REG_INFO("Debe avanzar %dmm Tomará %d pasos", mm, pasosAvance);
 
-  motor1.moveTo(motor1.currentPosition() + pasosAvance);
-  motor2.moveTo(motor2.currentPosition() + pasosAvance);
+  uint32_t inicio = micros();
+  encolarRecta(mm);
+  esperarMovimiento(inicio);
+  
+  REG_INFO("Avance completado");
+  reportarPose();
+}
 
-  while (motor1.distanceToGo() != 0 && motor2.distanceToGo() != 0) {
-    motor1.run();
-    motor2.run();
+// Gira hacia "angulo" y avanza "mm" como una sola trayectoria. Los giros
+// chicos se hacen sobre la rueda interior, que encadena con la recta sin
+// detenerse; los demás en el lugar para no alejarse del punto escaneado.
+// El avance se recorta a lo que el chasis tiene libre en el mapa.
+void irHacia(int angulo, int mm) {
+  float giro = angulo > 180 ? angulo - 360 : angulo; // Por el lado más corto
+  uint32_t inicio = micros();
+
+  // Pivotear sobre la rueda interior adelanta el centro MEDIA_VIA_MM·sen(giro)
+  // en la nueva dirección y lo corre MEDIA_VIA_MM·(1 - cos(giro)) hacia
+  // afuera de la línea medida. Solo se pivotea si ese adelanto entra en lo
+  // libre y el corrimiento es chico; si no, se gira en el lugar.
+  float radianes = fabsf(giro) * PI / 180.0f;
+  float adelanto = MEDIA_VIA_MM * sinf(radianes);
+  float corrimiento = MEDIA_VIA_MM * (1 - cosf(radianes));
+  PoseRobot pose = instantaneaPose();
+  int32_t x = mmDesdeMicras(pose.x), y = mmDesdeMicras(pose.y);
+  AnguloBinario rumbo = pose.angulo + anguloBinarioDesdeGrados(giro);
+  if (giro != 0 && mm > adelanto && corrimiento <= corrimientoMaximoPivote) {
+    encolarPivote(giro);
+    mm -= (int)ceilf(adelanto);
+    // Donde queda el centro: adelanto en el rumbo nuevo, corrimiento hacia afuera del giro
+    int32_t dx, dy;
+    polarACartesiano(lroundf(adelanto), rumbo, dx, dy);
+    x += dx;
+    y += dy;
+    polarACartesiano(lroundf(corrimiento), rumbo + (giro > 0 ? -16384 : 16384), dx, dy);
+    x += dx;
+    y += dy;
+  } else if (giro != 0) {
+    encolarGiro(giro);
   }
-    
-  // Actualizar posición del robot
-  float radianes = robotAngulo * 3.14159265 / 180.0;
-  robotX += mm * cos(radianes);
-  robotY += mm * sin(radianes);
-  
-  Serial.println("Avance completado");
-  Serial.println("Posición robot: X=" + String(robotX) + " Y=" + String(robotY) + " Ángulo=" + String(robotAngulo) + "°");
+
+  int libre = avanceLibre(x, y, rumbo, mm);
+  if (libre < mm) {
+    REG_INFO("El chasis rozaría el mapa: avance de %dmm recortado a %dmm", mm, libre);
+    mm = libre;
+  }
+  if (mm > 0) {
+    REG_INFO("Girará %.0f° y avanzará %dmm", giro, mm);
+    encolarRecta(mm);
+  } else {
+    REG_INFO("No hay espacio seguro para avanzar");
+  }
+  esperarMovimiento(inicio);
+
+  reportarPose();
+}
+
+// Cuánto de "mm" puede avanzar el centro desde (x, y) en "rumbo" antes de
+// que el chasis (radio margenSeguridad) toque una celda ocupada del mapa o
+// un impacto del último escaneo. El escaneo elige la dirección por la línea
+// central: una pared vista de costado queda mucho más cerca del cuerpo que
+// del haz. Los obstáculos que quedan detrás no cuentan, para poder alejarse
+// de una pared que ya está cerca. Lee el mapa que escribe TaskSERVIDOR; una
+// celda a medio actualizar solo cambia el recorte en una celda.
+int avanceLibre(int32_t x, int32_t y, AnguloBinario rumbo, int mm) {
+  int32_t coseno = cosenoQ15(rumbo), seno = senoQ15(rumbo);
+  int32_t libre = mm;
+  auto recortar = [&](int32_t ox, int32_t oy) {
+    int32_t dx = ox - x, dy = oy - y;
+    int32_t adelante = (dx * coseno + dy * seno) >> 15;
+    int32_t costado = (dy * coseno - dx * seno) >> 15;
+    if (adelante <= 0 || abs(costado) >= margenSeguridad) return;
+    int32_t toque = adelante - (int32_t)sqrtf((float)(margenSeguridad * margenSeguridad - costado * costado));
+    if (toque < libre) libre = toque > 0 ? toque : 0;
+  };
+  mapa.recorrerOcupadas(recortar);
+  for (int grado = 0; grado < 360; grado++) {
+    if (impactoEscaneo[grado] == 0) continue;
+    int32_t dx, dy;
+    polarACartesiano(impactoEscaneo[grado], anguloBinarioDesdeGrados(grado), dx, dy);
+    recortar(origenEscaneoX + dx, origenEscaneoY + dy);
+  }
+  return libre;
+}
+
+// Hasta que las ruedas terminan y la odometría alcanzó la pose final
+void esperarMovimiento(uint32_t inicioUs) {
+  TRAZAR_INICIO(TRAZA_MOVIMIENTO);
+  esperarRuedas();
+  esperarOdometria();
+  TRAZAR_FIN(TRAZA_MOVIMIENTO);
+  metricas.movimiento.observar(micros() - inicioUs);
 }
 
-void TestHwm(char *taskName) {
-  static int stack_hwm, stack_hwm_temp;
+// Pose en mm y décimas de grado, sin float
+void reportarPose() {
+  PoseRobot pose = instantaneaPose();
+  int decimas = decimasDeGrado(pose.angulo);
+  REG_INFO("Posición robot: X=%ld Y=%ld Ángulo=%d.%d°", (long)mmDesdeMicras(pose.x),
+           (long)mmDesdeMicras(pose.y), decimas / 10, decimas % 10);
+}
 
-  stack_hwm_temp = uxTaskGetStackHighWaterMark(nullptr);
-  if (!stack_hwm || (stack_hwm_temp < stack_hwm)) {
-    stack_hwm = stack_hwm_temp;
-    Serial.printf("%s has stack hwm %u\n", taskName, stack_hwm);
+// Costo de coordinación del ciclo y estado del heap (debe quedar estable)
+void reportarCiclo(const OrdenCiclo &orden, uint32_t despertarUs) {
+  uint32_t arranque = max(arranqueEscaneoUs, arranqueGiroUs) - orden.enviadaUs;
+  uint32_t aviso = despertarUs - max(finEscaneoUs, finGiroUs);
+  REG_INFO("Ciclo %u: arranque %u us, aviso %u us, heap libre %u (mínimo %u)",
+           (unsigned)orden.ciclo, (unsigned)arranque, (unsigned)aviso,
+           (unsigned)ESP.getFreeHeap(), (unsigned)ESP.getMinFreeHeap());
+  // Lo que TaskMUESTRAS tarda por muestra, incluido el registro
+  uint32_t n = muestrasProcesadas.exchange(0);
+  uint32_t us = tiempoMuestrasUs.exchange(0);
+  if (n > 0) {
+    REG_INFO("Muestras: %u, %u us por muestra, %u líneas de registro descartadas",
+             (unsigned)n, (unsigned)(us / n), (unsigned)lineasDescartadas.load());
   }
 }
 
 void TaskESCANEO(void *pvParameters) {
-  escanearYBuscar();
-  
-  xSemaphoreTake(xSemaphore, portMAX_DELAY);
-  tareasTerminadas++;
-  xSemaphoreGive(xSemaphore);
-  
-  vTaskDelete(NULL);
+  OrdenCiclo orden;
+  for (;;) {
+    if (xQueueReceive(colaEscaneo, &orden, portMAX_DELAY) != pdTRUE) continue;
+    arranqueEscaneoUs = micros();
+    TRAZAR_INICIO(TRAZA_ESCANEO);
+    escanearYBuscar();
+    TRAZAR_FIN(TRAZA_ESCANEO);
+    finEscaneoUs = micros();
+    metricas.escaneo.observar(finEscaneoUs - arranqueEscaneoUs);
+    barreraCiclo.avisar(PARTICIPANTE_ESCANEO);
+  }
+}
+
+// Servidor web, eventos y mapa: nunca espera al escaneo ni al movimiento
+void TaskSERVIDOR(void *pvParameters) {
+  for (;;) {
+    drenarMuestras();
+    loopServidorWeb();
+    atenderEventos();
+    if (pedirReportePasadas.exchange(false)) {
+      reportarPasadas("Web durante el ciclo");
+    }
+    vTaskDelay(1);
+  }
+}
+
+// Lleva cada muestra del lector (ya con su pose) al mapa y, durante el
+// giro de escaneo, a la búsqueda de la mejor dirección
+void TaskMUESTRAS(void *pvParameters) {
+  UBaseType_t enColaAnterior = 0;
+  for (;;) {
+    MuestraRango muestra;
+    if (xQueueReceive(colaMuestras, &muestra, portMAX_DELAY) != pdTRUE) {
+      continue;
+    }
+    // Las mediciones que quedaron en la cola de antes del giro no cuentan para él
+    bool enGiro = giroEscaneoEnCurso && (int32_t)(muestra.tiempoUs - inicioGiroUs) >= 0;
+#if !ESCANEO_CONTINUO
+    if (!enGiro) continue;
+#endif
+
+    uint32_t inicio = micros();
+    TRAZAR_INICIO(TRAZA_MUESTRA);
+    // El mapa se actualiza del lado del consumidor
+    if (!anilloMuestras.insertar(muestra)) {
+      REG_AVISO("Anillo de muestras lleno, muestra descartada");
+    }
+    if (enGiro) buscarDireccion(muestra);
+    TRAZAR_FIN(TRAZA_MUESTRA);
+    UBaseType_t enCola = uxQueueMessagesWaiting(colaMuestras);
+    if (enCola != enColaAnterior) TRAZAR_VALOR(TRAZA_COLA_MUESTRAS, enCola); // Casi siempre 0: solo los cambios
+    enColaAnterior = enCola;
+    uint32_t duracion = micros() - inicio;
+    tiempoMuestrasUs += duracion;
+    muestrasProcesadas++;
+    metricas.muestra.observar(duracion);
+    metricas.muestras++;
+  }
 }
 
 void TaskROTARCOM(void *pvParameters) {
-  girarRobot(360);
-  
-  xSemaphoreTake(xSemaphore, portMAX_DELAY);
-  tareasTerminadas++;
-  xSemaphoreGive(xSemaphore);
-  
-  vTaskDelete(NULL);
-}
\ No newline at end of file
+  OrdenCiclo orden;
+  for (;;) {
+    if (xQueueReceive(colaGiro, &orden, portMAX_DELAY) != pdTRUE) continue;
+    arranqueGiroUs = micros();
+    TRAZAR_INICIO(TRAZA_GIRO);
+#if USAR_RADAR
+    // El radar cubre los 360° sin mover el chasis; si está quieto (desde
+    // /radar), el haz queda al frente y se gira el chasis como sin radar
+    if (!esperarPasadaRadar()) girarRobot(360);
+#else
+    girarRobot(360);
+#endif
+    TRAZAR_FIN(TRAZA_GIRO);
+    giroEscaneoEnCurso = false;
+    finGiroUs = micros();
+    barreraCiclo.avisar(PARTICIPANTE_GIRO);
+  }
+}
@@ -0,0 +1,154 @@
+#ifndef MAPA_OCUPACION_H
+#define MAPA_OCUPACION_H
+
+#include <stdint.h>
+#include <stdlib.h>
+
+// Grilla de ocupación en log-odds con memoria fija. Cada celda guarda un
+// int8: positivo = probablemente ocupada, negativo = probablemente libre,
+// 0 = sin información. Cada lectura recorre el rayo desde el robot hasta el
+// impacto (Bresenham), baja las celdas atravesadas y sube la del impacto,
+// así que volver a ver la misma pared refuerza celdas en lugar de sumar puntos.
+//
+// Cada vez que una celda pasa a ocupada o deja de estarlo se anota en un
+// registro circular con número de secuencia, para que los clientes pidan
+// solo lo que cambió desde la última vez.
+template <int ANCHO, int ALTO, int RESOLUCION_MM, int CAMBIOS = 1024>
+class MapaOcupacion {
+    static_assert(ANCHO * ALTO <= 0x8000, "El índice de celda debe caber en 15 bits");
+    static_assert((CAMBIOS & (CAMBIOS - 1)) == 0, "CAMBIOS debe ser potencia de 2");
+
+public:
+    static constexpr int8_t INCREMENTO_OCUPADA = 9;
+    static constexpr int8_t DECREMENTO_LIBRE = 4;
+    static constexpr int8_t LIMITE = 100;
+    static constexpr int8_t UMBRAL_OCUPADA = 30;
+    static constexpr int8_t UMBRAL_LIBRE = -30;
+
+    // Integra una lectura tomada desde (x0, y0) que termina en (x1, y1), en mm.
+    // Sin impacto (fuera de rango) solo se marca el espacio libre del rayo.
+    void integrarRayo(int32_t x0, int32_t y0, int32_t x1, int32_t y1, bool impacto) {
+        int cx = celdaX(x0), cy = celdaY(y0);
+        int fx = celdaX(x1), fy = celdaY(y1);
+
+        int dx = abs(fx - cx), sx = cx < fx ? 1 : -1;
+        int dy = -abs(fy - cy), sy = cy < fy ? 1 : -1;
+        int error = dx + dy;
+
+        while (cx != fx || cy != fy) {
+            if (!dentro(cx, cy)) return; // El rayo salió del mapa
+            ajustar(cx, cy, -DECREMENTO_LIBRE);
+            int e2 = 2 * error;
+            if (e2 >= dy) { error += dy; cx += sx; }
+            if (e2 <= dx) { error += dx; cy += sy; }
+        }
+        if (dentro(fx, fy)) {
+            ajustar(fx, fy, impacto ? INCREMENTO_OCUPADA : -DECREMENTO_LIBRE);
+        }
+    }
+
+    int8_t valor(int cx, int cy) const { return celdas[cy][cx]; }
+    bool ocupada(int cx, int cy) const { return celdas[cy][cx] >= UMBRAL_OCUPADA; }
+    bool libre(int cx, int cy) const { return celdas[cy][cx] <= UMBRAL_LIBRE; }
+    int totalOcupadas() const { return ocupadas; }
+
+    // Estado actual de la celda que contiene el punto (x, y) en mm
+    bool ocupadaEn(int32_t x, int32_t y) const {
+        int cx = celdaX(x), cy = celdaY(y);
+        return dentro(cx, cy) && ocupada(cx, cy);
+    }
+
+    // Centro de una celda en mm (coordenadas del mundo, origen en el centro del mapa)
+    static int32_t centroX(int cx) { return (int32_t)(cx - ANCHO / 2) * RESOLUCION_MM + RESOLUCION_MM / 2; }
+    static int32_t centroY(int cy) { return (int32_t)(cy - ALTO / 2) * RESOLUCION_MM + RESOLUCION_MM / 2; }
+
+    // Llama f(xMm, yMm) por cada celda ocupada
+    template <typename F>
+    void recorrerOcupadas(F f) const {
+        for (int cy = 0; cy < ALTO; cy++) {
+            for (int cx = 0; cx < ANCHO; cx++) {
+                if (ocupada(cx, cy)) f(centroX(cx), centroY(cy));
+            }
+        }
+    }
+
+    // Como recorrerOcupadas pero de a tandas: empieza en la celda "desde"
+    // (índice fila por fila), corta después de "maximo" celdas ocupadas y
+    // devuelve el índice donde seguir, o ANCHO * ALTO si llegó al final
+    template <typename F>
+    int recorrerOcupadasDesde(int desde, int maximo, F f) const {
+        int celda = desde;
+        for (; celda < ANCHO * ALTO && maximo > 0; celda++) {
+            int cx = celda % ANCHO, cy = celda / ANCHO;
+            if (ocupada(cx, cy)) {
+                f(centroX(cx), centroY(cy));
+                maximo--;
+            }
+        }
+        return celda;
+    }
+
+    // Número de cambios registrados desde el arranque
+    uint32_t secuencia() const { return cambios; }
+
+    // False si los cambios posteriores a "desde" ya se sobrescribieron (o
+    // "desde" es de otro arranque): el cliente debe pedir el mapa completo
+    bool hayCambiosDesde(uint32_t desde) const {
+        return desde <= cambios && cambios - desde <= CAMBIOS;
+    }
+
+    // Llama f(xMm, yMm, ocupada) por cada cambio posterior a "desde", en orden
+    template <typename F>
+    bool recorrerCambiosDesde(uint32_t desde, F f) const {
+        return recorrerCambiosEntre(desde, cambios, f);
+    }
+
+    // Lo mismo, solo los cambios anteriores a "hasta"
+    template <typename F>
+    bool recorrerCambiosEntre(uint32_t desde, uint32_t hasta, F f) const {
+        if (!hayCambiosDesde(desde) || hasta < desde || hasta > cambios) return false;
+        for (uint32_t s = desde; s < hasta; s++) {
+            uint16_t entrada = registro[s & (CAMBIOS - 1)];
+            int celda = entrada & 0x7FFF;
+            f(centroX(celda % ANCHO), centroY(celda / ANCHO), (entrada & 0x8000) != 0);
+        }
+        return true;
+    }
+
+    static constexpr int ancho() { return ANCHO; }
+    static constexpr int alto() { return ALTO; }
+    static constexpr int resolucionMm() { return RESOLUCION_MM; }
+
+private:
+    int8_t celdas[ALTO][ANCHO] = {};
+    int ocupadas = 0;
+    uint16_t registro[CAMBIOS] = {}; // bit 15 = ocupada, bits 0-14 = índice de celda
+    uint32_t cambios = 0;
+
+    static int celdaX(int32_t mm) { return piso(mm, RESOLUCION_MM) + ANCHO / 2; }
+    static int celdaY(int32_t mm) { return piso(mm, RESOLUCION_MM) + ALTO / 2; }
+    static int piso(int32_t a, int32_t b) { return a >= 0 ? a / b : -((-a + b - 1) / b); }
+    static bool dentro(int cx, int cy) { return cx >= 0 && cx < ANCHO && cy >= 0 && cy < ALTO; }
+
+    void ajustar(int cx, int cy, int delta) {
+        int8_t &celda = celdas[cy][cx];
+        bool antes = celda >= UMBRAL_OCUPADA;
+        int nuevo = celda + delta;
+        if (nuevo > LIMITE) nuevo = LIMITE;
+        if (nuevo < -LIMITE) nuevo = -LIMITE;
+        celda = (int8_t)nuevo;
+        bool despues = celda >= UMBRAL_OCUPADA;
+        if (antes != despues) {
+            ocupadas += despues ? 1 : -1;
+            registro[cambios & (CAMBIOS - 1)] = (uint16_t)(cy * ANCHO + cx) | (despues ? 0x8000 : 0);
+            cambios++;
+        }
+    }
+};
+
+// Mapa del robot: 160 x 160 celdas de 50 mm (8 m x 8 m, 25 KB + 2 KB de registro)
+#define MAPA_CELDAS 160
+#define MAPA_RESOLUCION_MM 50
+typedef MapaOcupacion<MAPA_CELDAS, MAPA_CELDAS, MAPA_RESOLUCION_MM> MapaRobot;
+
+#endif // MAPA_OCUPACION_H
@@ -0,0 +1,202 @@
+#ifndef METRICAS_H
+#define METRICAS_H
+
+#include <Arduino.h>
+#include <WiFi.h>
+#include <atomic>
+#include <stdio.h>
+#include <string.h>
+#include "hal.h"
+#include "anillospsc.h"
+#include "lectorvl53l0x.h"
+#include "mapaocupacion.h"
+#include "registro.h"
+
+// Contadores e histogramas de rendimiento, publicados en /metrics con el
+// formato de texto de Prometheus. Un contador es un fetch_add atómico de 32
+// bits; un histograma suma una cubeta y el total en µs (64 bits: con 32 daría
+// la vuelta a los ~71 minutos sumados) dentro de su propia sección crítica,
+// una vez por observación. Ninguno usa heap, así que se pueden llamar desde
+// cualquier tarea; el resto (heap, WiFi, tareas) se lee recién al armar la
+// respuesta.
+
+// Histograma con límites fijos en µs (12 cubetas más la de +Inf)
+#define CUBETAS_HISTOGRAMA 12
+
+// Procesar una muestra
+const uint32_t LIMITES_CORTOS_US[CUBETAS_HISTOGRAMA] = {
+    5, 10, 20, 50, 100, 200, 500, 1000, 2000, 5000, 10000, 50000};
+// Un pedido HTTP
+const uint32_t LIMITES_MEDIOS_US[CUBETAS_HISTOGRAMA] = {
+    100, 200, 500, 1000, 2000, 5000, 10000, 20000, 50000, 100000, 200000, 1000000};
+// Ciclo de loop(), escaneo, movimiento
+const uint32_t LIMITES_LARGOS_US[CUBETAS_HISTOGRAMA] = {
+    500000, 1000000, 2000000, 3000000, 5000000, 7500000,
+    10000000, 15000000, 20000000, 30000000, 60000000, 120000000};
+
+// Cubetas y suma leídas juntas: _count y _sum siempre coinciden
+struct InstantaneaHistograma {
+    uint32_t cuentas[CUBETAS_HISTOGRAMA + 1];
+    uint64_t sumaUs;
+};
+
+class HistogramaMetrica {
+public:
+    explicit HistogramaMetrica(const uint32_t *limitesUs) : limites(limitesUs) {}
+
+    void observar(uint32_t us) {
+        int i = 0;
+        while (i < CUBETAS_HISTOGRAMA && us > limites[i]) i++;
+        portENTER_CRITICAL(&candado);
+        cuentas[i]++;
+        sumaUs += us;
+        portEXIT_CRITICAL(&candado);
+    }
+
+    InstantaneaHistograma instantanea() const {
+        InstantaneaHistograma copia;
+        portENTER_CRITICAL(&candado);
+        memcpy(copia.cuentas, cuentas, sizeof(cuentas));
+        copia.sumaUs = sumaUs;
+        portEXIT_CRITICAL(&candado);
+        return copia;
+    }
+
+    const uint32_t *limites;
+
+private:
+    mutable portMUX_TYPE candado = portMUX_INITIALIZER_UNLOCKED;
+    uint32_t cuentas[CUBETAS_HISTOGRAMA + 1] = {};
+    uint64_t sumaUs = 0;
+};
+
+struct Metricas {
+    HistogramaMetrica cicloLoop{LIMITES_LARGOS_US};
+    HistogramaMetrica escaneo{LIMITES_LARGOS_US};
+    HistogramaMetrica movimiento{LIMITES_LARGOS_US};
+    HistogramaMetrica muestra{LIMITES_CORTOS_US};
+    HistogramaMetrica pedidoHttp{LIMITES_MEDIOS_US};
+    std::atomic<uint32_t> muestras{0};
+    std::atomic<uint32_t> muestrasInvalidas{0};
+    std::atomic<uint32_t> ciclosVencidos{0};
+};
+
+Metricas metricas;
+
+// Tareas cuya pila se informa (uxTaskGetStackHighWaterMark). Se registran
+// todas en setup() antes de crear TaskSERVIDOR, que las lee sin candado.
+#define MAX_TAREAS_VIGILADAS 12
+TaskHandle_t tareasVigiladas[MAX_TAREAS_VIGILADAS];
+int numTareasVigiladas = 0;
+
+void vigilarTarea(TaskHandle_t tarea) {
+    if (tarea != NULL && numTareasVigiladas < MAX_TAREAS_VIGILADAS) tareasVigiladas[numTareasVigiladas++] = tarea;
+}
+
+// Para crear una tarea ya vigilada: xTaskCreatePinnedToCore(..., nuevaTareaVigilada(), nucleo)
+TaskHandle_t *nuevaTareaVigilada() {
+    static TaskHandle_t descartada;
+    return numTareasVigiladas < MAX_TAREAS_VIGILADAS ? &tareasVigiladas[numTareasVigiladas++] : &descartada;
+}
+
+// Variables externas
+extern MapaRobot mapa;
+extern AnilloSPSC<MuestraRango, 128> anilloMuestras;
+extern std::atomic<uint32_t> muestrasIntegradas;
+
+// --- Formato de texto de Prometheus ---
+
+template <typename Escritor>
+void agregarSegundos(Escritor &w, uint64_t us) {
+    char numero[24];
+    int n = snprintf(numero, sizeof(numero), "%lu.%06lu", (unsigned long)(us / 1000000), (unsigned long)(us % 1000000));
+    w.agregar(numero, n);
+}
+
+template <typename Escritor>
+void agregarCabeceraMetrica(Escritor &w, const char *nombre, const char *tipo, const char *ayuda) {
+    w.agregar("# HELP "); w.agregar(nombre); w.agregar(' '); w.agregar(ayuda);
+    w.agregar("\n# TYPE "); w.agregar(nombre); w.agregar(' '); w.agregar(tipo); w.agregar('\n');
+}
+
+template <typename Escritor>
+void agregarValorMetrica(Escritor &w, const char *nombre, const char *tipo, const char *ayuda, long valor) {
+    agregarCabeceraMetrica(w, nombre, tipo, ayuda);
+    w.agregar(nombre); w.agregar(' '); w.agregarEntero(valor); w.agregar('\n');
+}
+
+template <typename Escritor>
+void agregarHistograma(Escritor &w, const char *nombre, const char *ayuda, const HistogramaMetrica &h) {
+    agregarCabeceraMetrica(w, nombre, "histogram", ayuda);
+    InstantaneaHistograma copia = h.instantanea();
+    uint32_t acumulado = 0;
+    for (int i = 0; i <= CUBETAS_HISTOGRAMA; i++) {
+        acumulado += copia.cuentas[i];
+        w.agregar(nombre); w.agregar("_bucket{le=\"");
+        if (i < CUBETAS_HISTOGRAMA) {
+            agregarSegundos(w, h.limites[i]);
+        } else {
+            w.agregar("+Inf");
+        }
+        w.agregar("\"} "); w.agregarNatural(acumulado); w.agregar('\n');
+    }
+    w.agregar(nombre); w.agregar("_sum "); agregarSegundos(w, copia.sumaUs); w.agregar('\n');
+    w.agregar(nombre); w.agregar("_count "); w.agregarNatural(acumulado); w.agregar('\n');
+}
+
+template <typename Escritor>
+void agregarEtiquetaTarea(Escritor &w, const char *nombre, const char *tarea) {
+    w.agregar(nombre); w.agregar("{tarea=\""); w.agregar(tarea); w.agregar("\"} ");
+}
+
+template <typename Escritor>
+void escribirMetricas(Escritor &w) {
+    agregarHistograma(w, "robot_ciclo_loop_segundos", "Tiempo entre dos vueltas de loop() (escaneo y movimiento)", metricas.cicloLoop);
+    agregarHistograma(w, "robot_escaneo_segundos", "Duración de cada escaneo de 360°", metricas.escaneo);
+    agregarHistograma(w, "robot_movimiento_segundos", "Duración de cada giro o avance del robot", metricas.movimiento);
+    agregarHistograma(w, "robot_muestra_segundos", "Tiempo de TaskMUESTRAS por muestra", metricas.muestra);
+    agregarHistograma(w, "robot_pedido_http_segundos", "Tiempo de cada handler del servidor web", metricas.pedidoHttp);
+
+    agregarValorMetrica(w, "robot_muestras_total", "counter", "Muestras del sensor procesadas", metricas.muestras.load());
+    agregarValorMetrica(w, "robot_muestras_integradas_total", "counter", "Muestras llevadas al mapa", muestrasIntegradas.load());
+    agregarCabeceraMetrica(w, "robot_muestras_descartadas_total", "counter", "Muestras perdidas por una cola o anillo lleno");
+    w.agregar("robot_muestras_descartadas_total{etapa=\"lector\"} "); w.agregarNatural(muestrasDescartadas); w.agregar('\n');
+    w.agregar("robot_muestras_descartadas_total{etapa=\"anillo\"} "); w.agregarNatural(anilloMuestras.totalDescartados()); w.agregar('\n');
+    agregarValorMetrica(w, "robot_muestras_invalidas_total", "counter", "Muestras con estado de rango inválido, fuera del mapa", metricas.muestrasInvalidas.load());
+    agregarValorMetrica(w, "robot_timeouts_sensor_total", "counter", "Esperas del lector sin medición del sensor", timeoutsSensor);
+    agregarValorMetrica(w, "robot_ciclos_vencidos_total", "counter", "Ciclos de escaneo que no terminaron a tiempo", metricas.ciclosVencidos.load());
+    agregarValorMetrica(w, "robot_registro_lineas_descartadas_total", "counter", "Líneas de registro perdidas con el anillo lleno", lineasDescartadas.load());
+    agregarValorMetrica(w, "robot_mapa_celdas_ocupadas", "gauge", "Celdas ocupadas en el mapa", mapa.totalOcupadas());
+
+    agregarValorMetrica(w, "robot_heap_libre_bytes", "gauge", "Heap libre", ESP.getFreeHeap());
+    agregarValorMetrica(w, "robot_heap_minimo_bytes", "gauge", "Menor heap libre desde el arranque", ESP.getMinFreeHeap());
+    agregarValorMetrica(w, "robot_heap_bloque_mayor_bytes", "gauge", "Bloque libre más grande del heap", ESP.getMaxAllocHeap());
+    agregarCabeceraMetrica(w, "robot_encendido_segundos", "counter", "Tiempo desde el arranque");
+    w.agregar("robot_encendido_segundos "); agregarSegundos(w, halTiempoUs()); w.agregar('\n');
+    if (WiFi.status() == WL_CONNECTED) {
+        agregarValorMetrica(w, "robot_wifi_rssi_dbm", "gauge", "Señal de la red WiFi", WiFi.RSSI());
+    }
+
+    agregarCabeceraMetrica(w, "robot_tarea_pila_libre_bytes", "gauge", "Menor espacio libre que tuvo la pila de la tarea");
+    for (int i = 0; i < numTareasVigiladas; i++) {
+        if (tareasVigiladas[i] == NULL) continue;
+        agregarEtiquetaTarea(w, "robot_tarea_pila_libre_bytes", pcTaskGetName(tareasVigiladas[i]));
+        w.agregarNatural(uxTaskGetStackHighWaterMark(tareasVigiladas[i]));
+        w.agregar('\n');
+    }
+
+#if configUSE_TRACE_FACILITY && configGENERATE_RUN_TIME_STATS
+    // Tiempo de CPU de todas las tareas, las del sistema (IDLE, WiFi) incluidas.
+    // El contador es de 32 bits en µs: vuelve a cero cada ~71 minutos.
+    static TaskStatus_t estados[32];
+    UBaseType_t n = uxTaskGetSystemState(estados, 32, NULL);
+    agregarCabeceraMetrica(w, "robot_tarea_cpu_segundos_total", "counter", "Tiempo de CPU usado por la tarea");
+    for (UBaseType_t i = 0; i < n; i++) {
+        agregarEtiquetaTarea(w, "robot_tarea_cpu_segundos_total", estados[i].pcTaskName);
+        agregarSegundos(w, estados[i].ulRunTimeCounter);
+        w.agregar('\n');
+    }
+#endif
+}
+
+#endif // METRICAS_H
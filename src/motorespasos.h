@@ -0,0 +1,383 @@
+#ifndef MOTORES_PASOS_H
+#define MOTORES_PASOS_H
+
+#include <Arduino.h>
+#include <math.h>
+#include "hal.h"
+
+// Pasos de los 28BYJ-48 (FULL4WIRE) generados desde un temporizador de
+// hardware en lugar de llamar run() en un bucle. El ISR corre a frecuencia
+// fija y cada movimiento acumula su velocidad (pasos/s) hasta completar un
+// paso (DDA), así la temporización no depende de lo que haga el resto del sistema.
+//
+// El perfil trapezoidal se calcula una vez en configurarPerfil(): la tabla
+// rampa[k] es la velocidad permitida a k pasos del inicio o del final del
+// movimiento. El ISR solo suma, compara e indexa: nada de float.
+//
+// Las dos ruedas se mueven juntas por segmentos (pasos izquierda, pasos
+// derecha). La rueda con más pasos marca el ritmo y la otra la sigue con
+// Bresenham, así las dos empiezan y terminan a la vez en cada segmento.
+// Los segmentos consecutivos en los que ninguna rueda invierte el sentido
+// forman una cadena: la rampa cubre la cadena entera y no se frena entre ellos.
+//
+// Al terminar, el ISR avisa a la tarea que encoló el movimiento con un bit
+// en su notificación; la tarea espera bloqueada, sin consumir CPU.
+
+// Frecuencia del ISR: un paso puede retrasarse a lo sumo un tick (100 us)
+#define FRECUENCIA_TICK_HZ 10000
+#define NUM_EJES 3
+#define EJE_IZQUIERDO 0
+#define EJE_DERECHO 1
+#define EJE_RADAR 2
+#define LONGITUD_MAXIMA_RAMPA 1024
+#define LONGITUD_COLA_SEGMENTOS 8 // Potencia de 2
+
+// Bit de notificación al terminar cada segmento de las ruedas (los ejes sueltos usan 1 << eje)
+#define AVISO_RUEDAS (1UL << 31)
+
+struct EjePasos {
+    // Máscaras de cada fase para los dos bancos de GPIO (0-31 y 32-39)
+    uint32_t encender[4], apagar[4];
+    uint32_t encender1[4], apagar1[4];
+    volatile int32_t posicion;   // Pasos desde el arranque
+    // Movimiento propio del eje (moverEjeAsync); las ruedas usan la cola de segmentos
+    volatile uint32_t restantes;
+    uint32_t hechos;
+    int8_t direccion;
+    uint32_t velocidad;          // pasos/s del paso en curso
+    uint32_t acumulador;
+    uint32_t tope;               // Velocidad máxima propia (0 = la del perfil)
+    uint32_t pasosHastaTope;     // Pasos de rampa para llegar a "tope"
+    TaskHandle_t avisar;
+};
+
+struct SegmentoRuedas {
+    int32_t izquierda;  // Pasos con signo de cada rueda
+    int32_t derecha;
+    uint32_t maestro;   // Pasos de la rueda que más se mueve
+    bool iniciaCadena;  // Arranca desde parado (una rueda invierte el sentido)
+};
+
+// Estado de las ruedas que solo toca el ISR, o el código de la tarea con el candado
+struct TrayectoriaRuedas {
+    SegmentoRuedas segmentos[LONGITUD_COLA_SEGMENTOS];
+    volatile uint32_t leidos;    // Segmentos terminados
+    volatile uint32_t escritos;  // Segmentos encolados
+    bool enSegmento;
+    uint32_t pasoSegmento;
+    uint32_t errorIzquierda, errorDerecha;
+    uint32_t hechosCadena;       // Pasos del maestro desde que se arrancó parado
+    uint32_t restantesCadena;    // Pasos del maestro hasta la próxima parada
+    bool cadenaAbierta;          // Los segmentos encolados extienden la cadena en curso
+    uint32_t indiceRampa;        // Escalón de la rampa del paso en curso
+    uint32_t velocidad;
+    uint32_t acumulador;
+    TaskHandle_t avisar;
+};
+
+EjePasos ejes[NUM_EJES];
+TrayectoriaRuedas ruedas;
+uint16_t rampa[LONGITUD_MAXIMA_RAMPA];
+uint32_t longitudRampa = 0;
+uint32_t velocidadMaxima = 0;
+bool temporizadorActivo = false;
+portMUX_TYPE candadoMotores = portMUX_INITIALIZER_UNLOCKED;
+
+// Mismas salidas que AccelStepper::step4() para cada posición & 3
+static const uint8_t FASES_FULL4WIRE[4] = {0b0101, 0b0110, 0b1010, 0b1001};
+
+// Pines en el orden del constructor de AccelStepper (IN1, IN3, IN2, IN4)
+void configurarEje(int eje, uint8_t pin1, uint8_t pin2, uint8_t pin3, uint8_t pin4) {
+    EjePasos &e = ejes[eje];
+    const uint8_t pines[4] = {pin1, pin2, pin3, pin4};
+    for (int f = 0; f < 4; f++) {
+        e.encender[f] = e.apagar[f] = e.encender1[f] = e.apagar1[f] = 0;
+        for (int i = 0; i < 4; i++) {
+            bool alto = FASES_FULL4WIRE[f] & (1 << i);
+            if (pines[i] < 32) {
+                (alto ? e.encender[f] : e.apagar[f]) |= 1UL << pines[i];
+            } else {
+                (alto ? e.encender1[f] : e.apagar1[f]) |= 1UL << (pines[i] - 32);
+            }
+        }
+    }
+    for (int i = 0; i < 4; i++) pinMode(pines[i], OUTPUT);
+    e.posicion = 0;
+    e.restantes = 0;
+    e.tope = 0;
+    e.pasosHastaTope = LONGITUD_MAXIMA_RAMPA;
+    e.avisar = NULL;
+}
+
+// Limita la velocidad de un eje suelto por debajo de la del perfil (0 = sin límite).
+// Llamar después de configurarPerfil().
+void configurarVelocidadEje(int eje, uint32_t pasosPorSegundo) {
+    uint32_t k = 0;
+    if (pasosPorSegundo == 0) {
+        k = longitudRampa;
+    } else {
+        while (k < longitudRampa && rampa[k] < pasosPorSegundo) k++;
+    }
+    portENTER_CRITICAL(&candadoMotores);
+    ejes[eje].tope = pasosPorSegundo;
+    ejes[eje].pasosHastaTope = k;
+    portEXIT_CRITICAL(&candadoMotores);
+}
+
+// Velocidad máxima (pasos/s) y aceleración (pasos/s²). No llamar con motores en marcha.
+void configurarPerfil(float maxima, float aceleracion) {
+    if (maxima > FRECUENCIA_TICK_HZ) maxima = FRECUENCIA_TICK_HZ; // Un paso por tick como mucho
+    velocidadMaxima = (uint32_t)maxima;
+    uint32_t pasosRampa = (uint32_t)(maxima * maxima / (2.0f * aceleracion));
+    longitudRampa = pasosRampa < LONGITUD_MAXIMA_RAMPA ? pasosRampa : LONGITUD_MAXIMA_RAMPA;
+    for (uint32_t k = 0; k < longitudRampa; k++) {
+        // v² = 2·a·s, con s = k + 1 para que el primer paso no tenga velocidad 0
+        float v = sqrtf(2.0f * aceleracion * (k + 1));
+        rampa[k] = (uint16_t)(v < maxima ? v : maxima);
+    }
+}
+
+static inline uint32_t IRAM_ATTR velocidadRampa(uint32_t k) {
+    return k < longitudRampa ? rampa[k] : velocidadMaxima;
+}
+
+// Velocidad a "hechos" pasos del arranque con "restantes" pasos por delante
+static inline uint32_t IRAM_ATTR velocidadPerfil(uint32_t hechos, uint32_t restantes) {
+    // Distancia al borde más cercano: acelera y frena con la misma tabla
+    uint32_t hastaFin = restantes - 1;
+    return velocidadRampa(hechos < hastaFin ? hechos : hastaFin);
+}
+
+static inline void IRAM_ATTR darPaso(EjePasos &e, int8_t direccion) {
+    int32_t posicion = e.posicion + direccion;
+    e.posicion = posicion;
+    int f = posicion & 3;
+    halEscribirBobinas(e.encender[f], e.apagar[f], e.encender1[f], e.apagar1[f]);
+}
+
+// Toma el siguiente segmento de la cola. Si arranca una cadena, suma sus pasos.
+static bool IRAM_ATTR cargarSegmento() {
+    TrayectoriaRuedas &t = ruedas;
+    if (t.leidos == t.escritos) return false;
+    const SegmentoRuedas &s = t.segmentos[t.leidos & (LONGITUD_COLA_SEGMENTOS - 1)];
+    if (s.iniciaCadena || t.restantesCadena == 0) {
+        uint32_t total = s.maestro;
+        uint32_t i = t.leidos + 1;
+        while (i != t.escritos && !t.segmentos[i & (LONGITUD_COLA_SEGMENTOS - 1)].iniciaCadena) {
+            total += t.segmentos[i & (LONGITUD_COLA_SEGMENTOS - 1)].maestro;
+            i++;
+        }
+        t.cadenaAbierta = i == t.escritos;
+        t.hechosCadena = 0;
+        t.restantesCadena = total;
+        t.acumulador = 0;
+        t.indiceRampa = 0;
+        t.velocidad = velocidadRampa(0);
+    }
+    t.pasoSegmento = 0;
+    t.errorIzquierda = t.errorDerecha = s.maestro / 2;
+    t.enSegmento = true;
+    return true;
+}
+
+static inline void IRAM_ATTR avanzarRuedas(BaseType_t *despertar) {
+    TrayectoriaRuedas &t = ruedas;
+    if (!t.enSegmento && !cargarSegmento()) return;
+    t.acumulador += t.velocidad;
+    if (t.acumulador < FRECUENCIA_TICK_HZ) return;
+    t.acumulador -= FRECUENCIA_TICK_HZ;
+
+    const SegmentoRuedas &s = t.segmentos[t.leidos & (LONGITUD_COLA_SEGMENTOS - 1)];
+    t.errorIzquierda += abs(s.izquierda);
+    if (t.errorIzquierda >= s.maestro) {
+        t.errorIzquierda -= s.maestro;
+        darPaso(ejes[EJE_IZQUIERDO], s.izquierda > 0 ? 1 : -1);
+    }
+    t.errorDerecha += abs(s.derecha);
+    if (t.errorDerecha >= s.maestro) {
+        t.errorDerecha -= s.maestro;
+        darPaso(ejes[EJE_DERECHO], s.derecha > 0 ? 1 : -1);
+    }
+
+    t.hechosCadena++;
+    t.restantesCadena--;
+    if (t.restantesCadena > 0) {
+        // Como velocidadPerfil(), pero subiendo a lo sumo un escalón por paso:
+        // si se extiende una cadena que ya frenaba, vuelve a acelerar desde
+        // donde está en lugar de saltar a la velocidad que le tocaría
+        uint32_t hastaFin = t.restantesCadena - 1;
+        uint32_t k = t.hechosCadena < hastaFin ? t.hechosCadena : hastaFin;
+        if (k > t.indiceRampa + 1) k = t.indiceRampa + 1;
+        t.indiceRampa = k;
+        t.velocidad = velocidadRampa(k);
+    }
+
+    if (++t.pasoSegmento == s.maestro) {
+        t.leidos = t.leidos + 1;
+        t.enSegmento = false;
+        if (t.avisar != NULL) xTaskNotifyFromISR(t.avisar, AVISO_RUEDAS, eSetBits, despertar);
+    }
+}
+
+void IRAM_ATTR isrPasos() {
+    BaseType_t despertar = pdFALSE;
+    portENTER_CRITICAL_ISR(&candadoMotores);
+    avanzarRuedas(&despertar);
+    for (int i = 0; i < NUM_EJES; i++) {
+        EjePasos &e = ejes[i];
+        if (e.restantes == 0) continue;
+        e.acumulador += e.velocidad;
+        if (e.acumulador < FRECUENCIA_TICK_HZ) continue;
+        e.acumulador -= FRECUENCIA_TICK_HZ;
+
+        darPaso(e, e.direccion);
+        uint32_t restantes = e.restantes - 1;
+        e.restantes = restantes;
+        e.hechos++;
+
+        if (restantes > 0) {
+            e.velocidad = velocidadPerfil(e.hechos, restantes);
+            if (e.tope != 0 && e.velocidad > e.tope) e.velocidad = e.tope;
+        } else if (e.avisar != NULL) {
+            xTaskNotifyFromISR(e.avisar, 1UL << i, eSetBits, &despertar);
+        }
+    }
+    portEXIT_CRITICAL_ISR(&candadoMotores);
+    if (despertar) portYIELD_FROM_ISR();
+}
+
+void iniciarMotores() {
+    halIniciarTemporizadorPasos(FRECUENCIA_TICK_HZ, &isrPasos); // Se arranca con el primer movimiento
+    temporizadorActivo = false;
+}
+
+static void arrancarTemporizador() {
+    if (!temporizadorActivo) {
+        halArrancarTemporizadorPasos();
+        temporizadorActivo = true;
+    }
+}
+
+static bool ruedasEnMarcha() {
+    return ruedas.enSegmento || ruedas.leidos != ruedas.escritos;
+}
+
+// Con el candado tomado
+static void detenerTemporizadorSiQuietos() {
+    if (ruedasEnMarcha()) return;
+    for (int i = 0; i < NUM_EJES; i++) {
+        if (ejes[i].restantes != 0) return;
+    }
+    if (temporizadorActivo) {
+        halDetenerTemporizadorPasos();
+        temporizadorActivo = false;
+    }
+}
+
+// Un segmento continúa la cadena si ninguna rueda cambia de sentido
+static bool segmentosEncadenables(const SegmentoRuedas &a, const SegmentoRuedas &b) {
+    return (int64_t)a.izquierda * b.izquierda >= 0 && (int64_t)a.derecha * b.derecha >= 0;
+}
+
+// Encola un segmento de las ruedas y vuelve enseguida (espera solo si la cola está llena).
+// La tarea que encola es la que recibe los avisos.
+void encolarSegmentoRuedas(int32_t izquierda, int32_t derecha) {
+    SegmentoRuedas s;
+    s.izquierda = izquierda;
+    s.derecha = derecha;
+    s.maestro = max(abs(izquierda), abs(derecha));
+    if (s.maestro == 0) return;
+
+    for (;;) {
+        portENTER_CRITICAL(&candadoMotores);
+        TrayectoriaRuedas &t = ruedas;
+        if (t.escritos - t.leidos < LONGITUD_COLA_SEGMENTOS) {
+            if (!ruedasEnMarcha()) {
+                s.iniciaCadena = true;
+            } else if (!segmentosEncadenables(t.segmentos[(t.escritos - 1) & (LONGITUD_COLA_SEGMENTOS - 1)], s)) {
+                s.iniciaCadena = true;
+                t.cadenaAbierta = false;
+            } else {
+                s.iniciaCadena = false;
+                // Si la cadena en curso llega hasta aquí, su frenado se corre más adelante
+                if (t.cadenaAbierta) t.restantesCadena += s.maestro;
+            }
+            t.segmentos[t.escritos & (LONGITUD_COLA_SEGMENTOS - 1)] = s;
+            t.avisar = xTaskGetCurrentTaskHandle();
+            t.escritos = t.escritos + 1;
+            arrancarTemporizador();
+            portEXIT_CRITICAL(&candadoMotores);
+            return;
+        }
+        portEXIT_CRITICAL(&candadoMotores);
+        vTaskDelay(1);
+    }
+}
+
+// Segmentos de las ruedas terminados desde el arranque
+uint32_t segmentosTerminados() { return ruedas.leidos; }
+
+// Bloquea hasta que las ruedas terminen todo lo encolado. Si se pasa
+// alTerminarSegmento, se llama (en la tarea) cada vez que termina un segmento.
+void esperarRuedas(void (*alTerminarSegmento)() = NULL) {
+    for (;;) {
+        portENTER_CRITICAL(&candadoMotores);
+        bool enMarcha = ruedasEnMarcha();
+        if (!enMarcha) detenerTemporizadorSiQuietos();
+        portEXIT_CRITICAL(&candadoMotores);
+        if (!enMarcha) break;
+        xTaskNotifyWait(0, AVISO_RUEDAS, NULL, portMAX_DELAY);
+        if (alTerminarSegmento) alTerminarSegmento();
+    }
+    if (alTerminarSegmento) alTerminarSegmento();
+}
+
+// Mueve un eje que no sea una rueda "pasos" pasos (relativo) y vuelve enseguida.
+// Devuelve la máscara para esperarEjes() (0 si no había nada que mover).
+uint32_t moverEjeAsync(int eje, int32_t pasos) {
+    if (pasos == 0) return 0;
+    portENTER_CRITICAL(&candadoMotores);
+    EjePasos &e = ejes[eje];
+    e.direccion = pasos > 0 ? 1 : -1;
+    e.restantes = pasos > 0 ? pasos : -pasos;
+    e.hechos = 0;
+    e.acumulador = 0;
+    e.velocidad = velocidadPerfil(0, e.restantes);
+    if (e.tope != 0 && e.velocidad > e.tope) e.velocidad = e.tope;
+    e.avisar = xTaskGetCurrentTaskHandle();
+    arrancarTemporizador();
+    portEXIT_CRITICAL(&candadoMotores);
+    return 1UL << eje;
+}
+
+// Frena un eje suelto con la rampa, sin esperar: el movimiento termina (y
+// avisa) en cuanto el eje se detiene
+void detenerEje(int eje) {
+    portENTER_CRITICAL(&candadoMotores);
+    EjePasos &e = ejes[eje];
+    // Los pasos que tomó acelerar son los que necesita para frenar
+    uint32_t acelerado = e.hechos < longitudRampa ? e.hechos : longitudRampa;
+    if (acelerado > e.pasosHastaTope) acelerado = e.pasosHastaTope;
+    uint32_t frenado = acelerado + 1;
+    if (e.restantes > frenado) e.restantes = frenado;
+    portEXIT_CRITICAL(&candadoMotores);
+}
+
+// Bloquea la tarea que inició el movimiento hasta que terminen los ejes de "mascara"
+bool esperarEjes(uint32_t mascara, TickType_t espera = portMAX_DELAY) {
+    uint32_t recibidos = 0;
+    while ((recibidos & mascara) != mascara) {
+        uint32_t bits = 0;
+        if (xTaskNotifyWait(0, mascara, &bits, espera) != pdTRUE) return false;
+        recibidos |= bits;
+    }
+    portENTER_CRITICAL(&candadoMotores);
+    detenerTemporizadorSiQuietos();
+    portEXIT_CRITICAL(&candadoMotores);
+    return true;
+}
+
+int32_t IRAM_ATTR posicionEje(int eje) { return ejes[eje].posicion; }
+bool ejeEnMovimiento(int eje) { return ejes[eje].restantes != 0; }
+
+#endif // MOTORES_PASOS_H
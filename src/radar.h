@@ -0,0 +1,137 @@
+#ifndef RADAR_H
+#define RADAR_H
+
+#include <Arduino.h>
+#include <EEPROM.h>
+#include <atomic>
+#include <math.h>
+#include "motorespasos.h"
+#include "trigonometria.h"
+
+// Barrido del sensor con el motor 3 (radar), independiente del chasis.
+// TaskRADAR mueve el eje según el modo:
+//  - RADAR_VAIVEN: va y viene entre -amplitud y +amplitud; cada ida o vuelta es una pasada
+//  - RADAR_CONTINUO: gira siempre en el mismo sentido (solo con anillo rozante); cada vuelta es una pasada
+//  - RADAR_QUIETO: vuelve al frente y espera
+//
+// La calibración convierte pasos del eje en el ángulo del haz respecto del
+// frente del robot: grados = (pasos - cero) * 360 / pasosPorVuelta + desfase.
+// pasosPorVuelta y desfase se guardan en la EEPROM; el cero es la posición
+// al arrancar (el radar se estaciona al frente) o la que se marque con /radar?cero=1.
+
+enum ModoRadar { RADAR_QUIETO, RADAR_VAIVEN, RADAR_CONTINUO };
+
+// Después de las credenciales WiFi (0-199)
+#define DIRECCION_CALIBRACION_RADAR 256
+#define MARCA_CALIBRACION_RADAR 0x5243 // "RC"
+#define AVISO_MODO_RADAR (1UL << 30)
+
+struct CalibracionRadar {
+    uint16_t marca;
+    uint16_t pasosPorVuelta; // 28BYJ-48 en paso completo: 2048 en el eje de salida
+    float desfase;           // Grados del haz con el eje en el cero
+};
+
+CalibracionRadar calibracionRadar = {MARCA_CALIBRACION_RADAR, 2048, 0};
+int32_t ceroRadar = 0;
+volatile ModoRadar modoRadar = RADAR_QUIETO;
+float amplitudRadar = 180;        // Grados a cada lado del frente (modo vaivén)
+float velocidadRadar = 90;        // Grados por segundo
+std::atomic<uint32_t> pasadasRadar{0}; // La suma TaskRADAR, la leen las demás
+TaskHandle_t tareaRadar = NULL;
+
+void cargarCalibracionRadar() {
+    CalibracionRadar leida;
+    EEPROM.get(DIRECCION_CALIBRACION_RADAR, leida);
+    if (leida.marca == MARCA_CALIBRACION_RADAR && leida.pasosPorVuelta != 0) {
+        calibracionRadar = leida;
+    }
+}
+
+void guardarCalibracionRadar() {
+    EEPROM.put(DIRECCION_CALIBRACION_RADAR, calibracionRadar);
+    EEPROM.commit();
+}
+
+int32_t pasosRadarDesdeGrados(float grados) {
+    return ceroRadar + lroundf((grados - calibracionRadar.desfase) * calibracionRadar.pasosPorVuelta / 360.0f);
+}
+
+// Ángulo del haz para una posición del eje, en (-180, 180]
+float gradosRadarDesdePasos(int32_t pasos) {
+    float grados = (float)(pasos - ceroRadar) * 360.0f / calibracionRadar.pasosPorVuelta + calibracionRadar.desfase;
+    grados = fmodf(grados, 360.0f);
+    if (grados > 180) grados -= 360;
+    if (grados <= -180) grados += 360;
+    return grados;
+}
+
+// Lo mismo en ángulo binario, con enteros salvo el desfase
+AnguloBinario anguloBinarioRadarDesdePasos(int32_t pasos) {
+    int32_t vuelta = (int32_t)(((int64_t)(pasos - ceroRadar) << 16) / calibracionRadar.pasosPorVuelta);
+    return (AnguloBinario)vuelta + anguloBinarioDesdeGrados(calibracionRadar.desfase);
+}
+
+float anguloRadar() {
+    return gradosRadarDesdePasos(posicionEje(EJE_RADAR));
+}
+
+// Cambia el modo; la pasada en curso termina antes (en continuo se frena con la rampa)
+void configurarBarrido(ModoRadar modo, float amplitud, float gradosPorSegundo) {
+    amplitudRadar = amplitud;
+    velocidadRadar = gradosPorSegundo;
+    configurarVelocidadEje(EJE_RADAR, (uint32_t)(gradosPorSegundo * calibracionRadar.pasosPorVuelta / 360.0f));
+    ModoRadar anterior = modoRadar;
+    modoRadar = modo;
+    if (anterior == RADAR_CONTINUO && modo != RADAR_CONTINUO) detenerEje(EJE_RADAR);
+    if (tareaRadar != NULL) xTaskNotify(tareaRadar, AVISO_MODO_RADAR, eSetBits);
+}
+
+// Espera a que el radar cubra una pasada entera desde ahora (la que está en
+// curso no cuenta porque empezó antes). Devuelve false, sin haberla cubierto,
+// si el radar está o queda en RADAR_QUIETO: el que espera tiene que barrer de
+// otra forma (girando el chasis).
+bool esperarPasadaRadar() {
+    uint32_t inicial = pasadasRadar.load();
+    while (pasadasRadar.load() - inicial < 2) {
+        if (modoRadar == RADAR_QUIETO) return false;
+        vTaskDelay(pdMS_TO_TICKS(20));
+    }
+    return true;
+}
+
+void TaskRADAR(void *pvParameters) {
+    bool haciaPositivo = true;
+    for (;;) {
+        ModoRadar modo = modoRadar;
+        if (modo == RADAR_VAIVEN) {
+            int32_t destino = pasosRadarDesdeGrados(haciaPositivo ? amplitudRadar : -amplitudRadar);
+            esperarEjes(moverEjeAsync(EJE_RADAR, destino - posicionEje(EJE_RADAR)));
+            haciaPositivo = !haciaPositivo;
+            pasadasRadar++;
+        } else if (modo == RADAR_CONTINUO) {
+            // Un movimiento que no termina; detenerEje() lo corta con la rampa
+            uint32_t mascara = moverEjeAsync(EJE_RADAR, INT32_MAX);
+            int32_t vueltaAnterior = (posicionEje(EJE_RADAR) - ceroRadar) / calibracionRadar.pasosPorVuelta;
+            while (!esperarEjes(mascara, pdMS_TO_TICKS(20))) {
+                int32_t vuelta = (posicionEje(EJE_RADAR) - ceroRadar) / calibracionRadar.pasosPorVuelta;
+                if (vuelta != vueltaAnterior) {
+                    vueltaAnterior = vuelta;
+                    pasadasRadar++;
+                }
+            }
+        } else {
+            // Estacionar al frente y dormir hasta otro modo
+            int32_t frente = pasosRadarDesdeGrados(0);
+            esperarEjes(moverEjeAsync(EJE_RADAR, frente - posicionEje(EJE_RADAR)));
+            xTaskNotifyWait(0, AVISO_MODO_RADAR, NULL, portMAX_DELAY);
+        }
+    }
+}
+
+void iniciarRadar(BaseType_t nucleo) {
+    cargarCalibracionRadar();
+    xTaskCreatePinnedToCore(TaskRADAR, "TaskRADAR", 3072, NULL, 2, &tareaRadar, nucleo);
+}
+
+#endif // RADAR_H
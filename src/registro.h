@@ -0,0 +1,121 @@
+#ifndef REGISTRO_H
+#define REGISTRO_H
+
+#include <Arduino.h>
+#include <atomic>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include "traza.h"
+
+// Registro por Serial sin bloquear a quien escribe. REG_ERROR/AVISO/INFO/
+// DEPURAR formatean con printf en un buffer fijo (sin String ni heap) y
+// copian la línea a un anillo; TaskREGISTRO la saca por la UART a su ritmo.
+// Si el anillo está lleno la línea se descarta y se cuenta.
+//
+// Los niveles por encima de NIVEL_REGISTRO (build_flags en platformio.ini)
+// no se compilan: ni se formatea ni se evalúan los argumentos.
+
+#define REGISTRO_NADA 0
+#define REGISTRO_ERROR 1
+#define REGISTRO_AVISO 2
+#define REGISTRO_INFO 3
+#define REGISTRO_DEPURACION 4
+
+#ifndef NIVEL_REGISTRO
+#define NIVEL_REGISTRO REGISTRO_INFO
+#endif
+
+#define LARGO_LINEA_REGISTRO 120
+#define LINEAS_REGISTRO 32 // Potencia de 2
+
+#define REGISTRAR_CON_NIVEL(nivel, ...) \
+    do { if constexpr (NIVEL_REGISTRO >= (nivel)) registrar(__VA_ARGS__); } while (0)
+#define REG_ERROR(...) REGISTRAR_CON_NIVEL(REGISTRO_ERROR, __VA_ARGS__)
+#define REG_AVISO(...) REGISTRAR_CON_NIVEL(REGISTRO_AVISO, __VA_ARGS__)
+#define REG_INFO(...) REGISTRAR_CON_NIVEL(REGISTRO_INFO, __VA_ARGS__)
+#define REG_DEPURAR(...) REGISTRAR_CON_NIVEL(REGISTRO_DEPURACION, __VA_ARGS__)
+
+struct LineaRegistro {
+    uint16_t largo;
+    char texto[LARGO_LINEA_REGISTRO];
+};
+
+LineaRegistro lineasRegistro[LINEAS_REGISTRO];
+uint32_t cabezaRegistro = 0;
+uint32_t colaRegistro = 0;
+std::atomic<uint32_t> lineasDescartadas{0};
+// Escriben tareas de ambos núcleos: la copia al anillo va con spinlock
+portMUX_TYPE candadoRegistro = portMUX_INITIALIZER_UNLOCKED;
+TaskHandle_t tareaRegistro = NULL;
+
+void registrar(const char *formato, ...) __attribute__((format(printf, 1, 2)));
+
+void registrar(const char *formato, ...) {
+    LineaRegistro linea;
+    va_list args;
+    va_start(args, formato);
+    int n = vsnprintf(linea.texto, LARGO_LINEA_REGISTRO - 1, formato, args);
+    va_end(args);
+    if (n < 0) return;
+    if (n > LARGO_LINEA_REGISTRO - 2) n = LARGO_LINEA_REGISTRO - 2; // Recortada
+    linea.texto[n++] = '\n';
+    linea.largo = n;
+
+    // Antes de iniciarRegistro() (principio de setup) se escribe directo
+    if (tareaRegistro == NULL) {
+        Serial.write((const uint8_t *)linea.texto, linea.largo);
+        return;
+    }
+
+    bool guardada = false;
+    portENTER_CRITICAL(&candadoRegistro);
+    if (cabezaRegistro - colaRegistro < LINEAS_REGISTRO) {
+        LineaRegistro &destino = lineasRegistro[cabezaRegistro & (LINEAS_REGISTRO - 1)];
+        destino.largo = linea.largo;
+        memcpy(destino.texto, linea.texto, linea.largo);
+        cabezaRegistro++;
+        guardada = true;
+    }
+    portEXIT_CRITICAL(&candadoRegistro);
+
+    if (guardada) {
+        xTaskNotifyGive(tareaRegistro);
+    } else {
+        lineasDescartadas++;
+    }
+}
+
+void TaskREGISTRO(void *pvParameters) {
+    uint32_t descartadasInformadas = 0;
+    LineaRegistro linea;
+    for (;;) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        for (;;) {
+            bool hay = false;
+            portENTER_CRITICAL(&candadoRegistro);
+            if (colaRegistro != cabezaRegistro) {
+                linea = lineasRegistro[colaRegistro & (LINEAS_REGISTRO - 1)];
+                colaRegistro++;
+                hay = true;
+            }
+            portEXIT_CRITICAL(&candadoRegistro);
+            if (!hay) break;
+            // Solo esta tarea espera a la UART
+            TRAZAR_INICIO(TRAZA_SALIDA_REGISTRO);
+            Serial.write((const uint8_t *)linea.texto, linea.largo);
+            TRAZAR_FIN(TRAZA_SALIDA_REGISTRO);
+        }
+        uint32_t descartadas = lineasDescartadas;
+        if (descartadas != descartadasInformadas) {
+            Serial.printf("[registro] %u líneas descartadas\n", (unsigned)(descartadas - descartadasInformadas));
+            descartadasInformadas = descartadas;
+        }
+    }
+}
+
+void iniciarRegistro(BaseType_t nucleo) {
+    xTaskCreatePinnedToCore(TaskREGISTRO, "TaskREGISTRO", 3072, NULL, 1, &tareaRegistro, nucleo);
+}
+
+#endif // REGISTRO_H
@@ -0,0 +1,629 @@
+#ifndef SIMULADOR_H
+#define SIMULADOR_H
+
+#include <Arduino.h>
+#include <WebServer.h>
+#include <atomic>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+#include "hal.h"
+#include "mapaocupacion.h"
+#include "motorespasos.h"
+#include "traccion.h"
+#include "tramabinaria.h"
+#include "simulacion.h"
+
+// Sala simulada para [env:simulador]: el programa de siempre (setup(),
+// loop(), el escaneo y los movimientos) corre contra un robot y una sala de
+// mentira, más rápido que en tiempo real y con el mismo resultado en cada
+// corrida.
+//  - Motores: se decodifican las bobinas de cada 28BYJ-48 (hal_nativo.h). El
+//    rotor sigue a la fase si el paso llega con tiempo; si llega antes de lo
+//    que el motor puede seguir, o la fase salta dos posiciones, el paso se
+//    pierde. Los pasos de las ruedas mueven la pose real; el robot no
+//    atraviesa paredes (las ruedas patinan).
+//  - Sensor: al final de cada ventana se traza el haz desde la pose real a
+//    mitad de la ventana contra las paredes. Ruido gaussiano que crece con la
+//    distancia, fuera de rango más allá del alcance o con incidencia muy
+//    rasante, mediciones perdidas y caídas largas que el lector ve como timeout.
+//  - Métricas: cada minuto simulado y al final, por stderr: área mapeada,
+//    muestras por segundo, error del mapa contra las paredes reales y error
+//    de la odometría contra la pose real, y el heap libre que ve el programa.
+//    Si las ruedas patinaron contra una pared más de PASOS_CONTRA_PARED_SIM
+//    pasos, la corrida termina con estado 1.
+//  - Web: clientes que piden al servidor como la página y un Prometheus; al
+//    final, la latencia p50/p99 de cada ruta.
+//  - Corridas largas: lo que guarda el simulador mientras corre (historial de
+//    la pose real, tiempos de los pedidos) es memoria fija, así que el heap
+//    libre de cada minuto y de cada "Ciclo N" solo se mueve por el programa
+//    (ver heapLibre() en lib/PlataformaNativa para la caché de glibc).
+//
+// El plano es un archivo de texto (ver planos/sala.txt). Uso:
+//   .pio/build/simulador/program <segundos> <plano>
+
+// Variables externas
+extern MapaRobot mapa;
+extern std::atomic<uint32_t> muestrasIntegradas;
+extern WebServer server;
+
+struct PuntoSim {
+    double x, y;
+};
+
+struct ParedSim {
+    PuntoSim a, b;
+};
+
+// Posición real del robot (mm y radianes, en el marco del plano) y del eje del radar
+struct EstadoSim {
+    double x, y, rumbo;
+    int32_t radar;
+};
+
+struct EjeSim {
+    bool alineado;        // El rotor ya tomó la primera fase energizada
+    int fase;             // Fase en la que está el rotor
+    uint64_t ultimoUs;
+    uint32_t perdidos;
+};
+
+struct ConfiguracionSim {
+    // Robot
+    double inicioX = 0, inicioY = 0, inicioGrados = 0;
+    double radio = 120;                        // mm, para chocar con las paredes
+    double mmPorPasoIzquierda = 1.0 / PASOS_POR_MM;
+    double mmPorPasoDerecha = 1.0 / PASOS_POR_MM;
+    double mediaVia = MEDIA_VIA_MM;
+    double pasosPorVueltaRadar = 2048;
+    double pasosPorSegundoMaximo = 1000;       // Lo más rápido que sigue el rotor
+    // VL53L0X
+    double alcance = 2000;                     // mm
+    double ruidoMm = 3;                        // Desvío fijo
+    double ruidoRelativo = 0.02;               // Desvío proporcional a la distancia
+    double incidenciaMaxima = 75;              // Grados desde la normal de la pared
+    double perdidaPorMil = 2;                  // Mediciones que no llegan
+    double caidaPorMil = 0.5;                  // Sensor que deja de responder...
+    double caidaMs = 700;                      // ...durante este tiempo
+    uint64_t semilla = 1;
+};
+
+ConfiguracionSim configuracionSim;
+std::vector<std::vector<PuntoSim>> poligonosSim; // [0] = contorno, el resto obstáculos
+std::vector<ParedSim> paredesSim;
+EstadoSim estadoSim;
+// Estados de los últimos 100 ms, del más viejo al más nuevo, en un anillo
+// fijo: con el robot andando son cientos y no deben mover el heap que mide
+// el programa. Con el ISR a 10 kHz no pueden pasar de 1000 más los dos bordes.
+#define HISTORIAL_SIM 1024
+std::pair<uint64_t, EstadoSim> historialSim[HISTORIAL_SIM];
+uint32_t primeroHistorialSim = 0, largoHistorialSim = 0;
+
+std::pair<uint64_t, EstadoSim> &registroHistorialSim(uint32_t i) {
+    return historialSim[(primeroHistorialSim + i) % HISTORIAL_SIM];
+}
+EjeSim ejesSim[NUM_EJES];
+uint64_t azarSim;
+uint64_t caidoHastaUs = 0;
+uint32_t medicionesSim = 0, perdidasSim = 0, caidasSim = 0, fueraDeRangoSim = 0;
+uint32_t pasosBloqueadosSim = 0;
+uint64_t primerBloqueoSimUs = 0;
+// El recorte de los avances (avanceLibre() en main.cpp) debe evitar que el
+// chasis llegue a tocar las paredes; se puede aflojar desde build_flags
+#ifndef PASOS_CONTRA_PARED_SIM
+#define PASOS_CONTRA_PARED_SIM 0
+#endif
+uint32_t muestrasAlMinuto = 0;
+int minutosSim = 0;
+uint32_t heapPrimerMinutoSim = 0; // ESP.getFreeHeap() al primer minuto, con todo ya arrancado
+
+// Verdad de cada celda del mapa: dentro de la sala y libre, y distancia a la pared más cercana
+struct VerdadCelda {
+    bool libre;
+    bool enSala;
+    float distanciaPared;
+};
+std::vector<VerdadCelda> verdadSim;
+double areaLibreRealM2 = 0;
+
+// --- Azar reproducible (xorshift64*) ---
+
+double uniformeSim() {
+    azarSim ^= azarSim >> 12;
+    azarSim ^= azarSim << 25;
+    azarSim ^= azarSim >> 27;
+    return ((azarSim * 0x2545F4914F6CDD1DULL) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+double normalSim() {
+    double u = uniformeSim();
+    if (u < 1e-300) u = 1e-300;
+    return sqrt(-2 * log(u)) * cos(2 * PI * uniformeSim());
+}
+
+// --- Geometría ---
+
+double distanciaASegmento(const PuntoSim &p, const ParedSim &s) {
+    double dx = s.b.x - s.a.x, dy = s.b.y - s.a.y;
+    double largo2 = dx * dx + dy * dy;
+    double t = largo2 > 0 ? ((p.x - s.a.x) * dx + (p.y - s.a.y) * dy) / largo2 : 0;
+    t = t < 0 ? 0 : (t > 1 ? 1 : t);
+    return hypot(p.x - (s.a.x + t * dx), p.y - (s.a.y + t * dy));
+}
+
+double distanciaAParedes(const PuntoSim &p) {
+    double minima = INFINITY;
+    for (const ParedSim &s : paredesSim) minima = fmin(minima, distanciaASegmento(p, s));
+    return minima;
+}
+
+bool dentroDePoligono(const PuntoSim &p, const std::vector<PuntoSim> &poligono) {
+    bool dentro = false;
+    for (size_t i = 0, j = poligono.size() - 1; i < poligono.size(); j = i++) {
+        const PuntoSim &a = poligono[i], &b = poligono[j];
+        if ((a.y > p.y) != (b.y > p.y) && p.x < (b.x - a.x) * (p.y - a.y) / (b.y - a.y) + a.x) dentro = !dentro;
+    }
+    return dentro;
+}
+
+bool libreEnPlano(const PuntoSim &p) {
+    if (poligonosSim.empty() || !dentroDePoligono(p, poligonosSim[0])) return false;
+    for (size_t i = 1; i < poligonosSim.size(); i++) {
+        if (dentroDePoligono(p, poligonosSim[i])) return false;
+    }
+    return true;
+}
+
+// Distancia a la primera pared en la dirección "rumbo" (INFINITY si no hay) y
+// ángulo de incidencia respecto de la normal de esa pared, en grados
+double trazarRayo(double x, double y, double rumbo, double &incidencia) {
+    double rx = cos(rumbo), ry = sin(rumbo);
+    double mejor = INFINITY;
+    for (const ParedSim &s : paredesSim) {
+        double sx = s.b.x - s.a.x, sy = s.b.y - s.a.y;
+        double denominador = rx * sy - ry * sx;
+        if (fabs(denominador) < 1e-12) continue;
+        double qx = s.a.x - x, qy = s.a.y - y;
+        double t = (qx * sy - qy * sx) / denominador; // Sobre el rayo
+        double u = (qx * ry - qy * rx) / denominador; // Sobre la pared
+        if (t > 0 && u >= 0 && u <= 1 && t < mejor) {
+            mejor = t;
+            double largo = hypot(sx, sy);
+            incidencia = acos(fmin(1.0, fabs(rx * sy - ry * sx) / largo)) * 180 / PI;
+        }
+    }
+    return mejor;
+}
+
+// Marco del mapa (la odometría arranca en 0,0 mirando a +x) al del plano
+PuntoSim planoDesdeMapa(double x, double y) {
+    double a = configuracionSim.inicioGrados * PI / 180;
+    return {configuracionSim.inicioX + x * cos(a) - y * sin(a), configuracionSim.inicioY + x * sin(a) + y * cos(a)};
+}
+
+// --- Plano ---
+
+bool leerPuntos(const char *texto, std::vector<PuntoSim> &puntos) {
+    double x, y;
+    int leidos;
+    while (sscanf(texto, " %lf , %lf%n", &x, &y, &leidos) == 2) {
+        puntos.push_back({x, y});
+        texto += leidos;
+    }
+    return puntos.size() >= 3;
+}
+
+bool cargarPlano(const char *ruta) {
+    FILE *archivo = fopen(ruta, "r");
+    if (archivo == NULL) {
+        fprintf(stderr, "[sim] No se pudo abrir el plano %s\n", ruta);
+        return false;
+    }
+    ConfiguracionSim &c = configuracionSim;
+    char linea[1024];
+    int numero = 0;
+    bool correcto = true;
+    std::vector<std::vector<PuntoSim>> obstaculos;
+    while (correcto && fgets(linea, sizeof(linea), archivo) != NULL) {
+        numero++;
+        char *comentario = strchr(linea, '#');
+        if (comentario != NULL) *comentario = 0;
+        char clave[32];
+        int leidos;
+        if (sscanf(linea, " %31s%n", clave, &leidos) != 1) continue;
+        const char *resto = linea + leidos;
+        unsigned long long semilla;
+        if (strcmp(clave, "contorno") == 0) {
+            std::vector<PuntoSim> contorno;
+            correcto = poligonosSim.empty() && leerPuntos(resto, contorno);
+            if (correcto) poligonosSim.push_back(contorno);
+        } else if (strcmp(clave, "obstaculo") == 0) {
+            std::vector<PuntoSim> obstaculo;
+            correcto = leerPuntos(resto, obstaculo);
+            obstaculos.push_back(obstaculo);
+        } else if (strcmp(clave, "inicio") == 0) {
+            correcto = sscanf(resto, "%lf %lf %lf", &c.inicioX, &c.inicioY, &c.inicioGrados) == 3;
+        } else if (strcmp(clave, "robot") == 0) {
+            correcto = sscanf(resto, "%lf", &c.radio) == 1;
+        } else if (strcmp(clave, "ruedas") == 0) {
+            double vueltaIzquierda, vueltaDerecha, via;
+            correcto = sscanf(resto, "%lf %lf %lf", &vueltaIzquierda, &vueltaDerecha, &via) == 3;
+            c.mmPorPasoIzquierda = vueltaIzquierda / 2048;
+            c.mmPorPasoDerecha = vueltaDerecha / 2048;
+            c.mediaVia = via / 2;
+        } else if (strcmp(clave, "motor") == 0) {
+            correcto = sscanf(resto, "%lf", &c.pasosPorSegundoMaximo) == 1;
+        } else if (strcmp(clave, "sensor") == 0) {
+            double porciento;
+            correcto = sscanf(resto, "%lf %lf %lf %lf", &c.alcance, &c.ruidoMm, &porciento, &c.incidenciaMaxima) == 4;
+            c.ruidoRelativo = porciento / 100;
+        } else if (strcmp(clave, "fallas") == 0) {
+            correcto = sscanf(resto, "%lf %lf %lf", &c.perdidaPorMil, &c.caidaPorMil, &c.caidaMs) == 3;
+        } else if (strcmp(clave, "semilla") == 0) {
+            correcto = sscanf(resto, "%llu", &semilla) == 1;
+            c.semilla = semilla;
+        } else {
+            correcto = false;
+        }
+    }
+    fclose(archivo);
+    if (!correcto) {
+        fprintf(stderr, "[sim] %s:%d: línea no válida\n", ruta, numero);
+        return false;
+    }
+    if (poligonosSim.empty()) {
+        fprintf(stderr, "[sim] %s: falta el contorno de la sala\n", ruta);
+        return false;
+    }
+    poligonosSim.insert(poligonosSim.end(), obstaculos.begin(), obstaculos.end());
+    for (const std::vector<PuntoSim> &p : poligonosSim) {
+        for (size_t i = 0; i < p.size(); i++) paredesSim.push_back({p[i], p[(i + 1) % p.size()]});
+    }
+    return true;
+}
+
+// Clasifica cada celda del mapa del robot según el plano
+void calcularVerdad() {
+    verdadSim.resize(MAPA_CELDAS * MAPA_CELDAS);
+    double areaCelda = (double)MAPA_RESOLUCION_MM * MAPA_RESOLUCION_MM / 1e6;
+    for (int cy = 0; cy < MAPA_CELDAS; cy++) {
+        for (int cx = 0; cx < MAPA_CELDAS; cx++) {
+            PuntoSim p = planoDesdeMapa(MapaRobot::centroX(cx), MapaRobot::centroY(cy));
+            VerdadCelda &v = verdadSim[cy * MAPA_CELDAS + cx];
+            v.libre = libreEnPlano(p);
+            v.enSala = dentroDePoligono(p, poligonosSim[0]);
+            v.distanciaPared = (float)distanciaAParedes(p);
+            if (v.libre) areaLibreRealM2 += areaCelda;
+        }
+    }
+}
+
+// --- Motores ---
+
+// Fase energizada del eje, o -1 si las bobinas no forman ninguna (apagado)
+int faseEnSalidas(int eje, uint64_t salidas) {
+    const EjePasos &e = ejes[eje];
+    for (int f = 0; f < 4; f++) {
+        uint64_t encender = e.encender[f] | ((uint64_t)e.encender1[f] << 32);
+        uint64_t apagar = e.apagar[f] | ((uint64_t)e.apagar1[f] << 32);
+        if (encender != 0 && (salidas & encender) == encender && (salidas & apagar) == 0) return f;
+    }
+    return -1;
+}
+
+void registrarEstadoSim(uint64_t ahora) {
+    if (largoHistorialSim == HISTORIAL_SIM) {
+        primeroHistorialSim++;
+        largoHistorialSim--;
+    }
+    registroHistorialSim(largoHistorialSim++) = {ahora, estadoSim};
+    // Alcanza con cubrir la ventana del sensor
+    while (largoHistorialSim > 2 && registroHistorialSim(1).first + 100000 < ahora) {
+        primeroHistorialSim++;
+        largoHistorialSim--;
+    }
+}
+
+EstadoSim estadoSimEn(uint64_t t) {
+    EstadoSim estado = largoHistorialSim == 0 ? estadoSim : registroHistorialSim(0).second;
+    for (uint32_t i = 0; i < largoHistorialSim; i++) {
+        const auto &registro = registroHistorialSim(i);
+        if (registro.first > t) break;
+        estado = registro.second;
+    }
+    return estado;
+}
+
+// Un paso de una rueda (+1 adelante): mueve esa rueda por el arco que le toca
+void pasoRueda(bool derecha, int direccion) {
+    const ConfiguracionSim &c = configuracionSim;
+    double d = direccion * (derecha ? c.mmPorPasoDerecha : c.mmPorPasoIzquierda);
+    double giro = (derecha ? d : -d) / (2 * c.mediaVia);
+    double medio = estadoSim.rumbo + giro / 2;
+    PuntoSim nuevo = {estadoSim.x + d / 2 * cos(medio), estadoSim.y + d / 2 * sin(medio)};
+    estadoSim.rumbo += giro;
+    // Contra una pared el chasis no avanza: la rueda patina
+    if (distanciaAParedes(nuevo) >= c.radio || distanciaAParedes(nuevo) > distanciaAParedes({estadoSim.x, estadoSim.y})) {
+        estadoSim.x = nuevo.x;
+        estadoSim.y = nuevo.y;
+    } else {
+        if (pasosBloqueadosSim++ == 0) primerBloqueoSimUs = simTiempoUs();
+    }
+}
+
+// Desde el ISR de pasos, cada vez que cambian las bobinas
+void alCambiarBobinasSim(uint64_t salidas) {
+    uint64_t ahora = simTiempoUs();
+    uint64_t intervaloMinimo = (uint64_t)(1e6 / configuracionSim.pasosPorSegundoMaximo);
+    bool cambio = false;
+    for (int eje = 0; eje < NUM_EJES; eje++) {
+        int f = faseEnSalidas(eje, salidas);
+        EjeSim &m = ejesSim[eje];
+        if (f < 0) continue;
+        if (!m.alineado) {
+            m.alineado = true;
+            m.fase = f;
+            m.ultimoUs = ahora;
+            continue;
+        }
+        int delta = (f - m.fase) & 3;
+        if (delta == 0) continue;
+        bool aTiempo = ahora - m.ultimoUs >= intervaloMinimo;
+        m.ultimoUs = ahora;
+        // Dos fases de diferencia: el rotor no sabe hacia dónde ir y se queda
+        if (delta == 2 || !aTiempo) {
+            m.perdidos++;
+            continue;
+        }
+        int direccion = delta == 1 ? 1 : -1;
+        m.fase = f;
+        if (eje == EJE_RADAR) {
+            estadoSim.radar += direccion;
+        } else {
+            pasoRueda(eje == EJE_DERECHO, direccion);
+        }
+        cambio = true;
+    }
+    if (cambio) registrarEstadoSim(ahora);
+}
+
+// --- Sensor ---
+
+bool modeloSensorSim(LecturaSensor &lectura) {
+    const ConfiguracionSim &c = configuracionSim;
+    uint64_t ahora = simTiempoUs();
+    if (ahora < caidoHastaUs) return false;
+    if (uniformeSim() * 1000 < c.caidaPorMil) {
+        caidoHastaUs = ahora + (uint64_t)(c.caidaMs * 1000);
+        caidasSim++;
+        return false;
+    }
+    if (uniformeSim() * 1000 < c.perdidaPorMil) {
+        perdidasSim++;
+        return false;
+    }
+    medicionesSim++;
+
+    EstadoSim e = estadoSimEn(ahora - halVentanaSensorUs() / 2);
+    double haz = e.rumbo + e.radar * 2 * PI / c.pasosPorVueltaRadar;
+    double incidencia = 0;
+    double distancia = trazarRayo(e.x, e.y, haz, incidencia);
+    if (distancia > c.alcance || incidencia > c.incidenciaMaxima) {
+        fueraDeRangoSim++;
+        lectura = {8190, 0, 4}; // Fase fuera de rango, como el sensor real
+        return true;
+    }
+    double medida = distancia + normalSim() * (c.ruidoMm + c.ruidoRelativo * distancia);
+    lectura.distancia = (uint16_t)fmax(0, fmin(8189, lround(medida)));
+    // Retorno aproximado: cae con el cuadrado de la distancia y con la incidencia
+    double retorno = 40.0 * cos(incidencia * PI / 180) * 1e4 / fmax(distancia * distancia, 1e4);
+    lectura.calidad = (uint16_t)fmin(65535, retorno * 128);
+    lectura.estado = 11;
+    return true;
+}
+
+// --- Métricas ---
+
+struct MetricasSim {
+    double areaMapeadaM2;  // Celdas conocidas dentro de la sala
+    double cobertura;      // Parte del piso libre real que el mapa ya conoce
+    int ocupadas;
+    double ocupadasSobrePared; // Ocupadas a menos de una celda de una pared real
+    double errorOcupadasMm;    // Distancia media de las ocupadas a la pared real
+    double libresFalsas;       // Libres que en realidad son pared u obstáculo
+    double errorPosicionMm;
+    double errorRumboGrados;
+};
+
+MetricasSim medirSim() {
+    MetricasSim m = {};
+    double areaCelda = (double)MAPA_RESOLUCION_MM * MAPA_RESOLUCION_MM / 1e6;
+    int conocidasLibres = 0, libres = 0, falsas = 0, sobrePared = 0;
+    double sumaDistancias = 0;
+    for (int cy = 0; cy < MAPA_CELDAS; cy++) {
+        for (int cx = 0; cx < MAPA_CELDAS; cx++) {
+            const VerdadCelda &v = verdadSim[cy * MAPA_CELDAS + cx];
+            bool ocupada = mapa.ocupada(cx, cy), libre = mapa.libre(cx, cy);
+            if ((ocupada || libre) && v.enSala) m.areaMapeadaM2 += areaCelda;
+            if (libre) {
+                libres++;
+                if (v.libre) conocidasLibres++;
+                if (!v.libre && v.distanciaPared > MAPA_RESOLUCION_MM) falsas++;
+            }
+            if (ocupada) {
+                m.ocupadas++;
+                sumaDistancias += v.distanciaPared;
+                if (v.distanciaPared <= MAPA_RESOLUCION_MM) sobrePared++;
+            }
+        }
+    }
+    m.cobertura = areaLibreRealM2 > 0 ? conocidasLibres * areaCelda / areaLibreRealM2 : 0;
+    m.ocupadasSobrePared = m.ocupadas > 0 ? (double)sobrePared / m.ocupadas : 0;
+    m.errorOcupadasMm = m.ocupadas > 0 ? sumaDistancias / m.ocupadas : 0;
+    m.libresFalsas = libres > 0 ? (double)falsas / libres : 0;
+
+    PoseRobot pose = instantaneaPose();
+    PuntoSim creida = planoDesdeMapa(pose.x / 1000.0, pose.y / 1000.0);
+    m.errorPosicionMm = hypot(creida.x - estadoSim.x, creida.y - estadoSim.y);
+    double rumbo = pose.angulo * 2 * PI / 65536 + configuracionSim.inicioGrados * PI / 180;
+    m.errorRumboGrados = fabs(remainder(rumbo - estadoSim.rumbo, 2 * PI)) * 180 / PI;
+    return m;
+}
+
+// --- Clientes web ---
+
+// Cada cliente pide su ruta cada tanto y no manda otro pedido hasta tener la
+// respuesta. La latencia de un pedido es la espera en la cola hasta que
+// TaskSERVIDOR llega a handleClient() (reloj virtual: incluye lo que el
+// servidor estuvo ocupado con otra cosa) más lo que tardó el handler medido
+// en el host, que no avanza el reloj virtual. En el ESP32 el handler es más
+// lento: la parte del host sirve para comparar, no como número absoluto.
+
+// Tiempos de a 1 µs hasta 50 ms (la última cubeta junta todo lo de más). Es
+// memoria fija fuera del heap: en una corrida de horas, guardar cada pedido
+// en un vector movería el heap libre que el programa informa en cada ciclo.
+#define CUBETAS_TIEMPO_SIM 50001
+struct HistogramaSim {
+    uint32_t cuentas[CUBETAS_TIEMPO_SIM];
+    uint32_t total;
+
+    void anotar(uint32_t us) {
+        cuentas[us < CUBETAS_TIEMPO_SIM - 1 ? us : CUBETAS_TIEMPO_SIM - 1]++;
+        total++;
+    }
+};
+
+struct ClienteWebSim {
+    const char *ruta;
+    uint64_t intervaloUs;
+    bool conCursor;        // Manda since/arranque de la respuesta anterior
+    // Estado de la corrida
+    uint64_t proximoUs = 0;
+    bool enCurso = false;
+    uint32_t seq = 0, arranque = 0;
+    HistogramaSim latenciasUs{}, handlerUs{};
+    uint64_t bytes = 0;
+};
+
+ClienteWebSim clientesWebSim[] = {
+    {"/get-data.bin", 1500000, true},   // web/index.html sin eventos
+    {"/metrics", 15000000, false},      // Prometheus
+    {"/get-data", 30000000, false},     // Mapa completo en JSON
+};
+const int NUM_CLIENTES_WEB_SIM = sizeof(clientesWebSim) / sizeof(clientesWebSim[0]);
+
+void pedirClienteWebSim(ClienteWebSim &c) {
+    char uri[80];
+    if (c.conCursor) {
+        snprintf(uri, sizeof(uri), "%s?since=%u&arranque=%u", c.ruta, (unsigned)c.seq, (unsigned)c.arranque);
+    } else {
+        snprintf(uri, sizeof(uri), "%s", c.ruta);
+    }
+    uint64_t enviadoUs = simTiempoUs();
+    c.enCurso = true;
+    server.pedir(uri, HTTP_GET, [&c, enviadoUs](const RespuestaHttp &r) {
+        c.latenciasUs.anotar((uint32_t)(simTiempoUs() - enviadoUs) + r.hostUs);
+        c.handlerUs.anotar(r.hostUs);
+        c.bytes += r.cuerpo.size();
+        CabeceraTrama cabecera;
+        if (c.conCursor && leerTrama((const uint8_t *)r.cuerpo.data(), r.cuerpo.size(), cabecera,
+                                     [](int16_t, int16_t, bool) {})) {
+            c.seq = cabecera.seq;
+            c.arranque = cabecera.arranque;
+        }
+        c.enCurso = false;
+    });
+}
+
+// Cada 100 ms simulados (desde un temporizador, entre tareas)
+void isrClientesWebSim() {
+    uint64_t ahora = simTiempoUs();
+    for (ClienteWebSim &c : clientesWebSim) {
+        if (c.enCurso || ahora < c.proximoUs) continue;
+        c.proximoUs = ahora + c.intervaloUs;
+        pedirClienteWebSim(c);
+    }
+}
+
+uint32_t percentilSim(const HistogramaSim &h, double p) {
+    if (h.total == 0) return 0;
+    uint32_t posicion = (uint32_t)(p * (h.total - 1) + 0.5), acumulado = 0;
+    for (uint32_t us = 0; us < CUBETAS_TIEMPO_SIM; us++) {
+        acumulado += h.cuentas[us];
+        if (acumulado > posicion) return us;
+    }
+    return CUBETAS_TIEMPO_SIM - 1;
+}
+
+// Cada minuto simulado (desde un temporizador, entre tareas)
+void isrMinutoSim() {
+    minutosSim++;
+    MetricasSim m = medirSim();
+    uint32_t muestras = muestrasIntegradas.load();
+    uint32_t heap = ESP.getFreeHeap();
+    if (minutosSim == 1) heapPrimerMinutoSim = heap;
+    fprintf(stderr, "[sim] min %d: %.2f m² mapeados (%.0f%% del piso), %.1f muestras/s, %d ocupadas (%.0f%% sobre pared), pose %.0f mm / %.1f°, heap libre %u\n",
+            minutosSim, m.areaMapeadaM2, m.cobertura * 100, (muestras - muestrasAlMinuto) / 60.0, m.ocupadas,
+            m.ocupadasSobrePared * 100, m.errorPosicionMm, m.errorRumboGrados, (unsigned)heap);
+    muestrasAlMinuto = muestras;
+}
+
+bool simPreparar(int argc, char **argv) {
+    if (argc < 1) {
+        fprintf(stderr, "Uso: program <segundos simulados> <plano>\n");
+        return false;
+    }
+    if (!cargarPlano(argv[0])) return false;
+    const ConfiguracionSim &c = configuracionSim;
+    azarSim = c.semilla * 0x9E3779B97F4A7C15ULL + 1;
+    estadoSim = {c.inicioX, c.inicioY, c.inicioGrados * PI / 180, 0};
+    if (!libreEnPlano({c.inicioX, c.inicioY})) {
+        fprintf(stderr, "[sim] El inicio (%.0f, %.0f) no está en el piso libre\n", c.inicioX, c.inicioY);
+        return false;
+    }
+    calcularVerdad();
+    alCambiarBobinas = alCambiarBobinasSim;
+    modeloSensorNativo = modeloSensorSim;
+    simArrancarTemporizador(simCrearTemporizador(60000000, isrMinutoSim));
+    for (ClienteWebSim &c : clientesWebSim) c.proximoUs = 5000000; // Con el servidor ya andando
+    simArrancarTemporizador(simCrearTemporizador(100000, isrClientesWebSim));
+    fprintf(stderr, "[sim] %s: %zu paredes, %.2f m² de piso libre\n", argv[0], paredesSim.size(), areaLibreRealM2);
+    return true;
+}
+
+void simInformar(double segundosReales) {
+    double segundos = simTiempoUs() / 1e6;
+    MetricasSim m = medirSim();
+    uint32_t perdidos = 0;
+    for (int eje = 0; eje < NUM_EJES; eje++) perdidos += ejesSim[eje].perdidos;
+    fprintf(stderr, "[sim] Resumen de %.1f s simulados (%.0fx tiempo real)\n", segundos,
+            segundosReales > 0 ? segundos / segundosReales : 0);
+    fprintf(stderr, "[sim]   área mapeada:      %.2f m² (%.2f m²/min), %.0f%% del piso libre\n",
+            m.areaMapeadaM2, segundos > 0 ? m.areaMapeadaM2 * 60 / segundos : 0, m.cobertura * 100);
+    fprintf(stderr, "[sim]   muestras:          %.1f/s del sensor, %.1f/s al mapa\n",
+            segundos > 0 ? medicionesSim / segundos : 0, segundos > 0 ? muestrasIntegradas.load() / segundos : 0);
+    fprintf(stderr, "[sim]   sensor:            %u fuera de rango, %u perdidas, %u caídas\n",
+            (unsigned)fueraDeRangoSim, (unsigned)perdidasSim, (unsigned)caidasSim);
+    fprintf(stderr, "[sim]   mapa:              %d ocupadas, %.0f%% a menos de %d mm de una pared (media %.0f mm), %.1f%% de libres falsas\n",
+            m.ocupadas, m.ocupadasSobrePared * 100, MAPA_RESOLUCION_MM, m.errorOcupadasMm, m.libresFalsas * 100);
+    fprintf(stderr, "[sim]   odometría:         %.0f mm y %.1f° de error\n", m.errorPosicionMm, m.errorRumboGrados);
+    fprintf(stderr, "[sim]   motores:           %u pasos perdidos, %u pasos contra una pared\n",
+            (unsigned)perdidos, (unsigned)pasosBloqueadosSim);
+    fprintf(stderr, "[sim]   heap libre:        %u al primer minuto, %u al final, mínimo %u\n",
+            (unsigned)heapPrimerMinutoSim, (unsigned)ESP.getFreeHeap(), (unsigned)ESP.getMinFreeHeap());
+    for (const ClienteWebSim &c : clientesWebSim) {
+        uint32_t n = c.latenciasUs.total;
+        fprintf(stderr, "[sim]   web %-14s %u pedidos, latencia p50 %.2f ms / p99 %.2f ms, handler en el host p50 %u us / p99 %u us, %.0f bytes de media\n",
+                c.ruta, (unsigned)n, percentilSim(c.latenciasUs, 0.5) / 1000.0, percentilSim(c.latenciasUs, 0.99) / 1000.0,
+                (unsigned)percentilSim(c.handlerUs, 0.5), (unsigned)percentilSim(c.handlerUs, 0.99),
+                n > 0 ? (double)c.bytes / n : 0);
+    }
+    if (pasosBloqueadosSim > PASOS_CONTRA_PARED_SIM) {
+        fprintf(stderr, "[sim] FALLA: %u pasos contra una pared (máximo %u), el primero a los %.1f s\n",
+                (unsigned)pasosBloqueadosSim, (unsigned)PASOS_CONTRA_PARED_SIM, primerBloqueoSimUs / 1e6);
+        simSalir(1);
+    }
+}
+
+#endif // SIMULADOR_H
@@ -0,0 +1,101 @@
+#ifndef TRACCION_H
+#define TRACCION_H
+
+#include <Arduino.h>
+#include <atomic>
+#include <math.h>
+#include "motorespasos.h"
+#include "estadorobot.h"
+
+// Cinemática de la tracción diferencial sobre la cola de segmentos de
+// motorespasos.h. Cada movimiento es un arco (avance del centro + giro) que
+// se traduce a pasos de cada rueda; recta y giro en el lugar son casos
+// particulares. La pose se integra con los pasos que de verdad dio cada rueda.
+
+// Pasos de cada rueda por mm de avance y por grado de giro en el lugar
+// (las mismas constantes de prueba de avanzarRobot y pasosParaGirar)
+#define PASOS_POR_MM (3.012f * 2048 / 360)
+#define PASOS_POR_GRADO (6.516f * 2048 / 360)
+// Media distancia entre ruedas que resulta de esas dos constantes (~124 mm)
+#define MEDIA_VIA_MM (PASOS_POR_GRADO * 180.0f / (PASOS_POR_MM * PI))
+// Cada cuánto TaskODOMETRIA integra los pasos y registra la pose
+#define PERIODO_ODOMETRIA_MS 10
+
+// Odometría en enteros: el centro avanza (izquierda + derecha) medios pasos
+// de avance y gira (derecha - izquierda) medios pasos de giro. Factores en Q16.
+constexpr int64_t MICRAS_POR_MEDIO_PASO_Q16 = (int64_t)(MICRAS_POR_MM / PASOS_POR_MM / 2 * 65536 + 0.5);
+constexpr int64_t ANGULO_POR_MEDIO_PASO_Q16 = (int64_t)(65536.0 / 360 / PASOS_POR_GRADO / 2 * 65536 + 0.5);
+
+// Variables externas
+extern std::atomic<uint32_t> versionPose;
+
+// Arco: el centro avanza "mm" mientras el robot gira "grados" (positivo a la izquierda)
+void encolarArco(float mm, float grados) {
+    int32_t avance = lroundf(mm * PASOS_POR_MM);
+    int32_t giro = lroundf(grados * PASOS_POR_GRADO);
+    encolarSegmentoRuedas(avance - giro, avance + giro);
+}
+
+void encolarRecta(float mm) { encolarArco(mm, 0); }
+void encolarGiro(float grados) { encolarArco(0, grados); }
+
+// Giro sobre la rueda interior, que queda quieta. Como ninguna rueda va hacia
+// atrás, encadena con una recta posterior sin detenerse. El centro termina
+// MEDIA_VIA_MM * sen(grados) más adelante en la nueva dirección.
+void encolarPivote(float grados) {
+    encolarArco(fabsf(grados) * MEDIA_VIA_MM * PI / 180.0f, grados);
+}
+
+int32_t odometriaIzquierda = 0;
+int32_t odometriaDerecha = 0;
+// Posición en medios pasos x Q15, sin redondear entre actualizaciones; el
+// producto al pasar a µm entra en 64 bits hasta unos 2,9 km netos por eje
+int64_t acumuladoX = 0;
+int64_t acumuladoY = 0;
+PoseRobot poseOdometria = {0, 0, 0};
+
+// Suma a la pose los pasos dados desde la última llamada y la registra con
+// su instante. El rumbo sale directo de la diferencia total entre ruedas (no
+// acumula error); el avance se proyecta con el rumbo a mitad del tramo, que
+// en 10 ms difiere del arco exacto en menos de una parte por millón. Solo la
+// llama TaskODOMETRIA, cada PERIODO_ODOMETRIA_MS aunque el robot esté quieto,
+// para que el historial siempre cubra el instante de la última muestra.
+void actualizarOdometria() {
+    uint32_t ahora = micros();
+    int32_t izquierda = posicionEje(EJE_IZQUIERDO);
+    int32_t derecha = posicionEje(EJE_DERECHO);
+    int32_t suma = (izquierda - odometriaIzquierda) + (derecha - odometriaDerecha);
+    int32_t diferenciaAnterior = odometriaDerecha - odometriaIzquierda;
+    int32_t diferencia = derecha - izquierda;
+    odometriaIzquierda = izquierda;
+    odometriaDerecha = derecha;
+    if (suma == 0 && diferencia == diferenciaAnterior) {
+        registrarPose(ahora, poseOdometria);
+        return;
+    }
+
+    AnguloBinario medio = (AnguloBinario)(((int64_t)(diferenciaAnterior + diferencia) * ANGULO_POR_MEDIO_PASO_Q16 + (1LL << 16)) >> 17);
+    acumuladoX += (int64_t)suma * cosenoQ15(medio);
+    acumuladoY += (int64_t)suma * senoQ15(medio);
+    poseOdometria.x = (int32_t)((acumuladoX * MICRAS_POR_MEDIO_PASO_Q16 + (1LL << 30)) >> 31);
+    poseOdometria.y = (int32_t)((acumuladoY * MICRAS_POR_MEDIO_PASO_Q16 + (1LL << 30)) >> 31);
+    poseOdometria.angulo = (AnguloBinario)(((int64_t)diferencia * ANGULO_POR_MEDIO_PASO_Q16 + (1LL << 15)) >> 16);
+    registrarPose(ahora, poseOdometria);
+    versionPose++;
+}
+
+// Espera a que la odometría registre la pose de este instante, por ejemplo
+// para informar la pose final después de esperarRuedas()
+void esperarOdometria() {
+    esperarPoseEn(micros());
+}
+
+void TaskODOMETRIA(void *pvParameters) {
+    TickType_t ultimo = xTaskGetTickCount();
+    for (;;) {
+        actualizarOdometria();
+        vTaskDelayUntil(&ultimo, pdMS_TO_TICKS(PERIODO_ODOMETRIA_MS));
+    }
+}
+
+#endif // TRACCION_H
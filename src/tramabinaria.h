@@ -0,0 +1,124 @@
+#ifndef TRAMA_BINARIA_H
+#define TRAMA_BINARIA_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Trama binaria del mapa (versión 1), little-endian. Todo en enteros: el
+// MCU no formatea ningún float y cada celda ocupa 4 bytes.
+//
+//  off  tam  campo
+//    0    2  'M' 'R'
+//    2    1  versión (1)
+//    3    1  banderas (bit 0: mapa completo)
+//    4    4  id de arranque
+//    8    4  secuencia del mapa
+//   12    2  robotX (int16, mm)
+//   14    2  robotY (int16, mm)
+//   16    2  robotAngulo (uint16, 65536 = 360°)
+//   18    2  ultimoAngulo (uint16, 65536 = 360°)
+//   20    2  ultimaDistancia (uint16, mm)
+//   22    2  numPuntos (uint16)
+//   24    2  N = celdas ocupadas que siguen
+//   26    2  L = celdas libres que siguen
+//   28  4*N  (int16 x, int16 y) de cada celda ocupada, mm
+//    .  4*L  (int16 x, int16 y) de cada celda que dejó de estar ocupada
+#define TRAMA_VERSION 1
+#define TRAMA_TAMANO_CABECERA 28
+#define TRAMA_COMPLETA 0x01
+
+struct CabeceraTrama {
+    uint8_t banderas;
+    uint32_t arranque;
+    uint32_t seq;
+    int16_t robotX;
+    int16_t robotY;
+    uint16_t robotAngulo;
+    uint16_t ultimoAngulo;
+    uint16_t ultimaDistancia;
+    uint16_t numPuntos;
+    uint16_t ocupadas;
+    uint16_t libres;
+};
+
+inline int16_t saturarInt16(int32_t valor) {
+    if (valor > 32767) return 32767;
+    if (valor < -32768) return -32768;
+    return (int16_t)valor;
+}
+
+inline void escribirLe16(uint8_t *p, uint16_t v) {
+    p[0] = v & 0xFF;
+    p[1] = v >> 8;
+}
+
+inline void escribirLe32(uint8_t *p, uint32_t v) {
+    escribirLe16(p, v & 0xFFFF);
+    escribirLe16(p + 2, v >> 16);
+}
+
+inline uint16_t leerLe16(const uint8_t *p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+inline uint32_t leerLe32(const uint8_t *p) {
+    return leerLe16(p) | ((uint32_t)leerLe16(p + 2) << 16);
+}
+
+// Escritor: cualquier objeto con agregar(const char *, size_t)
+template <typename Escritor>
+void escribirCabeceraTrama(Escritor &w, const CabeceraTrama &c) {
+    uint8_t b[TRAMA_TAMANO_CABECERA];
+    b[0] = 'M';
+    b[1] = 'R';
+    b[2] = TRAMA_VERSION;
+    b[3] = c.banderas;
+    escribirLe32(b + 4, c.arranque);
+    escribirLe32(b + 8, c.seq);
+    escribirLe16(b + 12, (uint16_t)c.robotX);
+    escribirLe16(b + 14, (uint16_t)c.robotY);
+    escribirLe16(b + 16, c.robotAngulo);
+    escribirLe16(b + 18, c.ultimoAngulo);
+    escribirLe16(b + 20, c.ultimaDistancia);
+    escribirLe16(b + 22, c.numPuntos);
+    escribirLe16(b + 24, c.ocupadas);
+    escribirLe16(b + 26, c.libres);
+    w.agregar((const char *)b, sizeof(b));
+}
+
+template <typename Escritor>
+void escribirPuntoTrama(Escritor &w, int32_t x, int32_t y) {
+    uint8_t b[4];
+    escribirLe16(b, (uint16_t)saturarInt16(x));
+    escribirLe16(b + 2, (uint16_t)saturarInt16(y));
+    w.agregar((const char *)b, sizeof(b));
+}
+
+// Decodifica una trama completa en memoria. Devuelve false si está
+// truncada o no es de esta versión. f(x, y, ocupada) recibe cada celda.
+template <typename F>
+bool leerTrama(const uint8_t *datos, size_t longitud, CabeceraTrama &c, F f) {
+    if (longitud < TRAMA_TAMANO_CABECERA) return false;
+    if (datos[0] != 'M' || datos[1] != 'R' || datos[2] != TRAMA_VERSION) return false;
+    c.banderas = datos[3];
+    c.arranque = leerLe32(datos + 4);
+    c.seq = leerLe32(datos + 8);
+    c.robotX = (int16_t)leerLe16(datos + 12);
+    c.robotY = (int16_t)leerLe16(datos + 14);
+    c.robotAngulo = leerLe16(datos + 16);
+    c.ultimoAngulo = leerLe16(datos + 18);
+    c.ultimaDistancia = leerLe16(datos + 20);
+    c.numPuntos = leerLe16(datos + 22);
+    c.ocupadas = leerLe16(datos + 24);
+    c.libres = leerLe16(datos + 26);
+
+    size_t total = c.ocupadas + c.libres;
+    if (longitud < TRAMA_TAMANO_CABECERA + 4 * total) return false;
+    const uint8_t *p = datos + TRAMA_TAMANO_CABECERA;
+    for (size_t i = 0; i < total; i++, p += 4) {
+        f((int16_t)leerLe16(p), (int16_t)leerLe16(p + 2), i < c.ocupadas);
+    }
+    return true;
+}
+
+#endif // TRAMA_BINARIA_H
@@ -0,0 +1,177 @@
+#ifndef TRAZA_H
+#define TRAZA_H
+
+#include <Arduino.h>
+#include <atomic>
+#include <string.h>
+#include "tramabinaria.h"
+
+// Traza de eventos de los caminos calientes: cada tramo (lectura I2C,
+// muestra, escaneo, pedido web, salida por la UART...) deja un evento de
+// inicio y uno de fin con la tarea y el instante en µs. Se guardan en un
+// anillo de EVENTOS_TRAZA que pisa los más viejos, se descarga en
+// /traza.bin y tools/traza_a_chrome.py la convierte al JSON de Chrome
+// para verla en Perfetto (ui.perfetto.dev).
+//
+// Registrar un evento es leer micros(), buscar la tarea en una tabla
+// chica y tres operaciones atómicas: sin candado ni heap. Con
+// TRAZA_EVENTOS 0 (build_flags) las macros no compilan nada.
+
+#ifndef TRAZA_EVENTOS
+#define TRAZA_EVENTOS 1
+#endif
+
+// Potencia de 2, 8 bytes cada uno. Con el sensor a ~30 muestras/s se
+// trazan ~300 eventos por segundo: 2048 cubren los últimos ~7 s.
+#ifndef EVENTOS_TRAZA
+#define EVENTOS_TRAZA 2048
+#endif
+#define MAX_TAREAS_TRAZA 16
+
+enum IdEventoTraza : uint8_t {
+    TRAZA_CICLO,              // Una vuelta de loop()
+    TRAZA_ESCANEO,            // escanearYBuscar()
+    TRAZA_GIRO,               // TaskROTARCOM: giro o pasada del radar
+    TRAZA_MOVIMIENTO,         // Esperar a que el robot termine de moverse
+    TRAZA_LECTURA_SENSOR,     // Leer la medición por I2C
+    TRAZA_ESPERA_POSE,        // Esperar la pose posterior a la medición
+    TRAZA_MUESTRA,            // TaskMUESTRAS con una muestra
+    TRAZA_MAPA,               // Llevar las muestras del anillo al mapa
+    TRAZA_PEDIDO_HTTP,        // Un handler del servidor web
+    TRAZA_EVENTOS_SSE,        // atenderEventos()
+    TRAZA_SALIDA_REGISTRO,    // Una línea de registro por la UART
+    TRAZA_TIMEOUT_SENSOR,     // Instante
+    TRAZA_MUESTRA_DESCARTADA, // Instante
+    TRAZA_COLA_MUESTRAS,      // Valor: muestras esperando en la cola
+    NUM_EVENTOS_TRAZA
+};
+
+const char *const NOMBRES_EVENTOS_TRAZA[NUM_EVENTOS_TRAZA] = {
+    "ciclo", "escaneo", "giro", "movimiento", "lectura sensor", "espera pose",
+    "muestra", "mapa", "pedido HTTP", "eventos SSE", "salida registro",
+    "timeout sensor", "muestra descartada", "cola muestras"};
+
+#define FASE_INICIO 0
+#define FASE_FIN 1
+#define FASE_INSTANTE 2
+#define FASE_VALOR 3
+
+struct EventoTraza {
+    uint32_t tiempoUs;
+    uint16_t valor;
+    uint8_t evento;
+    uint8_t tareaFase; // Tarea en los 4 bits bajos, fase en los 2 siguientes
+};
+
+EventoTraza eventosTraza[EVENTOS_TRAZA];
+std::atomic<uint32_t> cabezaTraza{0};
+// La descarga pausa el anillo y espera a que nadie esté a mitad de
+// trazar(): cada llamada cuenta en trazasEnCurso antes de mirar la pausa
+std::atomic<bool> trazaPausada{false};
+std::atomic<int> trazasEnCurso{0};
+
+// Índice chico de cada tarea que registró algo, en orden de aparición
+TaskHandle_t tareasTraza[MAX_TAREAS_TRAZA];
+std::atomic<int> numTareasTraza{0};
+portMUX_TYPE candadoTraza = portMUX_INITIALIZER_UNLOCKED;
+
+#if TRAZA_EVENTOS
+#define TRAZAR_INICIO(evento) trazar((evento), FASE_INICIO, 0)
+#define TRAZAR_FIN(evento) trazar((evento), FASE_FIN, 0)
+#define TRAZAR_INSTANTE(evento, valor) trazar((evento), FASE_INSTANTE, (valor))
+#define TRAZAR_VALOR(evento, valor) trazar((evento), FASE_VALOR, (valor))
+#else
+#define TRAZAR_INICIO(evento) do {} while (0)
+#define TRAZAR_FIN(evento) do {} while (0)
+#define TRAZAR_INSTANTE(evento, valor) do {} while (0)
+#define TRAZAR_VALOR(evento, valor) do {} while (0)
+#endif
+
+uint8_t indiceTareaTraza() {
+    TaskHandle_t actual = xTaskGetCurrentTaskHandle();
+    int n = numTareasTraza.load(std::memory_order_acquire);
+    for (int i = 0; i < n; i++) {
+        if (tareasTraza[i] == actual) return i;
+    }
+    // Primer evento de esta tarea; si no hay lugar comparte la última
+    portENTER_CRITICAL(&candadoTraza);
+    n = numTareasTraza.load(std::memory_order_relaxed);
+    int indice = MAX_TAREAS_TRAZA - 1;
+    for (int i = 0; i < n; i++) {
+        if (tareasTraza[i] == actual) indice = i;
+    }
+    if (indice == MAX_TAREAS_TRAZA - 1 && n < MAX_TAREAS_TRAZA) {
+        indice = n;
+        tareasTraza[n] = actual;
+        numTareasTraza.store(n + 1, std::memory_order_release);
+    }
+    portEXIT_CRITICAL(&candadoTraza);
+    return indice;
+}
+
+// Solo desde tareas: en un ISR la tarea actual es la interrumpida
+void trazar(uint8_t evento, uint8_t fase, uint16_t valor) {
+    trazasEnCurso.fetch_add(1);
+    if (trazaPausada.load()) {
+        trazasEnCurso.fetch_sub(1);
+        return;
+    }
+    uint32_t tiempo = micros();
+    uint8_t tarea = indiceTareaTraza();
+    EventoTraza &e = eventosTraza[cabezaTraza.fetch_add(1, std::memory_order_relaxed) & (EVENTOS_TRAZA - 1)];
+    e.tiempoUs = tiempo;
+    e.valor = valor;
+    e.evento = evento;
+    e.tareaFase = tarea | (fase << 4);
+    trazasEnCurso.fetch_sub(1, std::memory_order_release);
+}
+
+// --- Descarga, little-endian ---
+//  off  tam  campo
+//    0    4  'T' 'R' 'Z' '1'
+//    4    4  N = eventos que siguen, del más viejo al más nuevo
+//    8    1  T = tareas
+//    9    1  E = nombres de eventos
+//   10    .  T nombres de tarea y E nombres de evento, terminados en '\0'
+//    .  8*N  (uint32 µs, uint16 valor, uint8 evento, uint8 tarea | fase << 4)
+// El anillo se pausa mientras se copia: los eventos de ese rato se pierden,
+// pero no se mezclan a medio escribir con los que se envían.
+template <typename Escritor>
+void escribirTraza(Escritor &w) {
+    // Con la pausa y el contador secuencialmente consistentes, o trazar() ve
+    // la pausa o acá se ve que está en curso
+    trazaPausada.store(true);
+    while (trazasEnCurso.load(std::memory_order_acquire) != 0) {
+        vTaskDelay(1); // Puede ser una tarea de menor prioridad en este núcleo
+    }
+    uint32_t cabeza = cabezaTraza.load(std::memory_order_acquire);
+    uint32_t n = cabeza < EVENTOS_TRAZA ? cabeza : EVENTOS_TRAZA;
+    int tareas = numTareasTraza.load(std::memory_order_acquire);
+
+    uint8_t cabecera[10];
+    memcpy(cabecera, "TRZ1", 4);
+    escribirLe32(cabecera + 4, n);
+    cabecera[8] = tareas;
+    cabecera[9] = NUM_EVENTOS_TRAZA;
+    w.agregar((const char *)cabecera, sizeof(cabecera));
+    for (int i = 0; i < tareas; i++) {
+        w.agregar(pcTaskGetName(tareasTraza[i]));
+        w.agregar('\0');
+    }
+    for (int i = 0; i < NUM_EVENTOS_TRAZA; i++) {
+        w.agregar(NOMBRES_EVENTOS_TRAZA[i]);
+        w.agregar('\0');
+    }
+    for (uint32_t i = cabeza - n; i != cabeza; i++) {
+        const EventoTraza &e = eventosTraza[i & (EVENTOS_TRAZA - 1)];
+        uint8_t bytes[8];
+        escribirLe32(bytes, e.tiempoUs);
+        escribirLe16(bytes + 4, e.valor);
+        bytes[6] = e.evento;
+        bytes[7] = e.tareaFase;
+        w.agregar((const char *)bytes, sizeof(bytes));
+    }
+    trazaPausada.store(false);
+}
+
+#endif // TRAZA_H
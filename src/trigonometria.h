@@ -0,0 +1,77 @@
+#ifndef TRIGONOMETRIA_H
+#define TRIGONOMETRIA_H
+
+#include <stdint.h>
+#include <math.h>
+
+// Seno y coseno en punto fijo sin libm. Los ángulos son binarios: una vuelta
+// son 65536 unidades en un uint16_t, así que el desborde hace solo el módulo
+// 360°. La tabla (Q15, 1024 valores por vuelta) se genera en compilación y
+// entre dos valores se interpola linealmente: el error queda por debajo de
+// 1e-4, muy lejos del milímetro en el alcance del sensor.
+
+typedef uint16_t AnguloBinario;
+
+#define BITS_TABLA_SENO 10
+#define LONGITUD_TABLA_SENO (1 << BITS_TABLA_SENO)
+#define BITS_FRACCION_SENO (16 - BITS_TABLA_SENO)
+#define UNO_Q15 32768
+
+// Serie de Taylor para generar la tabla (x en [-pi, pi])
+constexpr double senoSerie(double x) {
+    double termino = x, suma = x;
+    for (int n = 1; n < 20; n++) {
+        termino *= -x * x / ((2 * n) * (2 * n + 1));
+        suma += termino;
+    }
+    return suma;
+}
+
+struct TablaSeno {
+    int16_t valores[LONGITUD_TABLA_SENO];
+
+    constexpr TablaSeno() : valores() {
+        for (int i = 0; i < LONGITUD_TABLA_SENO; i++) {
+            // Índice llevado a (-pi, pi] para que la serie converja rápido
+            int centrado = i <= LONGITUD_TABLA_SENO / 2 ? i : i - LONGITUD_TABLA_SENO;
+            double x = centrado * (2 * 3.14159265358979323846 / LONGITUD_TABLA_SENO);
+            double q15 = senoSerie(x) * UNO_Q15;
+            q15 = q15 < 0 ? q15 - 0.5 : q15 + 0.5;
+            // +1 no entra en int16_t
+            valores[i] = q15 > 32767 ? 32767 : (q15 < -32767 ? -32767 : (int16_t)q15);
+        }
+    }
+};
+
+constexpr TablaSeno tablaSeno;
+
+constexpr int32_t senoQ15(AnguloBinario angulo) {
+    uint32_t i = angulo >> BITS_FRACCION_SENO;
+    int32_t fraccion = angulo & ((1 << BITS_FRACCION_SENO) - 1);
+    int32_t a = tablaSeno.valores[i];
+    int32_t b = tablaSeno.valores[(i + 1) & (LONGITUD_TABLA_SENO - 1)];
+    return a + (((b - a) * fraccion) >> BITS_FRACCION_SENO);
+}
+
+constexpr int32_t cosenoQ15(AnguloBinario angulo) {
+    return senoQ15((AnguloBinario)(angulo + 16384)); // +90°
+}
+
+inline AnguloBinario anguloBinarioDesdeGrados(float grados) {
+    // Por int32_t para que los negativos den la vuelta igual que los positivos
+    return (AnguloBinario)(int32_t)lroundf(grados * (65536.0f / 360.0f));
+}
+
+inline float gradosDesdeAnguloBinario(AnguloBinario angulo) {
+    return angulo * (360.0f / 65536.0f);
+}
+
+// Desplazamiento (dx, dy) de "distancia" en la dirección "angulo", redondeado
+// a la unidad: dos multiplicaciones y dos lecturas de tabla. "distancia"
+// hasta 65535 para que el producto entre en 32 bits
+inline void polarACartesiano(int32_t distancia, AnguloBinario angulo, int32_t &dx, int32_t &dy) {
+    dx = (distancia * cosenoQ15(angulo) + (1 << 14)) >> 15;
+    dy = (distancia * senoQ15(angulo) + (1 << 14)) >> 15;
+}
+
+#endif // TRIGONOMETRIA_H
@@ -0,0 +1,140 @@
+// Ángulo de cada muestra con el radar barriendo: se reproduce el vaivén de
+// ±180° a 90°/s con sus rampas sobre el ISR de pasos y se compara el ángulo
+// de cada muestra con el ángulo medio real del haz durante su ventana
+#include <Arduino.h>
+#include <EEPROM.h>
+#include <unity.h>
+#include <math.h>
+#include <vector>
+#include "lectorvl53l0x.h"
+#include "radar.h"
+
+int32_t IRAM_ATTR pasosSensor() {
+    return posicionEje(EJE_RADAR);
+}
+
+AnguloBinario anguloSensorEnPasos(int32_t pasos) {
+    return anguloBinarioRadarDesdePasos(pasos);
+}
+
+// Hace de odometría: registra la pose cada 5 ms
+void TaskPOSE(void *pvParameters) {
+    for (;;) {
+        registrarPose(micros(), {0, 0, 0});
+        vTaskDelay(pdMS_TO_TICKS(5));
+    }
+}
+
+// Cada paso del radar: instante (µs) y posición nueva
+struct PasoRadar {
+    int64_t us;
+    int32_t posicion;
+};
+std::vector<PasoRadar> pasosRadar;
+int32_t posicionRadarAnterior = 0;
+
+void anotarPasos(uint64_t salidas) {
+    (void)salidas;
+    int32_t posicion = posicionEje(EJE_RADAR);
+    if (posicion != posicionRadarAnterior) pasosRadar.push_back({halTiempoUs(), posicion});
+    posicionRadarAnterior = posicion;
+}
+
+// Posición media del eje (en pasos, con fracción) entre desde y hasta
+double posicionMedia(int64_t desde, int64_t hasta) {
+    size_t i = 0;
+    while (i < pasosRadar.size() && pasosRadar[i].us <= desde) i++;
+    int32_t posicion = i > 0 ? pasosRadar[i - 1].posicion : 0;
+    double suma = 0;
+    int64_t t = desde;
+    for (; i < pasosRadar.size() && pasosRadar[i].us < hasta; i++) {
+        suma += (double)posicion * (pasosRadar[i].us - t);
+        t = pasosRadar[i].us;
+        posicion = pasosRadar[i].posicion;
+    }
+    suma += (double)posicion * (hasta - t);
+    return suma / (hasta - desde);
+}
+
+double gradosDesdePasos(double pasos) {
+    return (pasos - ceroRadar) * 360.0 / calibracionRadar.pasosPorVuelta + calibracionRadar.desfase;
+}
+
+// Diferencia en (-180, 180]
+double diferenciaGrados(double a, double b) {
+    return remainder(a - b, 360.0);
+}
+
+#define SEGUNDOS_BARRIDO 12
+MuestraRango muestras[SEGUNDOS_BARRIDO * 40];
+int numMuestras = 0;
+
+void setUp() {}
+void tearDown() {}
+
+void test_barrido_completo_con_muestras() {
+    TEST_ASSERT_GREATER_OR_EQUAL(29 * SEGUNDOS_BARRIDO, numMuestras);
+    // Pasó por los dos extremos, con las rampas de cada vuelta
+    double minimo = 0, maximo = 0;
+    for (const PasoRadar &p : pasosRadar) {
+        minimo = fmin(minimo, gradosDesdePasos(p.posicion));
+        maximo = fmax(maximo, gradosDesdePasos(p.posicion));
+    }
+    TEST_ASSERT_FLOAT_WITHIN(0.5, -180, minimo);
+    TEST_ASSERT_FLOAT_WITHIN(0.5, 180, maximo);
+}
+
+void test_error_de_angulo_acotado() {
+    uint32_t mitad = halVentanaSensorUs() / 2;
+    double suma = 0, maximo = 0, sumaSinCompensar = 0;
+    int n = 0;
+    // La primera no tiene una lectura anterior para interpolar
+    for (int i = 1; i < numMuestras; i++) {
+        const MuestraRango &m = muestras[i];
+        // Las muestras llevan micros() de 32 bits; la prueba no llega a darle la vuelta
+        double real = gradosDesdePasos(posicionMedia((int64_t)m.tiempoUs - mitad, (int64_t)m.tiempoUs + mitad));
+        double error = fabs(diferenciaGrados(gradosDesdeAnguloBinario(m.angulo), real));
+        suma += error;
+        maximo = fmax(maximo, error);
+        // Lo que daría leer la posición al final de la ventana, cuando se lee la medición
+        double alFinal = gradosDesdePasos(posicionMedia((int64_t)m.tiempoUs + mitad, (int64_t)m.tiempoUs + mitad + 1));
+        sumaSinCompensar += fabs(diferenciaGrados(alFinal, real));
+        n++;
+    }
+    // Un paso del eje son 0,18°: el error queda por debajo de un paso y medio
+    TEST_ASSERT_LESS_OR_EQUAL_FLOAT(0.27, maximo);
+    TEST_ASSERT_LESS_OR_EQUAL_FLOAT(0.1, suma / n);
+    // A 90°/s media ventana de 33 ms son ~1,5°: sin la interpolación no pasaría
+    TEST_ASSERT_GREATER_THAN_FLOAT(1.0, sumaSinCompensar / n);
+}
+
+void setup() {
+    EEPROM.begin(512);
+    configurarEje(EJE_IZQUIERDO, 14, 26, 27, 25);
+    configurarEje(EJE_DERECHO, 19, 5, 18, 32);
+    configurarEje(EJE_RADAR, 23, 4, 33, 2);
+    configurarPerfil(800, 400);
+    iniciarMotores();
+    alCambiarBobinas = anotarPasos;
+    iniciarRadar(1);
+    configurarBarrido(RADAR_VAIVEN, 180, 90);
+
+    xTaskCreatePinnedToCore(TaskPOSE, "TaskPOSE", 2048, NULL, 3, NULL, 1);
+    halIniciarSensor(500);
+    iniciarLectorSensor(1);
+    uint32_t inicio = micros();
+    MuestraRango muestra;
+    while (micros() - inicio < SEGUNDOS_BARRIDO * 1000000u) {
+        if (xQueueReceive(colaMuestras, &muestra, pdMS_TO_TICKS(100)) == pdTRUE &&
+            numMuestras < (int)(sizeof(muestras) / sizeof(muestras[0]))) {
+            muestras[numMuestras++] = muestra;
+        }
+    }
+
+    UNITY_BEGIN();
+    RUN_TEST(test_barrido_completo_con_muestras);
+    RUN_TEST(test_error_de_angulo_acotado);
+    simSalir(UNITY_END());
+}
+
+void loop() {}
@@ -0,0 +1,132 @@
+// AnilloSPSC: orden, capacidad y descartes en un hilo, y un productor y un
+// consumidor en hilos reales de la PC (en paralelo, no en el planificador
+// simulado) que se pasan un millón de elementos
+#include <Arduino.h>
+#include <unity.h>
+#include <thread>
+#include "simulacion.h"
+#include "anillospsc.h"
+
+// Campos que dependen del número: una copia a medio escribir no coincide
+struct ElementoPrueba {
+    uint32_t numero;
+    uint32_t inverso;
+    uint64_t cuadrado;
+};
+
+ElementoPrueba elementoNumero(uint32_t n) {
+    return {n, ~n, (uint64_t)n * n};
+}
+
+bool elementoCoherente(const ElementoPrueba &e) {
+    return e.inverso == ~e.numero && e.cuadrado == (uint64_t)e.numero * e.numero;
+}
+
+#define ELEMENTOS_PRUEBA 1000000u
+
+// Con una sola CPU yield() no le pasa el turno al otro hilo hasta el
+// próximo tick del sistema: se duerme un momento
+void esperarAlOtroHilo() {
+    std::this_thread::sleep_for(std::chrono::microseconds(20));
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_orden_y_capacidad() {
+    AnilloSPSC<int, 8> anillo;
+    int valor;
+    TEST_ASSERT_FALSE(anillo.extraer(valor));
+    for (int vuelta = 0; vuelta < 5; vuelta++) { // Da varias vueltas al arreglo
+        for (int i = 0; i < 8; i++) TEST_ASSERT_TRUE(anillo.insertar(vuelta * 10 + i));
+        TEST_ASSERT_EQUAL(8, anillo.disponibles());
+        TEST_ASSERT_FALSE(anillo.insertar(-1));
+        for (int i = 0; i < 5; i++) {
+            TEST_ASSERT_TRUE(anillo.extraer(valor));
+            TEST_ASSERT_EQUAL(vuelta * 10 + i, valor);
+        }
+        TEST_ASSERT_TRUE(anillo.insertar(100));
+        for (int i = 5; i < 8; i++) {
+            TEST_ASSERT_TRUE(anillo.extraer(valor));
+            TEST_ASSERT_EQUAL(vuelta * 10 + i, valor);
+        }
+        TEST_ASSERT_TRUE(anillo.extraer(valor));
+        TEST_ASSERT_EQUAL(100, valor);
+        TEST_ASSERT_EQUAL(0, anillo.disponibles());
+    }
+    TEST_ASSERT_EQUAL_UINT32(5, anillo.totalDescartados());
+}
+
+// El productor reintenta con el anillo lleno: no se pierde nada
+void test_dos_hilos_sin_perdidas() {
+    static AnilloSPSC<ElementoPrueba, 128> anillo;
+    uint32_t recibidos = 0, desordenados = 0, rotos = 0;
+    std::thread productor([] {
+        for (uint32_t n = 0; n < ELEMENTOS_PRUEBA; n++) {
+            while (!anillo.insertar(elementoNumero(n))) esperarAlOtroHilo();
+        }
+    });
+    std::thread consumidor([&] {
+        ElementoPrueba e;
+        while (recibidos < ELEMENTOS_PRUEBA) {
+            if (!anillo.extraer(e)) {
+                esperarAlOtroHilo();
+                continue;
+            }
+            if (e.numero != recibidos) desordenados++;
+            if (!elementoCoherente(e)) rotos++;
+            recibidos++;
+        }
+    });
+    productor.join();
+    consumidor.join();
+    TEST_ASSERT_EQUAL_UINT32(ELEMENTOS_PRUEBA, recibidos);
+    TEST_ASSERT_EQUAL_UINT32(0, desordenados);
+    TEST_ASSERT_EQUAL_UINT32(0, rotos);
+    TEST_ASSERT_EQUAL(0, anillo.disponibles());
+}
+
+// Como TaskMUESTRAS: no espera, lo que no entra se descarta y se cuenta
+void test_dos_hilos_con_descartes() {
+    static AnilloSPSC<ElementoPrueba, 16> anillo;
+    uint32_t insertados = 0, recibidos = 0, retrocesos = 0, rotos = 0;
+    std::atomic<bool> terminado{false};
+    std::thread productor([&] {
+        for (uint32_t n = 0; n < ELEMENTOS_PRUEBA; n++) {
+            if (anillo.insertar(elementoNumero(n))) insertados++;
+        }
+        terminado = true;
+    });
+    std::thread consumidor([&] {
+        ElementoPrueba e;
+        uint32_t siguiente = 0;
+        for (;;) {
+            bool fin = terminado;
+            if (!anillo.extraer(e)) {
+                if (fin) break; // Vacío después de que el productor terminó
+                esperarAlOtroHilo();
+                continue;
+            }
+            if (e.numero < siguiente) retrocesos++;
+            if (!elementoCoherente(e)) rotos++;
+            siguiente = e.numero + 1;
+            recibidos++;
+        }
+    });
+    productor.join();
+    consumidor.join();
+    TEST_ASSERT_EQUAL_UINT32(ELEMENTOS_PRUEBA, insertados + anillo.totalDescartados());
+    TEST_ASSERT_EQUAL_UINT32(insertados, recibidos);
+    TEST_ASSERT_EQUAL_UINT32(0, retrocesos);
+    TEST_ASSERT_EQUAL_UINT32(0, rotos);
+}
+
+void setup() {
+    UNITY_BEGIN();
+    RUN_TEST(test_orden_y_capacidad);
+    RUN_TEST(test_dos_hilos_sin_perdidas);
+    RUN_TEST(test_dos_hilos_con_descartes);
+    simSalir(UNITY_END());
+}
+
+void loop() {}
@@ -0,0 +1,128 @@
+// Barrera de un ciclo (barreraciclo.h) con su variante pthread: los
+// participantes son hilos de verdad y las esperas se miden con el reloj
+// monótono de la PC, no con el simulado
+#define BARRERA_CON_PTHREAD
+#include <Arduino.h>
+#include <unity.h>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include "simulacion.h"
+#include "barreraciclo.h"
+
+using Reloj = std::chrono::steady_clock;
+
+double milisegundosDesde(Reloj::time_point inicio) {
+    return std::chrono::duration<double, std::milli>(Reloj::now() - inicio).count();
+}
+
+// Cada participante avisa desde su hilo después de "demorasMs[i]"
+std::vector<std::thread> lanzarParticipantes(BarreraCiclo &barrera, const std::vector<int> &demorasMs) {
+    std::vector<std::thread> hilos;
+    for (size_t i = 0; i < demorasMs.size(); i++) {
+        hilos.emplace_back([&barrera, i, demora = demorasMs[i]] {
+            std::this_thread::sleep_for(std::chrono::milliseconds(demora));
+            barrera.avisar(i);
+        });
+    }
+    return hilos;
+}
+
+void unirHilos(std::vector<std::thread> &hilos) {
+    for (std::thread &h : hilos) h.join();
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_avisan_todos() {
+    BarreraCiclo barrera(3);
+    TEST_ASSERT_TRUE(barrera.iniciar());
+    barrera.abrirCiclo();
+    std::vector<std::thread> hilos = lanzarParticipantes(barrera, {5, 20, 40});
+    Reloj::time_point inicio = Reloj::now();
+    uint32_t faltantes = 0xFF;
+    TEST_ASSERT_TRUE(barrera.esperar(2000, &faltantes));
+    // Se despierta con el último aviso, no al vencer la espera
+    double ms = milisegundosDesde(inicio);
+    TEST_ASSERT_GREATER_OR_EQUAL_FLOAT(35.0, ms);
+    TEST_ASSERT_LESS_THAN_FLOAT(1000.0, ms);
+    TEST_ASSERT_EQUAL_HEX32(0, faltantes);
+    unirHilos(hilos);
+}
+
+void test_vence_e_informa_faltantes() {
+    BarreraCiclo barrera(4);
+    TEST_ASSERT_TRUE(barrera.iniciar());
+    barrera.abrirCiclo();
+    barrera.avisar(0);
+    barrera.avisar(2);
+    Reloj::time_point inicio = Reloj::now();
+    uint32_t faltantes = 0;
+    TEST_ASSERT_FALSE(barrera.esperar(150, &faltantes));
+    // El plazo sale del reloj monótono: dura lo pedido, con algo de holgura del planificador
+    double ms = milisegundosDesde(inicio);
+    TEST_ASSERT_GREATER_OR_EQUAL_FLOAT(150.0, ms);
+    TEST_ASSERT_LESS_THAN_FLOAT(650.0, ms);
+    TEST_ASSERT_EQUAL_HEX32(0b1010, faltantes);
+}
+
+void test_plazo_que_cruza_el_segundo() {
+    // 1999 ms suman más de 1e9 ns al tv_nsec en casi cualquier instante de partida
+    BarreraCiclo barrera(1);
+    TEST_ASSERT_TRUE(barrera.iniciar());
+    barrera.abrirCiclo();
+    Reloj::time_point inicio = Reloj::now();
+    TEST_ASSERT_FALSE(barrera.esperar(1999));
+    double ms = milisegundosDesde(inicio);
+    TEST_ASSERT_GREATER_OR_EQUAL_FLOAT(1999.0, ms);
+    TEST_ASSERT_LESS_THAN_FLOAT(2500.0, ms);
+}
+
+void test_aviso_tardio_vale_hasta_abrir_otro_ciclo() {
+    BarreraCiclo barrera(2);
+    TEST_ASSERT_TRUE(barrera.iniciar());
+    barrera.abrirCiclo();
+    std::vector<std::thread> hilos = lanzarParticipantes(barrera, {0, 200});
+    uint32_t faltantes = 0;
+    TEST_ASSERT_FALSE(barrera.esperar(50, &faltantes));
+    TEST_ASSERT_EQUAL_HEX32(0b10, faltantes);
+    unirHilos(hilos);
+    // El aviso tardío completa el ciclo vencido
+    TEST_ASSERT_TRUE(barrera.esperar(0, &faltantes));
+    TEST_ASSERT_EQUAL_HEX32(0, faltantes);
+    // Y no pasa al siguiente
+    barrera.abrirCiclo();
+    TEST_ASSERT_FALSE(barrera.esperar(0, &faltantes));
+    TEST_ASSERT_EQUAL_HEX32(0b11, faltantes);
+}
+
+void test_muchos_ciclos_seguidos() {
+    const int participantes = 24;
+    BarreraCiclo barrera(participantes);
+    TEST_ASSERT_TRUE(barrera.iniciar());
+    for (int ciclo = 0; ciclo < 50; ciclo++) {
+        barrera.abrirCiclo();
+        std::vector<std::thread> hilos = lanzarParticipantes(barrera, std::vector<int>(participantes, 0));
+        uint32_t faltantes = 0xFF;
+        TEST_ASSERT_TRUE(barrera.esperar(2000, &faltantes));
+        TEST_ASSERT_EQUAL_HEX32(0, faltantes);
+        unirHilos(hilos);
+    }
+    // Un participante fuera de rango no cuenta
+    barrera.abrirCiclo();
+    barrera.avisar(participantes);
+    TEST_ASSERT_FALSE(barrera.esperar(0));
+}
+
+void setup() {
+    UNITY_BEGIN();
+    RUN_TEST(test_avisan_todos);
+    RUN_TEST(test_vence_e_informa_faltantes);
+    RUN_TEST(test_plazo_que_cruza_el_segundo);
+    RUN_TEST(test_aviso_tardio_vale_hasta_abrir_otro_ciclo);
+    RUN_TEST(test_muchos_ciclos_seguidos);
+    simSalir(UNITY_END());
+}
+
+void loop() {}
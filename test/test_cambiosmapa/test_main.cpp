@@ -0,0 +1,167 @@
+// Cursor de cambios del mapa y /get-data incremental: un cliente que aplica
+// solo lo que cambió desde su cursor termina con el mismo mapa que el robot
+#include <Arduino.h>
+#include <unity.h>
+#include <set>
+#include <string>
+#include <utility>
+#include "apwifieeprommode.h"
+
+// Lo que apwifieeprommode.h espera de main.cpp
+WebServer server(80);
+MapaRobot mapa;
+int numPuntos = 0;
+AnguloBinario ultimoAngulo = 0;
+uint16_t ultimaDistancia = 0;
+AnilloSPSC<MuestraRango, 128> anilloMuestras;
+std::atomic<uint32_t> muestrasIntegradas{0};
+int32_t pasosSensor() { return 0; }
+AnguloBinario anguloSensorEnPasos(int32_t pasos) { return (AnguloBinario)pasos; }
+
+typedef std::set<std::pair<int32_t, int32_t>> Celdas;
+
+// Rayos pseudoaleatorios (siempre los mismos) desde adentro de un cuadrado
+// de 1.6 m hacia sus paredes: las paredes se ocupan con las lecturas que se
+// repiten y los rayos que pasan cerca las vuelven a liberar
+uint32_t semilla = 12345;
+int32_t azar(int32_t minimo, int32_t maximo) {
+    semilla = semilla * 1664525u + 1013904223u;
+    return minimo + (int32_t)((semilla >> 8) % (uint32_t)(maximo - minimo + 1));
+}
+
+template <typename Mapa>
+void integrarRayosAlAzar(Mapa &m, int rayos) {
+    for (int i = 0; i < rayos; i++) {
+        int32_t x0 = azar(-700, 700), y0 = azar(-700, 700);
+        int32_t a = azar(-800, 800), x1, y1;
+        switch (azar(0, 3)) {
+            case 0: x1 = a; y1 = 800; break;
+            case 1: x1 = a; y1 = -800; break;
+            case 2: x1 = 800; y1 = a; break;
+            default: x1 = -800; y1 = a; break;
+        }
+        m.integrarRayo(x0, y0, x1, y1, azar(0, 9) < 8);
+    }
+}
+
+template <typename Mapa>
+Celdas ocupadasDe(const Mapa &m) {
+    Celdas celdas;
+    m.recorrerOcupadas([&](int32_t x, int32_t y) { celdas.insert({x, y}); });
+    return celdas;
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_cursor_reproduce_el_mapa() {
+    MapaOcupacion<40, 40, 50, 4096> m;
+    Celdas espejo;
+    uint32_t cursor = 0;
+    for (int ronda = 0; ronda < 200; ronda++) {
+        integrarRayosAlAzar(m, 20);
+        TEST_ASSERT_TRUE(m.hayCambiosDesde(cursor));
+        TEST_ASSERT_TRUE(m.recorrerCambiosDesde(cursor, [&](int32_t x, int32_t y, bool ocupada) {
+            if (ocupada) espejo.insert({x, y}); else espejo.erase({x, y});
+        }));
+        cursor = m.secuencia();
+        TEST_ASSERT_EQUAL(m.totalOcupadas(), (int)espejo.size());
+        TEST_ASSERT_TRUE(espejo == ocupadasDe(m));
+    }
+    // También hubo celdas que se liberaron
+    TEST_ASSERT_GREATER_THAN(m.totalOcupadas(), m.secuencia());
+}
+
+void test_cursor_vencido_o_ajeno() {
+    MapaOcupacion<40, 40, 50, 16> m;
+    integrarRayosAlAzar(m, 10);
+    uint32_t cursor = m.secuencia();
+    TEST_ASSERT_TRUE(m.hayCambiosDesde(cursor)); // Sin cambios nuevos sigue valiendo
+    int llamadas = 0;
+    TEST_ASSERT_TRUE(m.recorrerCambiosDesde(cursor, [&](int32_t, int32_t, bool) { llamadas++; }));
+    TEST_ASSERT_EQUAL(0, llamadas);
+    // Cursor de otro arranque, más adelante que este mapa
+    TEST_ASSERT_FALSE(m.hayCambiosDesde(m.secuencia() + 1));
+    // Más cambios que el registro: los del cursor ya se pisaron
+    while (m.secuencia() - cursor <= 16) integrarRayosAlAzar(m, 1);
+    TEST_ASSERT_FALSE(m.hayCambiosDesde(cursor));
+    TEST_ASSERT_FALSE(m.recorrerCambiosDesde(cursor, [&](int32_t, int32_t, bool) { llamadas++; }));
+    TEST_ASSERT_EQUAL(0, llamadas);
+    TEST_ASSERT_TRUE(m.hayCambiosDesde(m.secuencia() - 16));
+}
+
+// --- /get-data como lo usa la página ---
+
+uint32_t campoNatural(const std::string &json, const char *campo) {
+    size_t p = json.find(std::string("\"") + campo + "\":");
+    TEST_ASSERT_TRUE(p != std::string::npos);
+    return strtoul(json.c_str() + p + strlen(campo) + 3, NULL, 10);
+}
+
+// Aplica una respuesta al espejo; devuelve si era completa
+bool aplicarRespuesta(const std::string &json, Celdas &espejo) {
+    bool completo = json.find("\"completo\":true") != std::string::npos;
+    const char *lista = completo ? "\"obstaculos\":[" : "\"cambios\":[";
+    size_t p = json.find(lista);
+    TEST_ASSERT_TRUE(p != std::string::npos);
+    if (completo) espejo.clear();
+    const char *c = json.c_str() + p + strlen(lista);
+    while (*c == '[') {
+        int x, y, ocupada = 1, leidos;
+        if (completo) {
+            TEST_ASSERT_EQUAL(2, sscanf(c, "[%d,%d]%n", &x, &y, &leidos));
+        } else {
+            TEST_ASSERT_EQUAL(3, sscanf(c, "[%d,%d,%d]%n", &x, &y, &ocupada, &leidos));
+        }
+        if (ocupada) espejo.insert({x, y}); else espejo.erase({x, y});
+        c += leidos;
+        if (*c == ',') c++;
+    }
+    TEST_ASSERT_EQUAL_STRING("]}", c);
+    return completo;
+}
+
+void test_get_data_incremental() {
+    registrarRutas();
+    idArranque = 777;
+    Celdas espejo;
+    uint32_t cursor = 0, arranque = 0;
+    int incrementales = 0;
+    size_t bytesIncrementales = 0;
+    integrarRayosAlAzar(mapa, 200); // Cursor 0 es "sin cursor": que el primero ya tenga cambios
+    for (int ronda = 0; ronda < 100; ronda++) {
+        integrarRayosAlAzar(mapa, 10);
+        String uri = "/get-data?since=" + String((unsigned long)cursor) + "&arranque=" + String((unsigned long)arranque);
+        RespuestaHttp r = server.atender(uri);
+        TEST_ASSERT_EQUAL(200, r.codigo);
+        bool completo = aplicarRespuesta(r.cuerpo, espejo);
+        // Solo la primera vez (sin cursor ni arranque) hace falta todo
+        TEST_ASSERT_EQUAL(ronda == 0, completo);
+        if (!completo) {
+            incrementales++;
+            bytesIncrementales += r.cuerpo.size();
+        }
+        cursor = campoNatural(r.cuerpo, "seq");
+        arranque = campoNatural(r.cuerpo, "arranque");
+        TEST_ASSERT_TRUE(espejo == ocupadasDe(mapa));
+    }
+    TEST_ASSERT_EQUAL(99, incrementales);
+
+    // Un cursor de otro arranque (el robot se reinició) recibe el mapa completo
+    RespuestaHttp r = server.atender("/get-data?since=" + String((unsigned long)cursor) + "&arranque=1");
+    Celdas nuevo;
+    TEST_ASSERT_TRUE(aplicarRespuesta(r.cuerpo, nuevo));
+    TEST_ASSERT_TRUE(nuevo == ocupadasDe(mapa));
+    // Y el mapa completo pesa más que los cambios de cada ronda
+    TEST_ASSERT_GREATER_THAN(bytesIncrementales / incrementales, r.cuerpo.size());
+}
+
+void setup() {
+    UNITY_BEGIN();
+    RUN_TEST(test_cursor_reproduce_el_mapa);
+    RUN_TEST(test_cursor_vencido_o_ajeno);
+    RUN_TEST(test_get_data_incremental);
+    simSalir(UNITY_END());
+}
+
+void loop() {}
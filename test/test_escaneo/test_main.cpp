@@ -0,0 +1,87 @@
+// Escaneo al ritmo del sensor: cada medición se lee apenas está lista (sin
+// pausas fijas entre lecturas) y lleva la posición del haz a mitad de su
+// ventana. Con el lector por consulta, sin el cable de GPIO1.
+#define MUESTREO_POR_INTERRUPCION 0
+#include <Arduino.h>
+#include <unity.h>
+#include "lectorvl53l0x.h"
+
+// Barrido simulado: el haz avanza un paso por ms, 4096 pasos por vuelta
+#define PASOS_VUELTA_PRUEBA 4096
+
+int32_t pasosSensor() {
+    return (int32_t)(micros() / 1000);
+}
+
+AnguloBinario anguloSensorEnPasos(int32_t pasos) {
+    return (AnguloBinario)((int64_t)pasos * 65536 / PASOS_VUELTA_PRUEBA);
+}
+
+// Hace de odometría: registra la pose cada 5 ms
+void TaskPOSE(void *pvParameters) {
+    for (;;) {
+        registrarPose(micros(), {0, 0, 0});
+        vTaskDelay(pdMS_TO_TICKS(5));
+    }
+}
+
+#define SEGUNDOS_ESCANEO 10
+uint32_t inicioSensorUs = 0;
+MuestraRango muestras[SEGUNDOS_ESCANEO * 40];
+int numMuestras = 0;
+
+void setUp() {}
+void tearDown() {}
+
+void test_una_muestra_por_ventana() {
+    uint32_t esperadas = SEGUNDOS_ESCANEO * 1000000u / halVentanaSensorUs();
+    TEST_ASSERT_UINT32_WITHIN(2, esperadas, numMuestras);
+    // Antes eran 73 lecturas separadas por delay(200): 5 por segundo
+    TEST_ASSERT_GREATER_OR_EQUAL(29 * SEGUNDOS_ESCANEO, numMuestras);
+    TEST_ASSERT_EQUAL_UINT32(0, muestrasDescartadas);
+}
+
+void test_cada_medicion_se_lee_en_el_tick_en_que_esta_lista() {
+    uint32_t ventana = halVentanaSensorUs();
+    for (int i = 0; i < numMuestras; i++) {
+        // Fin de la ventana de la muestra, contado desde que arrancó el sensor
+        uint32_t lectura = muestras[i].tiempoUs + ventana / 2 - inicioSensorUs;
+        TEST_ASSERT_LESS_OR_EQUAL_UINT32(1000, lectura % ventana);
+        if (i > 0) {
+            // Ni repetidas ni salteadas
+            TEST_ASSERT_UINT32_WITHIN(1000, ventana, muestras[i].tiempoUs - muestras[i - 1].tiempoUs);
+        }
+    }
+}
+
+void test_angulo_del_haz_a_mitad_de_la_ventana() {
+    // La primera no tiene una lectura anterior para interpolar
+    for (int i = 1; i < numMuestras; i++) {
+        AnguloBinario esperado = anguloSensorEnPasos((int32_t)(muestras[i].tiempoUs / 1000));
+        int16_t error = (int16_t)(muestras[i].angulo - esperado);
+        TEST_ASSERT_INT_WITHIN(65536 / PASOS_VUELTA_PRUEBA, 0, error);
+    }
+}
+
+void setup() {
+    xTaskCreatePinnedToCore(TaskPOSE, "TaskPOSE", 2048, NULL, 3, NULL, 1);
+    inicioSensorUs = micros();
+    halIniciarSensor(500);
+    iniciarLectorSensor(1);
+    uint32_t inicio = micros();
+    MuestraRango muestra;
+    while (micros() - inicio < SEGUNDOS_ESCANEO * 1000000u) {
+        if (xQueueReceive(colaMuestras, &muestra, pdMS_TO_TICKS(100)) == pdTRUE &&
+            numMuestras < (int)(sizeof(muestras) / sizeof(muestras[0]))) {
+            muestras[numMuestras++] = muestra;
+        }
+    }
+
+    UNITY_BEGIN();
+    RUN_TEST(test_una_muestra_por_ventana);
+    RUN_TEST(test_cada_medicion_se_lee_en_el_tick_en_que_esta_lista);
+    RUN_TEST(test_angulo_del_haz_a_mitad_de_la_ventana);
+    simSalir(UNITY_END());
+}
+
+void loop() {}
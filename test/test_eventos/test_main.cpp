@@ -0,0 +1,244 @@
+// Canal de eventos: aceptar un cliente no bloquea al servidor aunque el
+// pedido llegue de a partes, los que no lo terminan pierden el lugar, los
+// eventos llevan el mapa completo primero y después solo los cambios, y un
+// cliente que no lee no frena a los demás
+#include <Arduino.h>
+#include <unity.h>
+#include <set>
+#include <string>
+#include <utility>
+#include "apwifieeprommode.h"
+#include "eventos.h"
+
+// Lo que apwifieeprommode.h y eventos.h esperan de main.cpp
+WebServer server(80);
+MapaRobot mapa;
+int numPuntos = 0;
+AnguloBinario ultimoAngulo = 0;
+uint16_t ultimaDistancia = 0;
+AnilloSPSC<MuestraRango, 128> anilloMuestras;
+std::atomic<uint32_t> muestrasIntegradas{0};
+std::atomic<uint32_t> versionPose{0};
+int32_t pasosSensor() { return 0; }
+AnguloBinario anguloSensorEnPasos(int32_t pasos) { return (AnguloBinario)pasos; }
+
+const char *PEDIDO_EVENTOS = "GET /eventos HTTP/1.1\r\nHost: 192.168.4.1:81\r\nAccept: text/event-stream\r\n\r\n";
+
+bool contiene(const std::string &texto, const char *parte) {
+    return texto.find(parte) != std::string::npos;
+}
+
+int clientesActivos() {
+    int n = 0;
+    for (int i = 0; i < MAX_CLIENTES_EVENTOS; i++) n += clientesEventos[i].activo;
+    return n;
+}
+
+// Una vuelta del servidor por tick, como TaskSERVIDOR. Ninguna vuelta
+// puede quedarse esperando a un cliente.
+void vueltasServidor(int ms) {
+    for (int i = 0; i < ms; i++) {
+        uint32_t antes = micros();
+        atenderEventos();
+        TEST_ASSERT_EQUAL_UINT32(antes, micros());
+        vTaskDelay(1);
+    }
+}
+
+typedef std::set<std::pair<int, int>> Celdas;
+
+// Aplica los eventos completos que llegaron a una copia del mapa, como
+// web/index.html
+Celdas copiaDelMapa(const std::string &salida) {
+    Celdas copia;
+    size_t p = 0;
+    while ((p = salida.find("data: ", p)) != std::string::npos) {
+        size_t fin = salida.find("\n\n", p);
+        if (fin == std::string::npos) break; // Llegó a medias
+        std::string evento = salida.substr(p, fin - p);
+        p = fin;
+        bool completo = contiene(evento, "\"completo\":true");
+        if (completo) copia.clear();
+        const char *c = evento.c_str() + evento.find(completo ? "\"obstaculos\":[" : "\"cambios\":[");
+        c = strchr(c, '[') + 1;
+        int x, y, ocupada = 1, n = 0;
+        while (*c == '[') {
+            int leidos = completo ? sscanf(c, "[%d,%d]%n", &x, &y, &n) : sscanf(c, "[%d,%d,%d]%n", &x, &y, &ocupada, &n);
+            TEST_ASSERT_EQUAL(completo ? 2 : 3, leidos);
+            if (ocupada) copia.insert({x, y});
+            else copia.erase({x, y});
+            c += n;
+            if (*c == ',') c++;
+        }
+    }
+    return copia;
+}
+
+Celdas celdasDelMapa() {
+    Celdas celdas;
+    mapa.recorrerOcupadas([&](int32_t x, int32_t y) { celdas.insert({x, y}); });
+    return celdas;
+}
+
+int eventosRecibidos(const std::string &salida) {
+    int n = 0;
+    for (size_t p = 0; (p = salida.find("data: ", p)) != std::string::npos; p++) n++;
+    return n;
+}
+
+// Lee el mismo punto desde el origen hasta que queda ocupado
+void obstaculo(int32_t x, int32_t y) {
+    while (!mapa.ocupadaEn(x, y)) mapa.integrarRayo(0, 0, x, y, true);
+}
+
+// Una pared a "radio" mm alrededor del origen: más celdas que las de un evento
+void paredCircular(int radio) {
+    for (int grado = 0; grado < 360; grado++) {
+        obstaculo(lround(radio * cos(grado * M_PI / 180)), lround(radio * sin(grado * M_PI / 180)));
+    }
+}
+
+std::shared_ptr<ConexionSimulada> conectarCliente() {
+    auto conexion = servidorEventos.conectar();
+    conexion->entrada = PEDIDO_EVENTOS;
+    vueltasServidor(1);
+    TEST_ASSERT_TRUE(contiene(conexion->salida, "200 OK"));
+    return conexion;
+}
+
+void setUp() {}
+
+// Cada prueba empieza sin clientes
+void tearDown() {
+    for (int i = 0; i < MAX_CLIENTES_EVENTOS; i++) {
+        if (clientesEventos[i].activo) clientesEventos[i].conexion.stop();
+    }
+    atenderEventos();
+}
+
+void test_pedido_en_partes_sin_bloquear() {
+    auto conexion = servidorEventos.conectar();
+    const std::string pedido = PEDIDO_EVENTOS;
+    // Llega de a 7 bytes, uno por vuelta: ninguna vuelta espera al cliente
+    for (size_t i = 0; i < pedido.size(); i += 7) {
+        TEST_ASSERT_FALSE(contiene(conexion->salida, "200 OK"));
+        conexion->entrada += pedido.substr(i, 7);
+        vueltasServidor(1);
+    }
+    TEST_ASSERT_TRUE(contiene(conexion->salida, "HTTP/1.1 200 OK\r\n"));
+    TEST_ASSERT_TRUE(contiene(conexion->salida, "Content-Type: text/event-stream"));
+    TEST_ASSERT_FALSE(contiene(conexion->salida, "data: "));
+
+    // Con el pedido completo empiezan los eventos, el primero con el mapa entero
+    vueltasServidor(5);
+    TEST_ASSERT_TRUE(contiene(conexion->salida, "data: {"));
+    TEST_ASSERT_TRUE(contiene(conexion->salida, "\"completo\":true"));
+
+    conexion->salida.clear();
+    mapa.integrarRayo(0, 0, 500, 0, true);
+    mapa.integrarRayo(0, 0, 500, 0, true);
+    mapa.integrarRayo(0, 0, 500, 0, true);
+    mapa.integrarRayo(0, 0, 500, 0, true);
+    vueltasServidor(2 * INTERVALO_EVENTOS_MS);
+    TEST_ASSERT_TRUE(contiene(conexion->salida, "\"completo\":false,\"cambios\":[[525,25,1]]"));
+}
+
+void test_sin_terminar_el_pedido_pierde_el_lugar() {
+    auto lento = servidorEventos.conectar();
+    lento->entrada = "GET /eventos HTTP/1.1\r\nHost: 192.168"; // Y nada más
+    vueltasServidor(ESPERA_PEDIDO_EVENTOS_MS - 100);
+    TEST_ASSERT_EQUAL(1, clientesActivos());
+    TEST_ASSERT_TRUE(lento->abierta);
+    vueltasServidor(200);
+    TEST_ASSERT_EQUAL(0, clientesActivos());
+    TEST_ASSERT_FALSE(lento->abierta);
+    TEST_ASSERT_EQUAL(0, lento->salida.size());
+}
+
+void test_sin_lugar_responde_503() {
+    std::shared_ptr<ConexionSimulada> conexiones[MAX_CLIENTES_EVENTOS];
+    for (int i = 0; i < MAX_CLIENTES_EVENTOS; i++) {
+        conexiones[i] = servidorEventos.conectar();
+        conexiones[i]->entrada = PEDIDO_EVENTOS;
+        vueltasServidor(1);
+    }
+    auto demas = servidorEventos.conectar();
+    demas->entrada = PEDIDO_EVENTOS;
+    vueltasServidor(10);
+    TEST_ASSERT_TRUE(contiene(demas->salida, "503"));
+    TEST_ASSERT_FALSE(demas->abierta);
+    for (int i = 0; i < MAX_CLIENTES_EVENTOS; i++) {
+        TEST_ASSERT_TRUE(contiene(conexiones[i]->salida, "data: {"));
+    }
+}
+
+void test_cliente_trabado_no_frena_a_los_demas() {
+    auto normal = conectarCliente();
+    auto trabado = conectarCliente();
+    vueltasServidor(10);
+    trabado->capacidad = 0; // El navegador dejó de leer: el socket está lleno
+    size_t recibido = trabado->salida.size();
+
+    paredCircular(1500);
+    int eventosAntes = eventosRecibidos(normal->salida);
+    for (int i = 0; i < 10; i++) {
+        obstaculo(-700, 300 + 60 * i);
+        vueltasServidor(200);
+    }
+    // El otro cliente siguió recibiendo y tiene el mapa al día
+    TEST_ASSERT_GREATER_THAN(eventosAntes + 5, eventosRecibidos(normal->salida));
+    TEST_ASSERT_TRUE(copiaDelMapa(normal->salida) == celdasDelMapa());
+    TEST_ASSERT_EQUAL(recibido, trabado->salida.size());
+    TEST_ASSERT_EQUAL(2, clientesActivos());
+
+    // Al destrabarse recibe lo que había quedado pendiente y después todo lo
+    // que cambió, juntado en pocos eventos en vez de uno por vuelta
+    trabado->capacidad = SIZE_MAX;
+    vueltasServidor(2 * INTERVALO_EVENTOS_MS);
+    TEST_ASSERT_TRUE(copiaDelMapa(trabado->salida) == celdasDelMapa());
+    TEST_ASSERT_LESS_THAN(10, eventosRecibidos(trabado->salida.substr(recibido)));
+}
+
+void test_cliente_trabado_pierde_el_lugar() {
+    auto trabado = conectarCliente();
+    vueltasServidor(10);
+    trabado->capacidad = 0;
+    obstaculo(400, -600);
+    vueltasServidor(ESPERA_CLIENTE_TRABADO_MS - 100);
+    TEST_ASSERT_EQUAL(1, clientesActivos());
+    vueltasServidor(200);
+    TEST_ASSERT_EQUAL(0, clientesActivos());
+    TEST_ASSERT_FALSE(trabado->abierta);
+}
+
+void test_cliente_lento_recibe_el_mapa_por_partes() {
+    paredCircular(1000);
+    TEST_ASSERT_GREATER_THAN(2 * CELDAS_POR_EVENTO, (int)celdasDelMapa().size());
+    auto conexion = servidorEventos.conectar();
+    conexion->capacidad = 7; // Unos pocos bytes por vuelta, ya desde las cabeceras
+    conexion->entrada = PEDIDO_EVENTOS;
+    vueltasServidor(2000);
+    TEST_ASSERT_TRUE(conexion->abierta);
+    TEST_ASSERT_GREATER_THAN(2, eventosRecibidos(conexion->salida));
+    TEST_ASSERT_TRUE(copiaDelMapa(conexion->salida) == celdasDelMapa());
+}
+
+// Una pared ya vista antes de que se conecte nadie
+void paredInicial() {
+    for (int i = 0; i < 4; i++) mapa.integrarRayo(0, 0, 0, 800, true);
+}
+
+void setup() {
+    paredInicial();
+    iniciarEventos();
+    UNITY_BEGIN();
+    RUN_TEST(test_pedido_en_partes_sin_bloquear);
+    RUN_TEST(test_sin_terminar_el_pedido_pierde_el_lugar);
+    RUN_TEST(test_sin_lugar_responde_503);
+    RUN_TEST(test_cliente_trabado_no_frena_a_los_demas);
+    RUN_TEST(test_cliente_trabado_pierde_el_lugar);
+    RUN_TEST(test_cliente_lento_recibe_el_mapa_por_partes);
+    simSalir(UNITY_END());
+}
+
+void loop() {}
@@ -0,0 +1,123 @@
+// Lector del VL53L0X por interrupción de GPIO1, contra el sensor simulado de
+// hal_nativo.h: qué llega a la cola, timeouts, cola llena y qué muestras
+// sirven para el mapa según su estado de rango
+#include <Arduino.h>
+#include <unity.h>
+#include "lectorvl53l0x.h"
+
+int32_t pasosSensor() {
+    return 0;
+}
+
+AnguloBinario anguloSensorEnPasos(int32_t pasos) {
+    return (AnguloBinario)pasos;
+}
+
+void TaskPOSE(void *pvParameters) {
+    for (;;) {
+        registrarPose(micros(), {0, 0, 0});
+        vTaskDelay(pdMS_TO_TICKS(5));
+    }
+}
+
+// Cada medición distinta, para reconocerla del otro lado de la cola
+uint16_t medicionesModelo = 0;
+bool sensorCaido = false;
+bool modeloPrueba(LecturaSensor &lectura) {
+    if (sensorCaido) return false;
+    medicionesModelo++;
+    lectura.distancia = 100 + medicionesModelo;
+    lectura.calidad = medicionesModelo * 3;
+    lectura.estado = medicionesModelo % 2 ? ESTADO_RANGO_VALIDO : 7; // Sigma fuera de límite
+    return true;
+}
+
+uint32_t inicioSensorUs = 0;
+
+void vaciarCola() {
+    MuestraRango muestra;
+    while (xQueueReceive(colaMuestras, &muestra, 0) == pdTRUE) {}
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_muestras_con_la_lectura_del_sensor() {
+    vaciarCola();
+    MuestraRango muestra;
+    TEST_ASSERT_TRUE(xQueueReceive(colaMuestras, &muestra, pdMS_TO_TICKS(100)) == pdTRUE);
+    uint16_t anterior = muestra.distancia;
+    for (int i = 0; i < 50; i++) {
+        TEST_ASSERT_TRUE(xQueueReceive(colaMuestras, &muestra, pdMS_TO_TICKS(100)) == pdTRUE);
+        uint16_t n = muestra.distancia - 100;
+        TEST_ASSERT_EQUAL_UINT16(anterior + 1, muestra.distancia); // Ninguna perdida
+        TEST_ASSERT_EQUAL_UINT16(n * 3, muestra.calidad);
+        TEST_ASSERT_EQUAL_UINT8(n % 2 ? ESTADO_RANGO_VALIDO : 7, muestra.estado);
+        // El aviso llega al final de la ventana; la muestra vale a mitad de ella
+        uint32_t ventana = halVentanaSensorUs();
+        TEST_ASSERT_EQUAL_UINT32(ventana / 2, (muestra.tiempoUs - inicioSensorUs) % ventana);
+        anterior = muestra.distancia;
+    }
+}
+
+void test_timeout_sin_mediciones() {
+    uint32_t timeouts = timeoutsSensor;
+    sensorCaido = true;
+    vTaskDelay(pdMS_TO_TICKS(1000));
+    // Uno por cada timeout del sensor (100 ms) sin aviso
+    TEST_ASSERT_UINT32_WITHIN(1, 10, timeoutsSensor - timeouts);
+    vaciarCola();
+    sensorCaido = false;
+    MuestraRango muestra;
+    TEST_ASSERT_TRUE(xQueueReceive(colaMuestras, &muestra, pdMS_TO_TICKS(100)) == pdTRUE);
+}
+
+void test_cola_llena_descarta_y_cuenta() {
+    vaciarCola();
+    uint32_t descartadas = muestrasDescartadas;
+    uint16_t antes = medicionesModelo;
+    vTaskDelay(pdMS_TO_TICKS(2000));
+    uint16_t medidas = medicionesModelo - antes;
+    TEST_ASSERT_EQUAL_UINT32(LONGITUD_COLA_MUESTRAS, uxQueueMessagesWaiting(colaMuestras));
+    TEST_ASSERT_EQUAL_UINT32(medidas - LONGITUD_COLA_MUESTRAS, muestrasDescartadas - descartadas);
+    vaciarCola();
+}
+
+MuestraRango muestraCon(uint16_t distancia, uint8_t estado) {
+    MuestraRango muestra = {};
+    muestra.distancia = distancia;
+    muestra.estado = estado;
+    return muestra;
+}
+
+void test_clasificar_por_estado_y_distancia() {
+    TEST_ASSERT_EQUAL(MUESTRA_IMPACTO, clasificarMuestra(muestraCon(500, 11), 30, 2000));
+    TEST_ASSERT_EQUAL(MUESTRA_DESCARTADA, clasificarMuestra(muestraCon(30, 11), 30, 2000));
+    TEST_ASSERT_EQUAL(MUESTRA_LIBRE, clasificarMuestra(muestraCon(2000, 11), 30, 2000));
+    TEST_ASSERT_EQUAL(MUESTRA_LIBRE, clasificarMuestra(muestraCon(2600, 11), 30, 2000));
+    // Sin retorno: nada al alcance
+    TEST_ASSERT_EQUAL(MUESTRA_LIBRE, clasificarMuestra(muestraCon(8190, 4), 30, 2000));
+    TEST_ASSERT_EQUAL(MUESTRA_LIBRE, clasificarMuestra(muestraCon(8191, 2), 30, 2000));
+    // Sigma, señal o fase fuera de límites: la distancia no es confiable
+    TEST_ASSERT_EQUAL(MUESTRA_DESCARTADA, clasificarMuestra(muestraCon(500, 7), 30, 2000));
+    TEST_ASSERT_EQUAL(MUESTRA_DESCARTADA, clasificarMuestra(muestraCon(500, 2), 30, 2000));
+    TEST_ASSERT_EQUAL(MUESTRA_DESCARTADA, clasificarMuestra(muestraCon(3000, 4), 30, 2000));
+    TEST_ASSERT_EQUAL(MUESTRA_DESCARTADA, clasificarMuestra(muestraCon(0, 0), 30, 2000));
+}
+
+void setup() {
+    xTaskCreatePinnedToCore(TaskPOSE, "TaskPOSE", 2048, NULL, 3, NULL, 1);
+    modeloSensorNativo = modeloPrueba;
+    inicioSensorUs = micros();
+    halIniciarSensor(100);
+    iniciarLectorSensor(1);
+
+    UNITY_BEGIN();
+    RUN_TEST(test_muestras_con_la_lectura_del_sensor);
+    RUN_TEST(test_timeout_sin_mediciones);
+    RUN_TEST(test_cola_llena_descarta_y_cuenta);
+    RUN_TEST(test_clasificar_por_estado_y_distancia);
+    simSalir(UNITY_END());
+}
+
+void loop() {}
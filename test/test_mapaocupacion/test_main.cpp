@@ -0,0 +1,128 @@
+// Grilla de ocupación (mapaocupacion.h): qué celdas toca un rayo, los límites
+// del log-odds, y cuánto cuesta integrar un rayo en la PC comparado con el
+// período del sensor
+#include <Arduino.h>
+#include <unity.h>
+#include <chrono>
+#include <math.h>
+#include "simulacion.h"
+#include "mapaocupacion.h"
+
+// El mapa del robot es de 25 KB: se deja fuera de la pila
+MapaRobot mapa;
+
+#define RES MAPA_RESOLUCION_MM
+#define PERIODO_SENSOR_US 33000 // Presupuesto de tiempo del VL53L0X en el robot
+#define RAYOS_BANCO 200000
+
+// Centro de la celda que queda "n" celdas a la derecha del origen
+int32_t mmDeCelda(int n) {
+    return n * RES + RES / 2;
+}
+
+int celdaDelOrigen(int n) {
+    return MAPA_CELDAS / 2 + n;
+}
+
+void setUp() {
+    mapa = MapaRobot();
+}
+
+void tearDown() {}
+
+void test_rayo_horizontal_libera_el_camino_y_marca_el_impacto() {
+    mapa.integrarRayo(mmDeCelda(0), mmDeCelda(0), mmDeCelda(10), mmDeCelda(0), true);
+    for (int i = 0; i < 10; i++) {
+        TEST_ASSERT_EQUAL_INT(-MapaRobot::DECREMENTO_LIBRE, mapa.valor(celdaDelOrigen(i), celdaDelOrigen(0)));
+    }
+    TEST_ASSERT_EQUAL_INT(MapaRobot::INCREMENTO_OCUPADA, mapa.valor(celdaDelOrigen(10), celdaDelOrigen(0)));
+    // Ni una celda más allá del impacto ni a los costados
+    TEST_ASSERT_EQUAL_INT(0, mapa.valor(celdaDelOrigen(11), celdaDelOrigen(0)));
+    TEST_ASSERT_EQUAL_INT(0, mapa.valor(celdaDelOrigen(5), celdaDelOrigen(1)));
+    TEST_ASSERT_EQUAL_INT(0, mapa.valor(celdaDelOrigen(5), celdaDelOrigen(-1)));
+}
+
+void test_rayo_diagonal_es_continuo() {
+    mapa.integrarRayo(mmDeCelda(0), mmDeCelda(0), mmDeCelda(-20), mmDeCelda(7), true);
+    // Bresenham: una celda por columna entre el origen y el impacto
+    int libres = 0;
+    for (int cy = 0; cy < MAPA_CELDAS; cy++) {
+        for (int cx = 0; cx < MAPA_CELDAS; cx++) libres += mapa.valor(cx, cy) < 0;
+    }
+    TEST_ASSERT_EQUAL_INT(20, libres);
+    TEST_ASSERT_TRUE(mapa.valor(celdaDelOrigen(-20), celdaDelOrigen(7)) > 0);
+}
+
+void test_sin_impacto_solo_libera() {
+    mapa.integrarRayo(mmDeCelda(0), mmDeCelda(0), mmDeCelda(0), mmDeCelda(-40), false);
+    TEST_ASSERT_TRUE(mapa.valor(celdaDelOrigen(0), celdaDelOrigen(-40)) < 0);
+    TEST_ASSERT_EQUAL_INT(0, mapa.totalOcupadas());
+}
+
+void test_la_pared_se_refuerza_sin_duplicarse() {
+    for (int i = 0; i < 100; i++) {
+        mapa.integrarRayo(mmDeCelda(0), mmDeCelda(0), mmDeCelda(12), mmDeCelda(0), true);
+    }
+    // Cien lecturas de la misma pared son una celda ocupada, saturada en el límite
+    TEST_ASSERT_EQUAL_INT(1, mapa.totalOcupadas());
+    TEST_ASSERT_EQUAL_INT(MapaRobot::LIMITE, mapa.valor(celdaDelOrigen(12), celdaDelOrigen(0)));
+    TEST_ASSERT_TRUE(mapa.ocupadaEn(mmDeCelda(12), mmDeCelda(0)));
+    TEST_ASSERT_EQUAL_INT(-MapaRobot::LIMITE, mapa.valor(celdaDelOrigen(6), celdaDelOrigen(0)));
+    // El espacio libre vuelve a ocuparse si aparece un obstáculo
+    for (int i = 0; i < 100; i++) {
+        mapa.integrarRayo(mmDeCelda(6), mmDeCelda(5), mmDeCelda(6), mmDeCelda(0), true);
+    }
+    TEST_ASSERT_TRUE(mapa.ocupada(celdaDelOrigen(6), celdaDelOrigen(0)));
+    TEST_ASSERT_EQUAL_INT(2, mapa.totalOcupadas());
+}
+
+void test_rayo_que_sale_del_mapa() {
+    int32_t borde = MAPA_CELDAS / 2 * RES;
+    mapa.integrarRayo(borde - RES, 0, borde + 5 * RES, 0, true);
+    TEST_ASSERT_EQUAL_INT(0, mapa.totalOcupadas());
+    TEST_ASSERT_TRUE(mapa.valor(MAPA_CELDAS - 1, celdaDelOrigen(0)) < 0);
+    // Un origen fuera del mapa no escribe nada
+    mapa.integrarRayo(borde + 10 * RES, 0, 0, 0, true);
+    TEST_ASSERT_EQUAL_INT(0, mapa.totalOcupadas());
+}
+
+// Rayos de 0,3 a 2 m en todas las direcciones desde puntos cerca del centro,
+// como los del escaneo: el costo por muestra tiene que caber con holgura en
+// el período del sensor
+void test_costo_por_rayo() {
+    static int32_t extremos[1024][4];
+    for (int i = 0; i < 1024; i++) {
+        double angulo = i * (2 * M_PI / 1024);
+        int32_t distancia = 300 + (i * 37) % 1700;
+        int32_t x0 = (i % 16) * 20 - 160, y0 = (i / 64) * 20 - 160;
+        extremos[i][0] = x0;
+        extremos[i][1] = y0;
+        extremos[i][2] = x0 + (int32_t)lround(distancia * cos(angulo));
+        extremos[i][3] = y0 + (int32_t)lround(distancia * sin(angulo));
+    }
+    auto inicio = std::chrono::steady_clock::now();
+    for (int i = 0; i < RAYOS_BANCO; i++) {
+        const int32_t *e = extremos[i & 1023];
+        mapa.integrarRayo(e[0], e[1], e[2], e[3], (i & 3) != 0);
+    }
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - inicio).count() / RAYOS_BANCO;
+    char detalle[80];
+    snprintf(detalle, sizeof(detalle), "%.1f ns por rayo, %d celdas ocupadas", ns, mapa.totalOcupadas());
+    TEST_MESSAGE(detalle);
+    TEST_ASSERT_TRUE(mapa.totalOcupadas() > 0);
+    // Aun 100 veces más lento en el ESP32 queda por debajo de un 1% del período
+    TEST_ASSERT_LESS_THAN_FLOAT(PERIODO_SENSOR_US * 1000 / 100 / 100.0, ns);
+}
+
+void setup() {
+    UNITY_BEGIN();
+    RUN_TEST(test_rayo_horizontal_libera_el_camino_y_marca_el_impacto);
+    RUN_TEST(test_rayo_diagonal_es_continuo);
+    RUN_TEST(test_sin_impacto_solo_libera);
+    RUN_TEST(test_la_pared_se_refuerza_sin_duplicarse);
+    RUN_TEST(test_rayo_que_sale_del_mapa);
+    RUN_TEST(test_costo_por_rayo);
+    simSalir(UNITY_END());
+}
+
+void loop() {}
@@ -0,0 +1,190 @@
+// Pasos desde el temporizador (motorespasos.h): cuántos pasos da cada eje y
+// con qué perfil de velocidad, leídos de las bobinas del HAL de la PC
+#include <Arduino.h>
+#include <unity.h>
+#include <vector>
+#include "motorespasos.h"
+
+// El perfil de main.cpp: 800 pasos/s, 400 pasos/s², rampa de 800 pasos
+#define VELOCIDAD_PRUEBA 800
+#define ACELERACION_PRUEBA 400
+
+// Instante (µs simulados) de cada paso de cada eje
+std::vector<int64_t> pasos[NUM_EJES];
+int32_t posicionAnterior[NUM_EJES];
+
+void anotarPasos(uint64_t salidas) {
+    (void)salidas;
+    for (int eje = 0; eje < NUM_EJES; eje++) {
+        int32_t posicion = posicionEje(eje);
+        // FULL4WIRE cambia las bobinas en cada paso: a lo sumo uno por llamada y eje
+        if (posicion != posicionAnterior[eje]) pasos[eje].push_back(halTiempoUs());
+        posicionAnterior[eje] = posicion;
+    }
+}
+
+// Segundos entre el primer paso y el paso n (desde 1) del eje
+double segundosHastaPaso(int eje, size_t n) {
+    return (pasos[eje][n - 1] - pasos[eje][0]) / 1e6;
+}
+
+// Pasos por segundo medidos entre los pasos desde..hasta del eje
+double velocidadEntre(int eje, size_t desde, size_t hasta) {
+    return (hasta - desde) * 1e6 / (pasos[eje][hasta] - pasos[eje][desde]);
+}
+
+// Lo mismo según el modelo de un movimiento de n pasos: después del paso h
+// va a sqrt(2·a·(k + 1)) pasos/s, con k los pasos hasta el borde más cercano,
+// hasta la velocidad máxima
+double segundosModelo(size_t n, size_t desde, size_t hasta) {
+    double segundos = 0;
+    for (size_t h = desde; h < hasta; h++) {
+        size_t k = h < n - 1 - h ? h : n - 1 - h;
+        segundos += 1 / fmin(VELOCIDAD_PRUEBA, sqrt(2.0 * ACELERACION_PRUEBA * (k + 1)));
+    }
+    return segundos;
+}
+
+void setUp() {
+    for (int eje = 0; eje < NUM_EJES; eje++) {
+        pasos[eje].clear();
+        posicionAnterior[eje] = posicionEje(eje);
+    }
+}
+
+void tearDown() {}
+
+void test_eje_da_los_pasos_pedidos() {
+    const int32_t pedidos[] = {1, 2, 37, 2048, -500, -1};
+    for (int32_t n : pedidos) {
+        setUp();
+        int32_t antes = posicionEje(EJE_RADAR);
+        TEST_ASSERT_TRUE(esperarEjes(moverEjeAsync(EJE_RADAR, n), pdMS_TO_TICKS(20000)));
+        TEST_ASSERT_EQUAL_INT32(n, posicionEje(EJE_RADAR) - antes);
+        TEST_ASSERT_EQUAL(abs(n), pasos[EJE_RADAR].size());
+        TEST_ASSERT_EQUAL(0, pasos[EJE_IZQUIERDO].size());
+        TEST_ASSERT_FALSE(ejeEnMovimiento(EJE_RADAR));
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, moverEjeAsync(EJE_RADAR, 0));
+}
+
+void test_perfil_trapezoidal() {
+    esperarEjes(moverEjeAsync(EJE_RADAR, 2048));
+    TEST_ASSERT_EQUAL(2048, pasos[EJE_RADAR].size());
+    // Con a = 400 pasos/s², los primeros 200 pasos tardan ~sqrt(2·200/a) = 1 s
+    TEST_ASSERT_FLOAT_WITHIN(0.01, segundosModelo(2048, 1, 200), segundosHastaPaso(EJE_RADAR, 200));
+    // Crucero a la velocidad máxima entre las dos rampas de 800 pasos
+    TEST_ASSERT_FLOAT_WITHIN(VELOCIDAD_PRUEBA * 0.01, VELOCIDAD_PRUEBA, velocidadEntre(EJE_RADAR, 850, 1200));
+    // Frena con la misma tabla
+    TEST_ASSERT_FLOAT_WITHIN(0.01, segundosModelo(2048, 1848, 2048),
+                             segundosHastaPaso(EJE_RADAR, 2048) - segundosHastaPaso(EJE_RADAR, 1848));
+    // ~2 s de cada rampa más 448 pasos a 800 pasos/s
+    TEST_ASSERT_FLOAT_WITHIN(0.02, segundosModelo(2048, 1, 2048), segundosHastaPaso(EJE_RADAR, 2048));
+    // Nunca pasa del máximo más allá de un tick de redondeo
+    for (size_t i = 1; i < pasos[EJE_RADAR].size(); i++) {
+        TEST_ASSERT_GREATER_OR_EQUAL(1000000 / VELOCIDAD_PRUEBA - 100, pasos[EJE_RADAR][i] - pasos[EJE_RADAR][i - 1]);
+    }
+}
+
+void test_movimiento_corto_es_triangular() {
+    esperarEjes(moverEjeAsync(EJE_RADAR, 400));
+    TEST_ASSERT_EQUAL(400, pasos[EJE_RADAR].size());
+    // Pico a mitad de camino: sqrt(2·a·200) = 400 pasos/s, lejos del máximo
+    double pico = velocidadEntre(EJE_RADAR, 190, 210);
+    TEST_ASSERT_FLOAT_WITHIN(20, 400, pico);
+    TEST_ASSERT_FLOAT_WITHIN(0.02, segundosModelo(400, 1, 400), segundosHastaPaso(EJE_RADAR, 400));
+}
+
+void test_tope_del_eje() {
+    configurarVelocidadEje(EJE_RADAR, 300);
+    esperarEjes(moverEjeAsync(EJE_RADAR, 1000));
+    configurarVelocidadEje(EJE_RADAR, 0);
+    TEST_ASSERT_FLOAT_WITHIN(3, 300, velocidadEntre(EJE_RADAR, 300, 700));
+    // Frena desde el tope, no desde donde hubiera llegado sin él
+    TEST_ASSERT_FLOAT_WITHIN(0.05, sqrt(2.0 * 100 / ACELERACION_PRUEBA),
+                             segundosHastaPaso(EJE_RADAR, 1000) - segundosHastaPaso(EJE_RADAR, 900));
+}
+
+void test_ruedas_empiezan_y_terminan_juntas() {
+    int32_t izquierda = posicionEje(EJE_IZQUIERDO), derecha = posicionEje(EJE_DERECHO);
+    encolarSegmentoRuedas(600, -200);
+    esperarRuedas();
+    TEST_ASSERT_EQUAL_INT32(600, posicionEje(EJE_IZQUIERDO) - izquierda);
+    TEST_ASSERT_EQUAL_INT32(-200, posicionEje(EJE_DERECHO) - derecha);
+    TEST_ASSERT_EQUAL(600, pasos[EJE_IZQUIERDO].size());
+    TEST_ASSERT_EQUAL(200, pasos[EJE_DERECHO].size());
+    // La rueda menor da un paso cada tres de la mayor, desde el principio hasta el final
+    const std::vector<int64_t> &maestro = pasos[EJE_IZQUIERDO], &menor = pasos[EJE_DERECHO];
+    TEST_ASSERT_TRUE(menor.front() <= maestro[2]);
+    TEST_ASSERT_TRUE(menor.back() >= maestro[597]);
+    for (size_t i = 0; i < menor.size(); i++) {
+        TEST_ASSERT_TRUE(menor[i] >= maestro[3 * i] && menor[i] <= maestro[3 * i + 2]);
+    }
+}
+
+void test_cadena_no_frena_entre_segmentos() {
+    // Dos rectas seguidas: una sola rampa de 2000 pasos, sin parar en el medio
+    encolarSegmentoRuedas(1000, 1000);
+    encolarSegmentoRuedas(1000, 1000);
+    esperarRuedas();
+    TEST_ASSERT_EQUAL(2000, pasos[EJE_IZQUIERDO].size());
+    TEST_ASSERT_FLOAT_WITHIN(VELOCIDAD_PRUEBA * 0.01, VELOCIDAD_PRUEBA, velocidadEntre(EJE_IZQUIERDO, 980, 1020));
+    // ~2 s de cada rampa más 400 pasos a 800 pasos/s (separadas serían 2 x ~3 s)
+    TEST_ASSERT_FLOAT_WITHIN(0.02, segundosModelo(2000, 1, 2000), segundosHastaPaso(EJE_IZQUIERDO, 2000));
+}
+
+void test_cambio_de_sentido_arranca_de_parado() {
+    encolarSegmentoRuedas(500, 500);
+    encolarSegmentoRuedas(-500, -500);
+    esperarRuedas();
+    TEST_ASSERT_EQUAL(1000, pasos[EJE_IZQUIERDO].size());
+    // Cada tramo frena hasta el primer escalón de la rampa antes de invertir
+    double primerEscalon = sqrt(2.0 * ACELERACION_PRUEBA);
+    TEST_ASSERT_LESS_THAN_FLOAT(primerEscalon * 2, velocidadEntre(EJE_IZQUIERDO, 498, 501));
+    // Dos triángulos de 500 pasos y la espera de un paso a la velocidad inicial entre ellos
+    double esperado = 2 * segundosModelo(500, 1, 500) + 1 / sqrt(2.0 * ACELERACION_PRUEBA);
+    TEST_ASSERT_FLOAT_WITHIN(0.02, esperado, segundosHastaPaso(EJE_IZQUIERDO, 1000));
+}
+
+void test_extender_cadena_que_frena_no_salta() {
+    // La primera recta ya está frenando cuando llega la segunda: la rampa
+    // vuelve a subir desde donde está, un escalón por paso
+    int32_t inicio = posicionEje(EJE_IZQUIERDO);
+    encolarSegmentoRuedas(1000, 1000);
+    while (posicionEje(EJE_IZQUIERDO) - inicio < 800) vTaskDelay(1);
+    encolarSegmentoRuedas(1000, 1000);
+    esperarRuedas();
+    TEST_ASSERT_EQUAL(2000, pasos[EJE_IZQUIERDO].size());
+    // v² sube 2·a por paso: 2·a·10 entre ventanas de 10 pasos seguidas. El
+    // redondeo de cada paso al tick de 100 µs mueve la medida hasta ~2·a·10
+    // más; un salto de la rampa a media cadena sube más de 10 veces eso
+    for (size_t i = 0; i + 30 < pasos[EJE_IZQUIERDO].size(); i += 5) {
+        double antes = velocidadEntre(EJE_IZQUIERDO, i, i + 10);
+        double despues = velocidadEntre(EJE_IZQUIERDO, i + 10, i + 20);
+        TEST_ASSERT_LESS_OR_EQUAL_FLOAT(2 * ACELERACION_PRUEBA * 10 * 3, despues * despues - antes * antes);
+    }
+    // Y el frenado de la primera no llegó hasta parar
+    TEST_ASSERT_GREATER_THAN_FLOAT(200, velocidadEntre(EJE_IZQUIERDO, 990, 1010));
+}
+
+void setup() {
+    configurarEje(EJE_IZQUIERDO, 14, 26, 27, 25);
+    configurarEje(EJE_DERECHO, 19, 5, 18, 32);
+    configurarEje(EJE_RADAR, 23, 4, 33, 2);
+    configurarPerfil(VELOCIDAD_PRUEBA, ACELERACION_PRUEBA);
+    iniciarMotores();
+    alCambiarBobinas = anotarPasos;
+
+    UNITY_BEGIN();
+    RUN_TEST(test_eje_da_los_pasos_pedidos);
+    RUN_TEST(test_perfil_trapezoidal);
+    RUN_TEST(test_movimiento_corto_es_triangular);
+    RUN_TEST(test_tope_del_eje);
+    RUN_TEST(test_ruedas_empiezan_y_terminan_juntas);
+    RUN_TEST(test_cadena_no_frena_entre_segmentos);
+    RUN_TEST(test_cambio_de_sentido_arranca_de_parado);
+    RUN_TEST(test_extender_cadena_que_frena_no_salta);
+    simSalir(UNITY_END());
+}
+
+void loop() {}
@@ -0,0 +1,234 @@
+// Odometría en punto fijo (traccion.h) y poses interpoladas (estadorobot.h)
+// contra una referencia en double: recorridos al azar con rectas, arcos y
+// giros, e instantes al azar entre poses registradas, también con micros()
+// dando la vuelta
+#include <Arduino.h>
+#include <unity.h>
+#include <atomic>
+#include <math.h>
+#include "simulacion.h"
+#include "traccion.h"
+
+std::atomic<uint32_t> versionPose{0};
+
+// xorshift32: los mismos recorridos en cada corrida
+uint32_t azar = 2463534242u;
+uint32_t siguienteAzar() {
+    azar ^= azar << 13;
+    azar ^= azar >> 17;
+    azar ^= azar << 5;
+    return azar;
+}
+
+// Entero al azar en [minimo, maximo]
+int32_t azarEntre(int32_t minimo, int32_t maximo) {
+    return minimo + (int32_t)(siguienteAzar() % (uint32_t)(maximo - minimo + 1));
+}
+
+// Pose de referencia: mm y radianes en double, integrando cada tramo como el
+// arco exacto que describen las dos ruedas
+struct PoseReferencia {
+    double x, y, rumbo;
+};
+
+const double MM_POR_MEDIO_PASO = 1.0 / PASOS_POR_MM / 2;
+const double RADIANES_POR_MEDIO_PASO = PI / 180 / PASOS_POR_GRADO / 2;
+
+void avanzarReferencia(PoseReferencia &p, int32_t pasosIzquierda, int32_t pasosDerecha) {
+    double avance = (pasosIzquierda + pasosDerecha) * MM_POR_MEDIO_PASO;
+    double giro = (pasosDerecha - pasosIzquierda) * RADIANES_POR_MEDIO_PASO;
+    if (fabs(giro) < 1e-12) {
+        p.x += avance * cos(p.rumbo);
+        p.y += avance * sin(p.rumbo);
+    } else {
+        double radio = avance / giro;
+        p.x += radio * (sin(p.rumbo + giro) - sin(p.rumbo));
+        p.y += radio * (cos(p.rumbo) - cos(p.rumbo + giro));
+    }
+    p.rumbo += giro;
+}
+
+// Mueve las ruedas sin el temporizador de pasos y deja correr un periodo de odometría
+void darPasos(int32_t izquierda, int32_t derecha) {
+    ejes[EJE_IZQUIERDO].posicion = ejes[EJE_IZQUIERDO].posicion + izquierda;
+    ejes[EJE_DERECHO].posicion = ejes[EJE_DERECHO].posicion + derecha;
+    delay(PERIODO_ODOMETRIA_MS);
+    actualizarOdometria();
+}
+
+double errorPosicionMm(const PoseReferencia &r) {
+    return hypot(poseOdometria.x / 1000.0 - r.x, poseOdometria.y / 1000.0 - r.y);
+}
+
+// En unidades de ángulo binario, por el lado corto
+double errorRumbo(const PoseReferencia &r) {
+    double referencia = r.rumbo * 65536 / (2 * PI);
+    return fabs(remainder(poseOdometria.angulo - referencia, 65536.0));
+}
+
+void setUp() {
+    ejes[EJE_IZQUIERDO].posicion = 0;
+    ejes[EJE_DERECHO].posicion = 0;
+    odometriaIzquierda = 0;
+    odometriaDerecha = 0;
+    acumuladoX = 0;
+    acumuladoY = 0;
+    poseOdometria = {0, 0, 0};
+    posesRegistradas = 0;
+}
+
+void tearDown() {}
+
+void test_recta_queda_sobre_el_eje() {
+    for (int i = 0; i < 1000; i++) darPasos(8, 8);
+    TEST_ASSERT_EQUAL_INT32(0, poseOdometria.y);
+    TEST_ASSERT_EQUAL_UINT16(0, poseOdometria.angulo);
+    // cos(0) en Q15 es 32767/32768: sobre los ejes se avanza 30 µm por metro de menos
+    double esperado = 8000 * MM_POR_MEDIO_PASO * 2 * 1000;
+    TEST_ASSERT_FLOAT_WITHIN(esperado / UNO_Q15 + 1, esperado, poseOdometria.x);
+}
+
+void test_giro_en_el_lugar_no_traslada() {
+    PoseReferencia r = {0, 0, 0};
+    for (int i = 0; i < 2000; i++) {
+        int32_t pasos = azarEntre(-8, 8);
+        darPasos(-pasos, pasos);
+        avanzarReferencia(r, -pasos, pasos);
+        TEST_ASSERT_EQUAL_INT32(0, poseOdometria.x);
+        TEST_ASSERT_EQUAL_INT32(0, poseOdometria.y);
+    }
+    // El rumbo sale de la diferencia total: redondeo de una sola vez
+    TEST_ASSERT_LESS_OR_EQUAL_FLOAT(1.0, errorRumbo(r));
+}
+
+void test_recorrido_al_azar_sigue_a_la_referencia() {
+    PoseReferencia r = {0, 0, 0};
+    double recorridoMm = 0, peorPosicion = 0, peorRumbo = 0;
+    // Tramos de 0,1 a 2 s: rectas, arcos, pivotes y giros en el lugar, a
+    // hasta 8 pasos por rueda cada 10 ms (800 pasos/s, el tope del perfil)
+    for (int tramo = 0; tramo < 300; tramo++) {
+        int32_t izquierda = azarEntre(-8, 8), derecha;
+        switch (siguienteAzar() % 4) {
+        case 0: derecha = izquierda; break;
+        case 1: derecha = -izquierda; break;
+        case 2: derecha = 0; break;
+        default: derecha = azarEntre(-8, 8); break;
+        }
+        int periodos = azarEntre(10, 200);
+        for (int i = 0; i < periodos; i++) {
+            darPasos(izquierda, derecha);
+            avanzarReferencia(r, izquierda, derecha);
+            recorridoMm += fabs(izquierda + derecha) * MM_POR_MEDIO_PASO;
+            peorPosicion = fmax(peorPosicion, errorPosicionMm(r));
+            peorRumbo = fmax(peorRumbo, errorRumbo(r));
+        }
+    }
+    TEST_ASSERT_GREATER_THAN_FLOAT(3000.0, recorridoMm);
+    // El rumbo de la referencia tampoco acumula: queda el redondeo del último
+    TEST_ASSERT_LESS_OR_EQUAL_FLOAT(1.0, peorRumbo);
+    // Metros proyectados con el rumbo medio en Q15: a lo sumo una décima de
+    // milímetro de diferencia con el arco exacto (~10 µm en esta corrida)
+    TEST_ASSERT_LESS_THAN_FLOAT(0.1, peorPosicion);
+}
+
+void test_vuelta_completa_cierra() {
+    // Un círculo sobre la rueda derecha quieta vuelve al punto de partida
+    int32_t vuelta = lround(2 * PI / RADIANES_POR_MEDIO_PASO);
+    int32_t dados = 0;
+    while (dados < vuelta) {
+        int32_t pasos = vuelta - dados < 8 ? vuelta - dados : 8;
+        darPasos(pasos, 0);
+        dados += pasos;
+    }
+    TEST_ASSERT_INT32_WITHIN(100, 0, poseOdometria.x);
+    TEST_ASSERT_INT32_WITHIN(100, 0, poseOdometria.y);
+    PoseReferencia r = {0, 0, 0};
+    avanzarReferencia(r, vuelta, 0);
+    TEST_ASSERT_LESS_THAN_FLOAT(0.1, errorPosicionMm(r));
+    TEST_ASSERT_LESS_OR_EQUAL_FLOAT(1.0, errorRumbo(r));
+}
+
+// --- poseEnInstante ---
+
+// Lo que da interpolar en double entre dos poses del historial, en µm y
+// unidades de ángulo binario
+PoseReferencia interpolarReferencia(const PoseFechada &a, const PoseFechada &b, uint32_t t) {
+    double f = (double)(uint32_t)(t - a.tiempoUs) / (uint32_t)(b.tiempoUs - a.tiempoUs);
+    double giro = (int16_t)(b.pose.angulo - a.pose.angulo);
+    return {a.pose.x + (b.pose.x - a.pose.x) * f, a.pose.y + (b.pose.y - a.pose.y) * f, a.pose.angulo + giro * f};
+}
+
+// Registra "n" poses a intervalos de 5 a 15 ms desde "inicio", moviéndose
+// hasta 20 mm y 20° por intervalo (más que el robot), y las deja en "poses"
+void registrarPosesAlAzar(uint32_t inicio, int n, PoseFechada *poses) {
+    PoseFechada actual = {inicio, {azarEntre(-2000000, 2000000), azarEntre(-2000000, 2000000), (AnguloBinario)siguienteAzar()}};
+    for (int i = 0; i < n; i++) {
+        registrarPose(actual.tiempoUs, actual.pose);
+        poses[i] = actual;
+        actual.tiempoUs += azarEntre(5000, 15000);
+        actual.pose.x += azarEntre(-20000, 20000);
+        actual.pose.y += azarEntre(-20000, 20000);
+        actual.pose.angulo += azarEntre(-3641, 3641);
+    }
+}
+
+void comprobarInterpolacion(uint32_t inicio) {
+    PoseFechada poses[LONGITUD_HISTORIAL_POSES];
+    registrarPosesAlAzar(inicio, LONGITUD_HISTORIAL_POSES, poses);
+    double peorPosicion = 0, peorRumbo = 0;
+    for (int k = 0; k < 20000; k++) {
+        int i = azarEntre(0, LONGITUD_HISTORIAL_POSES - 2);
+        uint32_t t = poses[i].tiempoUs + (uint32_t)azarEntre(0, (int32_t)(poses[i + 1].tiempoUs - poses[i].tiempoUs));
+        PoseRobot pose;
+        TEST_ASSERT_TRUE(poseEnInstante(t, pose));
+        PoseReferencia r = interpolarReferencia(poses[i], poses[i + 1], t);
+        peorPosicion = fmax(peorPosicion, fmax(fabs(pose.x - r.x), fabs(pose.y - r.y)));
+        peorRumbo = fmax(peorRumbo, fabs(remainder(pose.angulo - r.rumbo, 65536.0)));
+    }
+    // La fracción en Q16 y el redondeo hacia abajo: 1 µm más 20 mm / 65536
+    TEST_ASSERT_LESS_THAN_FLOAT(1.5, peorPosicion);
+    TEST_ASSERT_LESS_THAN_FLOAT(1.5, peorRumbo);
+}
+
+void test_interpolacion_sigue_a_la_referencia() {
+    comprobarInterpolacion(1000000);
+}
+
+void test_interpolacion_con_micros_dando_la_vuelta() {
+    // El historial cruza el desborde de micros() a la mitad
+    comprobarInterpolacion(0xFFFFFFFFu - LONGITUD_HISTORIAL_POSES / 2 * 10000);
+}
+
+void test_bordes_del_historial() {
+    PoseFechada poses[LONGITUD_HISTORIAL_POSES * 2];
+    registrarPosesAlAzar(5000000, LONGITUD_HISTORIAL_POSES * 2, poses);
+    const PoseFechada &ultima = poses[LONGITUD_HISTORIAL_POSES * 2 - 1];
+    const PoseFechada &masVieja = poses[LONGITUD_HISTORIAL_POSES];
+    PoseRobot pose;
+    // Después de la última todavía no se sabe
+    TEST_ASSERT_FALSE(poseEnInstante(ultima.tiempoUs + 1, pose));
+    // En un instante registrado, esa pose tal cual
+    TEST_ASSERT_TRUE(poseEnInstante(ultima.tiempoUs, pose));
+    TEST_ASSERT_EQUAL_INT32(ultima.pose.x, pose.x);
+    TEST_ASSERT_EQUAL_INT32(ultima.pose.y, pose.y);
+    TEST_ASSERT_EQUAL_UINT16(ultima.pose.angulo, pose.angulo);
+    // Antes de todo el historial (las primeras ya se pisaron), la más vieja
+    TEST_ASSERT_TRUE(poseEnInstante(poses[0].tiempoUs, pose));
+    TEST_ASSERT_EQUAL_INT32(masVieja.pose.x, pose.x);
+    TEST_ASSERT_EQUAL_INT32(masVieja.pose.y, pose.y);
+    TEST_ASSERT_EQUAL_UINT16(masVieja.pose.angulo, pose.angulo);
+}
+
+void setup() {
+    UNITY_BEGIN();
+    RUN_TEST(test_recta_queda_sobre_el_eje);
+    RUN_TEST(test_giro_en_el_lugar_no_traslada);
+    RUN_TEST(test_recorrido_al_azar_sigue_a_la_referencia);
+    RUN_TEST(test_vuelta_completa_cierra);
+    RUN_TEST(test_interpolacion_sigue_a_la_referencia);
+    RUN_TEST(test_interpolacion_con_micros_dando_la_vuelta);
+    RUN_TEST(test_bordes_del_historial);
+    simSalir(UNITY_END());
+}
+
+void loop() {}
@@ -0,0 +1,122 @@
+// Plataforma nativa y HAL de la PC: el reloj simulado, los temporizadores,
+// las bobinas y el sensor que usan las demás pruebas
+#include <Arduino.h>
+#include <unity.h>
+#include <atomic>
+#include "hal.h"
+
+uint32_t cambiosBobinas = 0;
+uint64_t ultimasSalidas = 0;
+void contarCambios(uint64_t salidas) {
+    cambiosBobinas++;
+    ultimasSalidas = salidas;
+}
+
+std::atomic<uint32_t> interrupcionesPasos{0};
+void isrPasosPrueba() {
+    interrupcionesPasos++;
+}
+
+std::atomic<uint32_t> avisosSensor{0};
+void isrSensorPrueba() {
+    avisosSensor++;
+}
+
+bool medicionesPerdidas = false;
+bool modeloPrueba(LecturaSensor &lectura) {
+    if (medicionesPerdidas) return false;
+    lectura = {1234, 0x0280, 11};
+    return true;
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_esperas_avanzan_el_reloj_simulado() {
+    int64_t inicio = halTiempoUs();
+    uint32_t inicioMicros = micros();
+    vTaskDelay(pdMS_TO_TICKS(250));
+    TEST_ASSERT_EQUAL(250000, halTiempoUs() - inicio);
+    TEST_ASSERT_EQUAL_UINT32(250000, micros() - inicioMicros);
+    // Calcular no consume tiempo simulado
+    int64_t antes = halTiempoUs();
+    volatile uint32_t suma = 0;
+    for (uint32_t i = 0; i < 1000000; i++) suma = suma + i;
+    TEST_ASSERT_EQUAL(antes, halTiempoUs());
+}
+
+void test_temporizador_de_pasos_a_la_frecuencia_pedida() {
+    halIniciarTemporizadorPasos(10000, isrPasosPrueba);
+    vTaskDelay(pdMS_TO_TICKS(10));
+    TEST_ASSERT_EQUAL_UINT32(0, interrupcionesPasos); // Detenido hasta arrancarlo
+    halArrancarTemporizadorPasos();
+    vTaskDelay(pdMS_TO_TICKS(100));
+    TEST_ASSERT_UINT32_WITHIN(1, 1000, interrupcionesPasos.load());
+    halDetenerTemporizadorPasos();
+    uint32_t detenido = interrupcionesPasos;
+    vTaskDelay(pdMS_TO_TICKS(100));
+    TEST_ASSERT_EQUAL_UINT32(detenido, interrupcionesPasos);
+}
+
+void test_bobinas_avisan_solo_los_cambios() {
+    alCambiarBobinas = contarCambios;
+    halEscribirBobinas(1u << 12 | 1u << 27, 0, 1u << (33 - 32), 0);
+    TEST_ASSERT_EQUAL_UINT32(1, cambiosBobinas);
+    TEST_ASSERT_TRUE(ultimasSalidas == ((1ull << 12) | (1ull << 27) | (1ull << 33)));
+    halEscribirBobinas(1u << 12, 0, 0, 0); // Ya encendida
+    TEST_ASSERT_EQUAL_UINT32(1, cambiosBobinas);
+    halEscribirBobinas(0, 1u << 27, 0, 1u << (33 - 32));
+    TEST_ASSERT_EQUAL_UINT32(2, cambiosBobinas);
+    TEST_ASSERT_TRUE(ultimasSalidas == (1ull << 12));
+    halEscribirBobinas(0, 1u << 12, 0, 0);
+    alCambiarBobinas = NULL;
+}
+
+void test_sensor_avisa_una_medicion_por_ventana() {
+    TEST_ASSERT_TRUE(halIniciarSensor(100));
+    TEST_ASSERT_EQUAL_UINT16(100, halTimeoutSensorMs());
+    halAvisarMedicionLista(isrSensorPrueba);
+    int64_t inicio = halTiempoUs();
+    vTaskDelay(pdMS_TO_TICKS(1000));
+    uint32_t esperados = (uint32_t)((halTiempoUs() - inicio) / halVentanaSensorUs());
+    TEST_ASSERT_UINT32_WITHIN(1, esperados, avisosSensor);
+    TEST_ASSERT_TRUE(halMedicionLista());
+
+    // Sin modelo: fuera de rango
+    LecturaSensor lectura;
+    halLeerMedicion(lectura);
+    TEST_ASSERT_FALSE(halMedicionLista());
+    TEST_ASSERT_EQUAL_UINT16(8190, lectura.distancia);
+    TEST_ASSERT_EQUAL_UINT8(4, lectura.estado);
+
+    // Con modelo: la lectura que deja el modelo
+    modeloSensorNativo = modeloPrueba;
+    uint32_t antes = avisosSensor;
+    while (avisosSensor == antes) vTaskDelay(1);
+    halLeerMedicion(lectura);
+    TEST_ASSERT_EQUAL_UINT16(1234, lectura.distancia);
+    TEST_ASSERT_EQUAL_UINT16(0x0280, lectura.calidad);
+    TEST_ASSERT_EQUAL_UINT8(11, lectura.estado);
+
+    // El modelo puede perder mediciones: no hay aviso
+    medicionesPerdidas = true;
+    antes = avisosSensor;
+    vTaskDelay(pdMS_TO_TICKS(200));
+    TEST_ASSERT_EQUAL_UINT32(antes, avisosSensor);
+    TEST_ASSERT_FALSE(halMedicionLista());
+    medicionesPerdidas = false;
+    vTaskDelay(pdMS_TO_TICKS(40));
+    TEST_ASSERT_GREATER_THAN_UINT32(antes, avisosSensor);
+    modeloSensorNativo = NULL;
+}
+
+void setup() {
+    UNITY_BEGIN();
+    RUN_TEST(test_esperas_avanzan_el_reloj_simulado);
+    RUN_TEST(test_temporizador_de_pasos_a_la_frecuencia_pedida);
+    RUN_TEST(test_bobinas_avisan_solo_los_cambios);
+    RUN_TEST(test_sensor_avisa_una_medicion_por_ventana);
+    simSalir(UNITY_END());
+}
+
+void loop() {}
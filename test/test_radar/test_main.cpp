@@ -0,0 +1,184 @@
+// Barrido del radar (radar.h) sobre el temporizador de pasos simulado: qué
+// ángulos cubre una pasada en cada modo y qué pasa con el radar quieto. Al
+// final, que /radar rechace parámetros fuera de rango sin tocar nada
+#include <Arduino.h>
+#include <EEPROM.h>
+#include <unity.h>
+#include "apwifieeprommode.h"
+
+// Lo que apwifieeprommode.h espera de main.cpp
+WebServer server(80);
+MapaRobot mapa;
+int numPuntos = 0;
+AnguloBinario ultimoAngulo = 0;
+uint16_t ultimaDistancia = 0;
+AnilloSPSC<MuestraRango, 128> anilloMuestras;
+std::atomic<uint32_t> muestrasIntegradas{0};
+int32_t pasosSensor() { return 0; }
+AnguloBinario anguloSensorEnPasos(int32_t pasos) { return (AnguloBinario)pasos; }
+
+#define PASOS_VUELTA 2048
+
+// Grados del haz cubiertos mientras se espera una pasada, de a 1°
+bool cubiertos[360];
+
+void TaskANOTAR(void *pvParameters) {
+    for (;;) {
+        int grado = (int)lroundf(anguloRadar() + 180) % 360;
+        cubiertos[grado] = true;
+        vTaskDelay(1);
+    }
+}
+
+int gradosCubiertos() {
+    int n = 0;
+    for (bool c : cubiertos) n += c;
+    return n;
+}
+
+void setUp() {
+    for (bool &c : cubiertos) c = false;
+}
+
+void tearDown() {}
+
+void test_conversiones_de_calibracion() {
+    for (float grados = -179; grados <= 180; grados += 7.5f) {
+        TEST_ASSERT_FLOAT_WITHIN(360.0f / PASOS_VUELTA, grados, gradosRadarDesdePasos(pasosRadarDesdeGrados(grados)));
+        int32_t pasos = pasosRadarDesdeGrados(grados);
+        float binario = gradosDesdeAnguloBinario(anguloBinarioRadarDesdePasos(pasos));
+        TEST_ASSERT_FLOAT_WITHIN(0.01f, fmodf(gradosRadarDesdePasos(pasos) + 360, 360), binario);
+    }
+}
+
+void test_vaiven_cubre_la_vuelta() {
+    configurarBarrido(RADAR_VAIVEN, 180, 90);
+    esperarPasadaRadar(); // Llegar a un extremo desde donde esté
+    setUp();
+    int64_t inicio = halTiempoUs();
+    TEST_ASSERT_TRUE(esperarPasadaRadar());
+    // Una pasada de -180° a +180° a 90°/s son 4 s más ~1,3 s de rampas. La que
+    // está en curso al empezar no cuenta: la espera dura entre una y dos pasadas
+    double segundos = (halTiempoUs() - inicio) / 1e6;
+    TEST_ASSERT_GREATER_OR_EQUAL_FLOAT(5.0, segundos);
+    TEST_ASSERT_LESS_OR_EQUAL_FLOAT(11.0, segundos);
+    TEST_ASSERT_GREATER_OR_EQUAL(358, gradosCubiertos());
+}
+
+void test_vaiven_angosto_cubre_solo_su_amplitud() {
+    configurarBarrido(RADAR_VAIVEN, 45, 90);
+    esperarPasadaRadar();
+    setUp();
+    TEST_ASSERT_TRUE(esperarPasadaRadar());
+    TEST_ASSERT_INT_WITHIN(3, 91, gradosCubiertos());
+    TEST_ASSERT_TRUE(cubiertos[180 - 45] && cubiertos[180 + 45]);
+    TEST_ASSERT_FALSE(cubiertos[180 - 60] || cubiertos[180 + 60]);
+}
+
+void test_continuo_cuenta_vueltas() {
+    configurarBarrido(RADAR_CONTINUO, 180, 90);
+    uint32_t antes = pasadasRadar.load();
+    setUp();
+    TEST_ASSERT_TRUE(esperarPasadaRadar());
+    TEST_ASSERT_GREATER_OR_EQUAL(358, gradosCubiertos());
+    TEST_ASSERT_EQUAL_UINT32(2, pasadasRadar.load() - antes);
+    // Una vuelta a 90°/s son 4 s; la que está en curso al empezar no cuenta,
+    // así que la espera dura entre una y dos vueltas
+    int64_t inicio = halTiempoUs();
+    TEST_ASSERT_TRUE(esperarPasadaRadar());
+    double segundos = (halTiempoUs() - inicio) / 1e6;
+    TEST_ASSERT_GREATER_OR_EQUAL_FLOAT(4.0, segundos);
+    TEST_ASSERT_LESS_OR_EQUAL_FLOAT(8.1, segundos);
+}
+
+void test_quieto_no_espera_y_estaciona_al_frente() {
+    configurarBarrido(RADAR_QUIETO, 180, 90);
+    int64_t inicio = halTiempoUs();
+    TEST_ASSERT_FALSE(esperarPasadaRadar());
+    TEST_ASSERT_EQUAL(inicio, halTiempoUs());
+    // Frena y vuelve al frente deshaciendo las vueltas del modo continuo
+    for (int i = 0; i < 600 && (ejeEnMovimiento(EJE_RADAR) || posicionEje(EJE_RADAR) != pasosRadarDesdeGrados(0)); i++) {
+        vTaskDelay(pdMS_TO_TICKS(100));
+    }
+    TEST_ASSERT_EQUAL_INT32(pasosRadarDesdeGrados(0), posicionEje(EJE_RADAR));
+}
+
+// Quien espera la pasada se entera si el radar se detiene a mitad de camino
+TaskHandle_t tareaEspera = NULL;
+volatile int resultadoEspera = -1;
+void TaskESPERA(void *pvParameters) {
+    resultadoEspera = esperarPasadaRadar();
+    vTaskDelete(NULL);
+}
+
+void test_quieto_a_mitad_de_la_espera() {
+    configurarBarrido(RADAR_VAIVEN, 180, 90);
+    resultadoEspera = -1;
+    xTaskCreatePinnedToCore(TaskESPERA, "TaskESPERA", 2048, NULL, 1, &tareaEspera, 1);
+    vTaskDelay(pdMS_TO_TICKS(1000));
+    TEST_ASSERT_EQUAL(-1, resultadoEspera);
+    configurarBarrido(RADAR_QUIETO, 180, 90);
+    vTaskDelay(pdMS_TO_TICKS(100));
+    TEST_ASSERT_EQUAL(0, resultadoEspera);
+}
+
+// Un pedido con algún parámetro malo responde 400 y deja todo como estaba
+void test_http_rechaza_parametros_invalidos() {
+    server.on("/radar", handleRadar);
+    configurarBarrido(RADAR_VAIVEN, 90, 90);
+    uint16_t pasosAntes = calibracionRadar.pasosPorVuelta;
+    const char *invalidos[] = {
+        "/radar?modo=rapido",
+        "/radar?modo=",
+        "/radar?amplitud=0",
+        "/radar?amplitud=-10",
+        "/radar?amplitud=181",
+        "/radar?amplitud=mucha",
+        "/radar?velocidad=0",
+        "/radar?velocidad=-90",
+        "/radar?velocidad=100000",
+        "/radar?pasosPorVuelta=0",
+        "/radar?modo=continuo&velocidad=0",
+        // Válido en grados, pero con la calibración nueva excede el perfil
+        "/radar?pasosPorVuelta=65535&desfase=5",
+    };
+    for (const char *uri : invalidos) {
+        RespuestaHttp r = server.atender(uri);
+        TEST_ASSERT_EQUAL_MESSAGE(400, r.codigo, uri);
+        TEST_ASSERT_EQUAL_MESSAGE(RADAR_VAIVEN, modoRadar, uri);
+        TEST_ASSERT_FLOAT_WITHIN_MESSAGE(0.01f, 90, amplitudRadar, uri);
+        TEST_ASSERT_FLOAT_WITHIN_MESSAGE(0.01f, 90, velocidadRadar, uri);
+        TEST_ASSERT_EQUAL_MESSAGE(pasosAntes, calibracionRadar.pasosPorVuelta, uri);
+        TEST_ASSERT_FLOAT_WITHIN_MESSAGE(0.01f, 0, calibracionRadar.desfase, uri);
+    }
+
+    RespuestaHttp r = server.atender("/radar?modo=continuo&amplitud=180&velocidad=45");
+    TEST_ASSERT_EQUAL(200, r.codigo);
+    TEST_ASSERT_EQUAL(RADAR_CONTINUO, modoRadar);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 180, amplitudRadar);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 45, velocidadRadar);
+    configurarBarrido(RADAR_QUIETO, 180, 90);
+}
+
+void setup() {
+    EEPROM.begin(512);
+    configurarEje(EJE_IZQUIERDO, 14, 26, 27, 25);
+    configurarEje(EJE_DERECHO, 19, 5, 18, 32);
+    configurarEje(EJE_RADAR, 23, 4, 33, 2);
+    configurarPerfil(800, 400);
+    iniciarMotores();
+    iniciarRadar(1);
+    xTaskCreatePinnedToCore(TaskANOTAR, "TaskANOTAR", 2048, NULL, 3, NULL, 1);
+
+    UNITY_BEGIN();
+    RUN_TEST(test_conversiones_de_calibracion);
+    RUN_TEST(test_vaiven_cubre_la_vuelta);
+    RUN_TEST(test_vaiven_angosto_cubre_solo_su_amplitud);
+    RUN_TEST(test_continuo_cuenta_vueltas);
+    RUN_TEST(test_quieto_no_espera_y_estaciona_al_frente);
+    RUN_TEST(test_quieto_a_mitad_de_la_espera);
+    RUN_TEST(test_http_rechaza_parametros_invalidos);
+    simSalir(UNITY_END());
+}
+
+void loop() {}
@@ -0,0 +1,194 @@
+// Trama binaria del mapa: ida y vuelta de la cabecera y las celdas, bytes
+// en las posiciones documentadas, tramas truncadas o ajenas, y /get-data.bin
+// contra el mapa del robot
+#include <Arduino.h>
+#include <unity.h>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+#include "apwifieeprommode.h"
+
+// Lo que apwifieeprommode.h espera de main.cpp
+WebServer server(80);
+MapaRobot mapa;
+int numPuntos = 0;
+AnguloBinario ultimoAngulo = 0;
+uint16_t ultimaDistancia = 0;
+AnilloSPSC<MuestraRango, 128> anilloMuestras;
+std::atomic<uint32_t> muestrasIntegradas{0};
+int32_t pasosSensor() { return 0; }
+AnguloBinario anguloSensorEnPasos(int32_t pasos) { return (AnguloBinario)pasos; }
+
+typedef std::set<std::pair<int32_t, int32_t>> Celdas;
+
+struct EscritorBytes {
+    std::vector<uint8_t> bytes;
+    void agregar(const char *datos, size_t longitud) { bytes.insert(bytes.end(), datos, datos + longitud); }
+};
+
+struct CeldaTrama {
+    int32_t x, y;
+    bool ocupada;
+};
+
+CabeceraTrama cabeceraDePrueba() {
+    CabeceraTrama c;
+    c.banderas = TRAMA_COMPLETA;
+    c.arranque = 0xDEADBEEF;
+    c.seq = 0x01020304;
+    c.robotX = -1234;
+    c.robotY = 32767;
+    c.robotAngulo = 0xFFFF;
+    c.ultimoAngulo = 0x8000;
+    c.ultimaDistancia = 8190;
+    c.numPuntos = 500;
+    c.ocupadas = 3;
+    c.libres = 2;
+    return c;
+}
+
+const CeldaTrama CELDAS_PRUEBA[] = {
+    {25, -25, true}, {-3975, 3975, true}, {40000, -40000, true}, {0, 0, false}, {-32768, 32767, false}};
+
+std::vector<uint8_t> tramaDePrueba() {
+    EscritorBytes w;
+    escribirCabeceraTrama(w, cabeceraDePrueba());
+    for (const CeldaTrama &celda : CELDAS_PRUEBA) escribirPuntoTrama(w, celda.x, celda.y);
+    return w.bytes;
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_ida_y_vuelta() {
+    std::vector<uint8_t> trama = tramaDePrueba();
+    TEST_ASSERT_EQUAL(TRAMA_TAMANO_CABECERA + 4 * 5, trama.size());
+    CabeceraTrama c, esperada = cabeceraDePrueba();
+    std::vector<CeldaTrama> celdas;
+    TEST_ASSERT_TRUE(leerTrama(trama.data(), trama.size(), c, [&](int32_t x, int32_t y, bool ocupada) {
+        celdas.push_back({x, y, ocupada});
+    }));
+    TEST_ASSERT_EQUAL_UINT8(esperada.banderas, c.banderas);
+    TEST_ASSERT_EQUAL_UINT32(esperada.arranque, c.arranque);
+    TEST_ASSERT_EQUAL_UINT32(esperada.seq, c.seq);
+    TEST_ASSERT_EQUAL_INT16(esperada.robotX, c.robotX);
+    TEST_ASSERT_EQUAL_INT16(esperada.robotY, c.robotY);
+    TEST_ASSERT_EQUAL_UINT16(esperada.robotAngulo, c.robotAngulo);
+    TEST_ASSERT_EQUAL_UINT16(esperada.ultimoAngulo, c.ultimoAngulo);
+    TEST_ASSERT_EQUAL_UINT16(esperada.ultimaDistancia, c.ultimaDistancia);
+    TEST_ASSERT_EQUAL_UINT16(esperada.numPuntos, c.numPuntos);
+    TEST_ASSERT_EQUAL_UINT16(3, c.ocupadas);
+    TEST_ASSERT_EQUAL_UINT16(2, c.libres);
+
+    TEST_ASSERT_EQUAL(5, celdas.size());
+    for (int i = 0; i < 5; i++) {
+        // Fuera de int16 se satura
+        TEST_ASSERT_EQUAL_INT32(saturarInt16(CELDAS_PRUEBA[i].x), celdas[i].x);
+        TEST_ASSERT_EQUAL_INT32(saturarInt16(CELDAS_PRUEBA[i].y), celdas[i].y);
+        TEST_ASSERT_EQUAL(CELDAS_PRUEBA[i].ocupada, celdas[i].ocupada);
+    }
+    TEST_ASSERT_EQUAL_INT32(32767, celdas[2].x);
+    TEST_ASSERT_EQUAL_INT32(-32768, celdas[2].y);
+}
+
+// Los bytes donde los documenta la tabla de tramabinaria.h (la página los lee así)
+void test_posiciones_documentadas() {
+    std::vector<uint8_t> t = tramaDePrueba();
+    const uint8_t cabecera[TRAMA_TAMANO_CABECERA] = {
+        'M', 'R', 1, 0x01,
+        0xEF, 0xBE, 0xAD, 0xDE,  // arranque
+        0x04, 0x03, 0x02, 0x01,  // seq
+        0x2E, 0xFB,              // robotX = -1234
+        0xFF, 0x7F,              // robotY = 32767
+        0xFF, 0xFF, 0x00, 0x80,  // robotAngulo, ultimoAngulo
+        0xFE, 0x1F,              // ultimaDistancia = 8190
+        0xF4, 0x01,              // numPuntos = 500
+        0x03, 0x00, 0x02, 0x00}; // ocupadas, libres
+    TEST_ASSERT_EQUAL_MEMORY(cabecera, t.data(), TRAMA_TAMANO_CABECERA);
+    const uint8_t primera[4] = {0x19, 0x00, 0xE7, 0xFF}; // (25, -25)
+    TEST_ASSERT_EQUAL_MEMORY(primera, t.data() + TRAMA_TAMANO_CABECERA, 4);
+}
+
+void test_truncada_o_ajena() {
+    std::vector<uint8_t> trama = tramaDePrueba();
+    CabeceraTrama c;
+    int celdas = 0;
+    auto contar = [&](int32_t, int32_t, bool) { celdas++; };
+    for (size_t n = 0; n < trama.size(); n++) {
+        TEST_ASSERT_FALSE(leerTrama(trama.data(), n, c, contar));
+    }
+    TEST_ASSERT_EQUAL(0, celdas); // Ninguna celda de una trama incompleta
+
+    std::vector<uint8_t> otra = trama;
+    otra[2] = TRAMA_VERSION + 1;
+    TEST_ASSERT_FALSE(leerTrama(otra.data(), otra.size(), c, contar));
+    otra = trama;
+    otra[0] = 'X';
+    TEST_ASSERT_FALSE(leerTrama(otra.data(), otra.size(), c, contar));
+    TEST_ASSERT_EQUAL(0, celdas);
+}
+
+Celdas ocupadasDelMapa() {
+    Celdas celdas;
+    mapa.recorrerOcupadas([&](int32_t x, int32_t y) { celdas.insert({x, y}); });
+    return celdas;
+}
+
+// Pared en forma de L, vista varias veces desde (0, 0)
+void verPared(int32_t desde, int32_t hasta) {
+    for (int vez = 0; vez < 4; vez++) {
+        for (int32_t x = desde; x < hasta; x += 50) {
+            mapa.integrarRayo(0, 0, x, 1000, true);
+            mapa.integrarRayo(0, 0, 1000, x, true);
+        }
+    }
+}
+
+void test_get_data_bin_completa_e_incremental() {
+    registrarRutas();
+    idArranque = 4242;
+    verPared(-1000, 0);
+
+    RespuestaHttp r = server.atender("/get-data.bin");
+    TEST_ASSERT_EQUAL(200, r.codigo);
+    CabeceraTrama c;
+    Celdas espejo;
+    TEST_ASSERT_TRUE(leerTrama((const uint8_t *)r.cuerpo.data(), r.cuerpo.size(), c,
+                               [&](int32_t x, int32_t y, bool) { espejo.insert({x, y}); }));
+    TEST_ASSERT_EQUAL_UINT8(TRAMA_COMPLETA, c.banderas);
+    TEST_ASSERT_EQUAL_UINT32(4242, c.arranque);
+    TEST_ASSERT_EQUAL_UINT16(mapa.totalOcupadas(), c.ocupadas);
+    TEST_ASSERT_EQUAL(TRAMA_TAMANO_CABECERA + 4 * c.ocupadas, r.cuerpo.size());
+    TEST_ASSERT_TRUE(espejo == ocupadasDelMapa());
+
+    // Más pared: la incremental trae solo lo nuevo
+    verPared(0, 1000);
+    String uri = "/get-data.bin?since=" + String((unsigned long)c.seq) + "&arranque=4242";
+    r = server.atender(uri);
+    CabeceraTrama inc;
+    TEST_ASSERT_TRUE(leerTrama((const uint8_t *)r.cuerpo.data(), r.cuerpo.size(), inc, [&](int32_t x, int32_t y, bool ocupada) {
+        if (ocupada) espejo.insert({x, y}); else espejo.erase({x, y});
+    }));
+    TEST_ASSERT_EQUAL_UINT8(0, inc.banderas);
+    TEST_ASSERT_GREATER_THAN(0, inc.ocupadas);
+    TEST_ASSERT_EQUAL_UINT32(mapa.secuencia(), inc.seq);
+    TEST_ASSERT_LESS_THAN(mapa.totalOcupadas(), inc.ocupadas + inc.libres);
+    TEST_ASSERT_TRUE(espejo == ocupadasDelMapa());
+
+    // La misma información en JSON ocupa bastante más
+    RespuestaHttp json = server.atender("/get-data");
+    r = server.atender("/get-data.bin");
+    TEST_ASSERT_LESS_THAN(json.cuerpo.size() / 2, r.cuerpo.size());
+}
+
+void setup() {
+    UNITY_BEGIN();
+    RUN_TEST(test_ida_y_vuelta);
+    RUN_TEST(test_posiciones_documentadas);
+    RUN_TEST(test_truncada_o_ajena);
+    RUN_TEST(test_get_data_bin_completa_e_incremental);
+    simSalir(UNITY_END());
+}
+
+void loop() {}
@@ -0,0 +1,94 @@
+// Seno y coseno Q15 (trigonometria.h) contra la libm en double: los 65536
+// ángulos binarios, y la proyección de polarACartesiano() en todo el alcance
+// del sensor, de 0 a 2000 mm
+#include <Arduino.h>
+#include <unity.h>
+#include <math.h>
+#include "simulacion.h"
+#include "trigonometria.h"
+
+#define ANGULOS_BINARIOS 65536
+#define ALCANCE_MM 2000
+
+double radianesDesdeAnguloBinario(uint32_t angulo) {
+    return angulo * (2 * M_PI / ANGULOS_BINARIOS);
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_seno_y_coseno_en_todos_los_angulos() {
+    double maximoSeno = 0, maximoCoseno = 0;
+    for (uint32_t a = 0; a < ANGULOS_BINARIOS; a++) {
+        double x = radianesDesdeAnguloBinario(a);
+        maximoSeno = fmax(maximoSeno, fabs(senoQ15(a) / (double)UNO_Q15 - sin(x)));
+        maximoCoseno = fmax(maximoCoseno, fabs(cosenoQ15(a) / (double)UNO_Q15 - cos(x)));
+    }
+    // Lo que promete el header; la interpolación sola deja ~5e-6, el resto es
+    // el redondeo a Q15 de la tabla y el del desplazamiento
+    TEST_ASSERT_LESS_THAN_FLOAT(1e-4, maximoSeno);
+    TEST_ASSERT_LESS_THAN_FLOAT(1e-4, maximoCoseno);
+}
+
+void test_valores_exactos_en_los_ejes() {
+    TEST_ASSERT_EQUAL_INT32(0, senoQ15(0));
+    TEST_ASSERT_EQUAL_INT32(32767, senoQ15(16384));
+    TEST_ASSERT_EQUAL_INT32(0, senoQ15(32768));
+    TEST_ASSERT_EQUAL_INT32(-32767, senoQ15(49152));
+    TEST_ASSERT_EQUAL_INT32(32767, cosenoQ15(0));
+    TEST_ASSERT_EQUAL_INT32(-32767, cosenoQ15(32768));
+}
+
+void test_simetrias() {
+    for (uint32_t a = 0; a < ANGULOS_BINARIOS; a++) {
+        AnguloBinario angulo = a;
+        // sin(-x) = -sin(x) y sin(x + 180°) = -sin(x): la tabla es simétrica y
+        // solo el desplazamiento de la interpolación redondea hacia abajo
+        TEST_ASSERT_INT32_WITHIN(1, -senoQ15(angulo), senoQ15((AnguloBinario)-angulo));
+        TEST_ASSERT_INT32_WITHIN(1, -senoQ15(angulo), senoQ15((AnguloBinario)(angulo + 32768)));
+    }
+}
+
+void test_proyeccion_en_todo_el_alcance() {
+    double maximo = 0;
+    uint32_t peorAngulo = 0;
+    int32_t peorDistancia = 0;
+    for (uint32_t a = 0; a < ANGULOS_BINARIOS; a++) {
+        double x = radianesDesdeAnguloBinario(a);
+        double c = cos(x), s = sin(x);
+        for (int32_t d = 0; d <= ALCANCE_MM; d++) {
+            int32_t dx, dy;
+            polarACartesiano(d, a, dx, dy);
+            double error = fmax(fabs(dx - d * c), fabs(dy - d * s));
+            if (error > maximo) {
+                maximo = error;
+                peorAngulo = a;
+                peorDistancia = d;
+            }
+        }
+    }
+    // Medio milímetro del redondeo a la unidad más 2000 mm por el error de la tabla
+    char detalle[64];
+    snprintf(detalle, sizeof(detalle), "peor en %u/65536 a %d mm", (unsigned)peorAngulo, (int)peorDistancia);
+    TEST_ASSERT_LESS_THAN_FLOAT_MESSAGE(0.5 + ALCANCE_MM * 1e-4, maximo, detalle);
+}
+
+void test_proyeccion_conserva_la_distancia() {
+    for (uint32_t a = 0; a < ANGULOS_BINARIOS; a += 7) {
+        int32_t dx, dy;
+        polarACartesiano(ALCANCE_MM, a, dx, dy);
+        TEST_ASSERT_FLOAT_WITHIN(1.0, ALCANCE_MM, hypot(dx, dy));
+    }
+}
+
+void setup() {
+    UNITY_BEGIN();
+    RUN_TEST(test_seno_y_coseno_en_todos_los_angulos);
+    RUN_TEST(test_valores_exactos_en_los_ejes);
+    RUN_TEST(test_simetrias);
+    RUN_TEST(test_proyeccion_en_todo_el_alcance);
+    RUN_TEST(test_proyeccion_conserva_la_distancia);
+    simSalir(UNITY_END());
+}
+
+void loop() {}
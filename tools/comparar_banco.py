@@ -0,0 +1,76 @@
+# Compara dos corridas del banco de rendimiento (src/banco.h). Cada archivo
+# es la salida del programa o del monitor serie: se toman las líneas JSON
+# con "caso" y se ignora el resto.
+#
+#   python tools/comparar_banco.py base.txt nuevo.txt [--umbral 30]
+#
+# Sale con 1 si algún caso quedó más lento que la base por más del umbral
+# (en %), para usarlo en un script de integración. Por defecto se compara el
+# mínimo por punto, que en una PC compartida varía mucho menos que la media.
+#
+# Aun así, entre dos corridas iguales un caso puede moverse ~25%. Para
+# comparar con menos ruido, juntar varias corridas en cada archivo:
+#
+#   for i in 1 2 3 4 5; do .pio/build/banco/program; done > base.txt
+#
+# De cada caso se toma el menor valor de todas las corridas del archivo. Con
+# cinco corridas por lado el mismo binario todavía se mueve hasta ~17% en los
+# casos más cortos: de ahí el umbral de 30%.
+import argparse
+import json
+import sys
+
+
+def leer(ruta, campo):
+    """Caso -> (línea JSON de la corrida más rápida según "campo", corridas)."""
+    casos = {}
+    with open(ruta, encoding="utf-8", errors="replace") as f:
+        for linea in f:
+            linea = linea.strip()
+            if not linea.startswith("{"):
+                continue
+            try:
+                dato = json.loads(linea)
+            except ValueError:
+                continue
+            if "caso" in dato and "ns_por_punto" in dato:
+                clave = (dato["plataforma"], dato["caso"], dato["puntos"])
+                mejor, corridas = casos.get(clave, (None, 0))
+                if mejor is None or dato[campo] < mejor[campo]:
+                    mejor = dato
+                casos[clave] = (mejor, corridas + 1)
+    return casos
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("base")
+    parser.add_argument("nuevo")
+    parser.add_argument("--umbral", type=float, default=30, help="%% de empeoramiento tolerado")
+    parser.add_argument("--campo", default="ns_minimo_por_punto", choices=["ns_minimo_por_punto", "ns_por_punto"])
+    args = parser.parse_args()
+
+    base = leer(args.base, args.campo)
+    nuevo = leer(args.nuevo, args.campo)
+    peores = 0
+    print("%-8s %-15s %7s %12s %12s %8s %9s" % ("plat.", "caso", "puntos", "base ns", "nuevo ns", "cambio", "corridas"))
+    for clave in sorted(set(base) | set(nuevo)):
+        plataforma, caso, puntos = clave
+        if clave not in base or clave not in nuevo:
+            print("%-8s %-15s %7d %s" % (plataforma, caso, puntos, "solo en " + ("nuevo" if clave in nuevo else "base")))
+            continue
+        (dato_base, corridas_base), (dato_nuevo, corridas_nuevo) = base[clave], nuevo[clave]
+        antes = dato_base[args.campo]
+        despues = dato_nuevo[args.campo]
+        cambio = (despues - antes) / antes * 100 if antes > 0 else 0
+        marca = ""
+        if cambio > args.umbral:
+            marca = "  <-- más lento"
+            peores += 1
+        print("%-8s %-15s %7d %12.1f %12.1f %+7.1f%% %4d/%-4d%s"
+              % (plataforma, caso, puntos, antes, despues, cambio, corridas_base, corridas_nuevo, marca))
+    return 1 if peores else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
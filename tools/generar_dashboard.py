@@ -0,0 +1,61 @@
+# Genera src/dashboard_gz.h: web/index.html comprimido con gzip como arreglo
+# PROGMEM, más un ETag derivado del contenido.
+#
+# PlatformIO lo corre antes de cada compilación (extra_scripts = pre:...);
+# también se puede correr a mano: python tools/generar_dashboard.py
+import gzip
+import hashlib
+import os
+
+try:
+    Import("env")  # noqa: F821 (definido por SCons)
+    RAIZ = env.subst("$PROJECT_DIR")  # noqa: F821
+except NameError:
+    RAIZ = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+ORIGEN = os.path.join(RAIZ, "web", "index.html")
+DESTINO = os.path.join(RAIZ, "src", "dashboard_gz.h")
+
+
+def generar():
+    with open(ORIGEN, "rb") as f:
+        html = f.read()
+
+    # mtime=0 para que el mismo HTML produzca siempre los mismos bytes
+    comprimido = gzip.compress(html, compresslevel=9, mtime=0)
+    etag = hashlib.sha1(html).hexdigest()[:16]
+
+    lineas = []
+    for i in range(0, len(comprimido), 16):
+        lineas.append("    " + ", ".join("0x%02x" % b for b in comprimido[i:i + 16]) + ",")
+
+    contenido = (
+        "#ifndef DASHBOARD_GZ_H\n"
+        "#define DASHBOARD_GZ_H\n"
+        "\n"
+        "// Generado por tools/generar_dashboard.py a partir de web/index.html. No editar.\n"
+        "// Original: %d bytes, comprimido: %d bytes\n"
+        "\n"
+        "#include <Arduino.h>\n"
+        "\n"
+        "#define DASHBOARD_ETAG \"\\\"%s\\\"\"\n"
+        "\n"
+        "const size_t DASHBOARD_GZ_LEN = %d;\n"
+        "const uint8_t DASHBOARD_GZ[] PROGMEM = {\n"
+        "%s\n"
+        "};\n"
+        "\n"
+        "#endif // DASHBOARD_GZ_H\n"
+    ) % (len(html), len(comprimido), etag, len(comprimido), "\n".join(lineas))
+
+    # No tocar el archivo si no cambió, para no forzar una recompilación
+    if os.path.exists(DESTINO):
+        with open(DESTINO) as f:
+            if f.read() == contenido:
+                return
+    with open(DESTINO, "w") as f:
+        f.write(contenido)
+    print("dashboard_gz.h: %d -> %d bytes" % (len(html), len(comprimido)))
+
+
+generar()
@@ -0,0 +1,96 @@
+# Convierte la traza de eventos del robot (/traza.bin, ver src/traza.h) al
+# JSON de eventos de Chrome, para abrirla en https://ui.perfetto.dev o en
+# chrome://tracing. Cada tarea del robot queda como un hilo.
+#
+#   curl -o traza.bin http://<ip del robot>/traza.bin
+#   python tools/traza_a_chrome.py traza.bin traza.json
+import argparse
+import json
+import struct
+import sys
+
+FASES = {0: "B", 1: "E", 2: "i", 3: "C"}
+
+
+def leer_nombres(datos, pos, cuantos):
+    nombres = []
+    for _ in range(cuantos):
+        fin = datos.index(b"\0", pos)
+        nombres.append(datos[pos:fin].decode("utf-8", errors="replace"))
+        pos = fin + 1
+    return nombres, pos
+
+
+def leer(ruta):
+    with open(ruta, "rb") as f:
+        datos = f.read()
+    if datos[:4] != b"TRZ1":
+        sys.exit(f"{ruta}: no es una traza del robot")
+    n, tareas, eventos = struct.unpack_from("<IBB", datos, 4)
+    nombres_tareas, pos = leer_nombres(datos, 10, tareas)
+    nombres_eventos, pos = leer_nombres(datos, pos, eventos)
+    if len(datos) < pos + 8 * n:
+        sys.exit(f"{ruta}: faltan eventos ({(len(datos) - pos) // 8} de {n})")
+    crudos = [struct.unpack_from("<IHBB", datos, pos + 8 * i) for i in range(n)]
+    return nombres_tareas, nombres_eventos, crudos
+
+
+def convertir(nombres_tareas, nombres_eventos, crudos):
+    salida = []
+    for tid, nombre in enumerate(nombres_tareas):
+        salida.append({"ph": "M", "name": "thread_name", "pid": 1, "tid": tid, "args": {"name": nombre}})
+    salida.append({"ph": "M", "name": "process_name", "pid": 1, "args": {"name": "robot"}})
+
+    # micros() es de 32 bits: se desenrolla siguiendo el orden del anillo
+    base = None
+    anterior = 0
+    vueltas = 0
+    abiertos = {}  # (tarea, evento) -> inicios sin fin
+    for tiempo, valor, evento, tarea_fase in crudos:
+        tarea = tarea_fase & 0x0F
+        fase = FASES[(tarea_fase >> 4) & 0x03]
+        if base is not None and tiempo < anterior and anterior - tiempo > 0x80000000:
+            vueltas += 1
+        anterior = tiempo
+        ts = tiempo + (vueltas << 32)
+        if base is None:
+            base = ts
+        nombre = nombres_eventos[evento] if evento < len(nombres_eventos) else f"evento {evento}"
+        clave = (tarea, evento)
+        if fase == "B":
+            abiertos[clave] = abiertos.get(clave, 0) + 1
+        elif fase == "E":
+            # El inicio ya fue pisado en el anillo
+            if abiertos.get(clave, 0) == 0:
+                continue
+            abiertos[clave] -= 1
+        e = {"ph": fase, "name": nombre, "pid": 1, "tid": tarea, "ts": ts - base}
+        if fase == "i":
+            e["s"] = "t"
+            e["args"] = {"valor": valor}
+        elif fase == "C":
+            e["args"] = {nombre: valor}
+        salida.append(e)
+    return salida
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("traza", help="archivo descargado de /traza.bin")
+    parser.add_argument("salida", nargs="?", help="JSON de salida (por defecto, la salida estándar)")
+    args = parser.parse_args()
+
+    nombres_tareas, nombres_eventos, crudos = leer(args.traza)
+    eventos = convertir(nombres_tareas, nombres_eventos, crudos)
+    documento = {"traceEvents": eventos, "displayTimeUnit": "ms"}
+    if args.salida:
+        with open(args.salida, "w", encoding="utf-8") as f:
+            json.dump(documento, f)
+    else:
+        json.dump(documento, sys.stdout)
+    duracion = (eventos[-1].get("ts", 0) if crudos else 0) / 1e6
+    print(f"{len(crudos)} eventos de {len(nombres_tareas)} tareas, {duracion:.3f} s", file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()